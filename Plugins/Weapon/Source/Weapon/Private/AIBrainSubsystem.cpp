@@ -0,0 +1,450 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AIBrainSubsystem.h"
+#include "FHAIController.h"
+#include "FHCharacter.h"
+#include "BaseWeapon.h"
+#include "CombatWorldSubsystem.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Navigation/PathFollowingComponent.h"
+
+
+//Console Command
+static FAutoConsoleCommandWithWorld AIReportCommand(
+	TEXT("Weapon.AI.Report"),
+	TEXT("Print NPC Brain Think Cost per Frame, Think Lag and Trace Count"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const UAIBrainSubsystem* BrainSubsystem = World != nullptr ? World->GetSubsystem<UAIBrainSubsystem>() : nullptr)
+		{
+			BrainSubsystem->Report();
+		}
+	}));
+
+static FAutoConsoleCommandWithWorld AIResetCommand(
+	TEXT("Weapon.AI.Reset"),
+	TEXT("Clear NPC Brain Stats"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (UAIBrainSubsystem* BrainSubsystem = World != nullptr ? World->GetSubsystem<UAIBrainSubsystem>() : nullptr)
+		{
+			BrainSubsystem->ResetStats();
+		}
+	}));
+
+
+UAIBrainSubsystem::UAIBrainSubsystem()
+{
+	//Default Value, Override in DefaultGame.ini
+	MaxThinkMSPerFrame = 1.0f;
+	ThinkInterval = 0.2f;
+	MaxTracesPerFrame = 32;
+	SightRadius = 2000.0f;
+	LoseSightTime = 3.0f;
+	MeleeAttackRange = 150.0f;
+	AttackInterval = 0.4f;
+	FinisherComboCount = 3;
+	bUsePathfinding = true;
+	bTargetOtherNPCs = false;
+
+	NextBrainId = 1;
+	NextBrainIndex = 0;
+	ThinkCount = 0;
+	TraceCount = 0;
+	AttackCount = 0;
+	BudgetExceededCount = 0;
+}
+
+bool UAIBrainSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UAIBrainSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Collection.InitializeDependency<UCombatWorldSubsystem>();
+
+	Super::Initialize(Collection);
+
+	//Bound Once, Async Trace Copy Delegate
+	PerceptionTraceDelegate.BindUObject(this, &UAIBrainSubsystem::OnPerceptionTraceDone);
+}
+
+void UAIBrainSubsystem::Deinitialize()
+{
+	Brains.Reset();
+	PerceptionQueue.Reset();
+	PerceptionTraceDelegate.Unbind();
+
+	Super::Deinitialize();
+}
+
+void UAIBrainSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	//Controller Destroyed without UnPossess
+	Brains.RemoveAllSwap([](const FAIBrain& Brain) { return Brain.Controller.IsValid() == false; });
+
+	if (Brains.Num() == 0)
+	{
+		return;
+	}
+
+	//Traces Queued by Last Frame Thinks, Result in Next Frame
+	FlushPerceptionTraces();
+
+	TickThinks(GetWorld()->GetTimeSeconds());
+}
+
+TStatId UAIBrainSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAIBrainSubsystem, STATGROUP_Tickables);
+}
+
+void UAIBrainSubsystem::RegisterBrain(AFHAIController* Controller, AFHCharacter* Character)
+{
+	//Controller only Exist on Server
+	if (Controller == nullptr || Character == nullptr || FindBrainIndex(Controller) != INDEX_NONE)
+	{
+		return;
+	}
+
+	FAIBrain& Brain = Brains.AddDefaulted_GetRef();
+	Brain.BrainId = NextBrainId++;
+	Brain.Controller = Controller;
+	Brain.Character = Character;
+
+	//Spread First Think, Spawned Wave don't Think in Same Frame
+	Brain.NextThinkTime = GetWorld()->GetTimeSeconds() + FMath::FRandRange(0.0f, ThinkInterval);
+}
+
+void UAIBrainSubsystem::UnregisterBrain(AFHAIController* Controller)
+{
+	const int32 Index = FindBrainIndex(Controller);
+	if (Index != INDEX_NONE)
+	{
+		//Queued Trace of this Brain is Skipped by Id
+		Brains.RemoveAtSwap(Index);
+	}
+}
+
+void UAIBrainSubsystem::TickThinks(double CurrentTime)
+{
+	const double StartTime = FPlatformTime::Seconds();
+	const double BudgetSeconds = MaxThinkMSPerFrame * 0.001;
+
+	//Visit every Brain at most Once per Frame, Continue Next Frame from Stop Point
+	const int32 BrainCount = Brains.Num();
+	for (int32 Step = 0; Step < BrainCount; ++Step)
+	{
+		if (NextBrainIndex >= Brains.Num())
+		{
+			NextBrainIndex = 0;
+		}
+
+		FAIBrain& Brain = Brains[NextBrainIndex];
+		if (Brain.NextThinkTime > CurrentTime)
+		{
+			NextBrainIndex += 1;
+			continue;
+		}
+
+		if (FPlatformTime::Seconds() - StartTime >= BudgetSeconds)
+		{
+			BudgetExceededCount += 1;
+			break;
+		}
+
+		ThinkLagHistogram.Record(CurrentTime - Brain.NextThinkTime);
+		Brain.NextThinkTime = CurrentTime + ThinkInterval;
+
+		Think(Brain, CurrentTime);
+		ThinkCount += 1;
+		NextBrainIndex += 1;
+	}
+
+	ThinkCostHistogram.Record(FPlatformTime::Seconds() - StartTime);
+}
+
+void UAIBrainSubsystem::Think(FAIBrain& Brain, double CurrentTime)
+{
+	AFHCharacter* Character = Brain.Character.Get();
+	AFHAIController* Controller = Brain.Controller.Get();
+	if (Character == nullptr || Controller == nullptr)
+	{
+		return;
+	}
+
+	UpdatePerception(Brain, Character);
+
+	//Lost Target, Stand and Wait Next Perception
+	AFHProjectCharacter* Target = Brain.Target.Get();
+	if (Target == nullptr || CurrentTime - Brain.LastSeenTime > LoseSightTime)
+	{
+		if (Brain.State != EAIBrainState::Idle)
+		{
+			Controller->StopMovement();
+			Controller->ClearFocus(EAIFocusPriority::Gameplay);
+			Brain.State = EAIBrainState::Idle;
+		}
+
+		Brain.Target = nullptr;
+		Brain.ChaseTarget = nullptr;
+		return;
+	}
+
+	//Control Rotation Follow Focus, Character Face Target and Aim is Replicated
+	Controller->SetFocus(Target);
+
+	const float AttackRange = GetAttackRange(Character);
+	const float DistanceSquared = FVector::DistSquared2D(Character->GetActorLocation(), Target->GetActorLocation());
+	if (DistanceSquared > AttackRange * AttackRange)
+	{
+		//Path Following Track Moving Goal, Request Once per Chase Target
+		//Target Switched or Move Ended (Reached or Aborted) While Chasing, Request Again
+		const bool bIsMoving = Controller->GetMoveStatus() != EPathFollowingStatus::Idle;
+		if (Brain.State != EAIBrainState::Chase || Brain.ChaseTarget.Get() != Target || bIsMoving == false)
+		{
+			const float AcceptanceRadius = AttackRange * 0.8f;
+			if (Controller->MoveToActor(Target, AcceptanceRadius, true, bUsePathfinding) == EPathFollowingRequestResult::Failed && bUsePathfinding == true)
+			{
+				//No Nav Mesh or No Path, Move Straight
+				Controller->MoveToActor(Target, AcceptanceRadius, true, false);
+			}
+
+			Brain.State = EAIBrainState::Chase;
+			Brain.ChaseTarget = Target;
+		}
+		return;
+	}
+
+	if (Brain.State == EAIBrainState::Chase)
+	{
+		Controller->StopMovement();
+		Brain.ChaseTarget = nullptr;
+	}
+	Brain.State = EAIBrainState::Attack;
+
+	TryAttack(Brain, Character, CurrentTime);
+}
+
+void UAIBrainSubsystem::UpdatePerception(FAIBrain& Brain, AFHCharacter* Character)
+{
+	if (Brain.bIsTracePending == true)
+	{
+		return;
+	}
+
+	UCombatWorldSubsystem* CombatSubsystem = GetWorld()->GetSubsystem<UCombatWorldSubsystem>();
+	if (CombatSubsystem == nullptr)
+	{
+		return;
+	}
+
+	//Capsule Broadphase is Packed by Combat Subsystem this Frame, No Physics Overlap
+	TArray<FCapsuleBroadphaseHit> Hits;
+	const FVector Location = Character->GetActorLocation();
+	CombatSubsystem->QueryCapsules(Location, Location, SightRadius, Hits);
+
+	//Current Target First, Others Nearest First
+	TArray<TPair<float, AFHProjectCharacter*>, TInlineAllocator<16>> Candidates;
+	for (const FCapsuleBroadphaseHit& Hit : Hits)
+	{
+		AFHProjectCharacter* Other = CombatSubsystem->GetCombatant(Hit.Index);
+		if (IsHostile(Character, Other) == false)
+		{
+			continue;
+		}
+
+		//Keep Current Target While in Sight Radius, No Target Flip
+		const float DistanceSquared = Other == Brain.Target.Get() ? -1.0f : FVector::DistSquared(Location, Other->GetActorLocation());
+		Candidates.Emplace(DistanceSquared, Other);
+	}
+
+	if (Candidates.Num() == 0)
+	{
+		Brain.CandidateCursor = 0;
+		return;
+	}
+
+	Candidates.Sort([](const TPair<float, AFHProjectCharacter*>& A, const TPair<float, AFHProjectCharacter*>& B) { return A.Key < B.Key; });
+
+	//Nearest Behind Wall doesn't Hide Farther Hostile in View, Wrap After Last
+	if (Brain.CandidateCursor >= Candidates.Num())
+	{
+		Brain.CandidateCursor = 0;
+	}
+	AFHProjectCharacter* Candidate = Candidates[Brain.CandidateCursor].Value;
+
+	Brain.PendingCandidate = Candidate;
+	Brain.bIsTracePending = true;
+	PerceptionQueue.Add(Brain.BrainId);
+}
+
+void UAIBrainSubsystem::TryAttack(FAIBrain& Brain, AFHCharacter* Character, double CurrentTime)
+{
+	if (CurrentTime < Brain.NextAttackTime)
+	{
+		return;
+	}
+
+	ABaseWeapon* Weapon = Cast<ABaseWeapon>(Character->GetEquipWeapon());
+	if (Weapon == nullptr)
+	{
+		return;
+	}
+
+	//Attack Committed, Input would only Fill Buffer
+	const UCombatWorldSubsystem* CombatSubsystem = GetWorld()->GetSubsystem<UCombatWorldSubsystem>();
+	if (CombatSubsystem != nullptr && CombatSubsystem->GetComboState(Character) == EComboState::Attacking)
+	{
+		return;
+	}
+
+	//Click is Press and Release in One Command, Same as Quick Player Click
+	const uint8 Button = Weapon->GetLeftClickCount() >= FinisherComboCount ? FHInputButton::RightClick : FHInputButton::LeftClick;
+
+	FFHInputCommand Command;
+	Command.PressedButtons = Button;
+	Command.ReleasedButtons = Button;
+	Character->ProcessAICommand(Command);
+
+	Brain.NextAttackTime = CurrentTime + AttackInterval;
+	AttackCount += 1;
+}
+
+void UAIBrainSubsystem::FlushPerceptionTraces()
+{
+	UWorld* World = GetWorld();
+	const int32 FlushCount = FMath::Min(PerceptionQueue.Num(), MaxTracesPerFrame);
+
+	for (int32 QueueIndex = 0; QueueIndex < FlushCount; ++QueueIndex)
+	{
+		const int32 BrainIndex = FindBrainIndex(PerceptionQueue[QueueIndex]);
+		if (BrainIndex == INDEX_NONE)
+		{
+			continue;
+		}
+
+		FAIBrain& Brain = Brains[BrainIndex];
+		const AFHCharacter* Character = Brain.Character.Get();
+		const AFHProjectCharacter* Candidate = Brain.PendingCandidate.Get();
+		if (Character == nullptr || Candidate == nullptr)
+		{
+			Brain.bIsTracePending = false;
+			continue;
+		}
+
+		//Eye to Eye, Both Capsules Ignored, Other Character is not Occluder
+		FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(AIPerception), false);
+		QueryParams.AddIgnoredActor(Character);
+		QueryParams.AddIgnoredActor(Candidate);
+
+		World->AsyncLineTraceByChannel(EAsyncTraceType::Test, Character->GetPawnViewLocation(), Candidate->GetPawnViewLocation(), ECC_Visibility, QueryParams, FCollisionResponseParams::DefaultResponseParam, &PerceptionTraceDelegate, Brain.BrainId);
+		TraceCount += 1;
+	}
+
+	PerceptionQueue.RemoveAt(0, FlushCount, false);
+}
+
+void UAIBrainSubsystem::OnPerceptionTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+{
+	//Brain Unregistered While Trace in Flight
+	const int32 BrainIndex = FindBrainIndex(TraceDatum.UserData);
+	if (BrainIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	FAIBrain& Brain = Brains[BrainIndex];
+	Brain.bIsTracePending = false;
+
+	const bool bIsBlocked = TraceDatum.OutHits.ContainsByPredicate([](const FHitResult& Hit) { return Hit.bBlockingHit; });
+	if (bIsBlocked == false && Brain.PendingCandidate.IsValid() == true)
+	{
+		Brain.Target = Brain.PendingCandidate;
+		Brain.LastSeenTime = GetWorld()->GetTimeSeconds();
+		Brain.CandidateCursor = 0;
+	}
+	else
+	{
+		//Try Next Candidate Next Think
+		Brain.CandidateCursor += 1;
+	}
+
+	Brain.PendingCandidate = nullptr;
+}
+
+bool UAIBrainSubsystem::IsHostile(const AFHCharacter* Character, const AFHProjectCharacter* Other) const
+{
+	if (Other == nullptr || Other == Character)
+	{
+		return false;
+	}
+
+	return bTargetOtherNPCs == true || Other->IsPlayerControlled() == true;
+}
+
+float UAIBrainSubsystem::GetAttackRange(AFHCharacter* Character) const
+{
+	const ABaseWeapon* Weapon = Cast<ABaseWeapon>(Character->GetEquipWeapon());
+	if (Weapon != nullptr && Weapon->bIsRangeWeapon == true)
+	{
+		return FMath::Max(Weapon->AttackRange, MeleeAttackRange);
+	}
+
+	return MeleeAttackRange;
+}
+
+int32 UAIBrainSubsystem::GetBrainCount(EAIBrainState State) const
+{
+	int32 Count = 0;
+	for (const FAIBrain& Brain : Brains)
+	{
+		Count += Brain.State == State ? 1 : 0;
+	}
+
+	return Count;
+}
+
+int32 UAIBrainSubsystem::FindBrainIndex(uint32 BrainId) const
+{
+	return Brains.IndexOfByPredicate([BrainId](const FAIBrain& Brain) { return Brain.BrainId == BrainId; });
+}
+
+int32 UAIBrainSubsystem::FindBrainIndex(const AFHAIController* Controller) const
+{
+	return Brains.IndexOfByPredicate([Controller](const FAIBrain& Brain) { return Brain.Controller.Get() == Controller; });
+}
+
+void UAIBrainSubsystem::Report() const
+{
+	UE_LOG(LogClass, Warning, TEXT("AIBrain::Report :: Brains %d, Thinks %lld, Traces %lld, Attacks %lld, Budget Exceeded Frames %lld"), Brains.Num(), ThinkCount, TraceCount, AttackCount, BudgetExceededCount);
+	UE_LOG(LogClass, Warning, TEXT("AIBrain::ThinkCost Frames %6lld, Mean %6.3fms, p50 %6.3fms, p95 %6.3fms, p99 %6.3fms, Max %6.3fms"),
+		ThinkCostHistogram.GetCount(),
+		ThinkCostHistogram.GetMean() * 1000.0,
+		ThinkCostHistogram.GetPercentile(50.0) * 1000.0,
+		ThinkCostHistogram.GetPercentile(95.0) * 1000.0,
+		ThinkCostHistogram.GetPercentile(99.0) * 1000.0,
+		ThinkCostHistogram.GetMax() * 1000.0);
+	UE_LOG(LogClass, Warning, TEXT("AIBrain::ThinkLag Thinks %6lld, Mean %6.3fms, p50 %6.3fms, p95 %6.3fms, p99 %6.3fms, Max %6.3fms"),
+		ThinkLagHistogram.GetCount(),
+		ThinkLagHistogram.GetMean() * 1000.0,
+		ThinkLagHistogram.GetPercentile(50.0) * 1000.0,
+		ThinkLagHistogram.GetPercentile(95.0) * 1000.0,
+		ThinkLagHistogram.GetPercentile(99.0) * 1000.0,
+		ThinkLagHistogram.GetMax() * 1000.0);
+}
+
+void UAIBrainSubsystem::ResetStats()
+{
+	ThinkCostHistogram.Reset();
+	ThinkLagHistogram.Reset();
+	ThinkCount = 0;
+	TraceCount = 0;
+	AttackCount = 0;
+	BudgetExceededCount = 0;
+}
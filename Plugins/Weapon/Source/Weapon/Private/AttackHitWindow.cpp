@@ -0,0 +1,156 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AttackHitWindow.h"
+#include "Animation/AnimMontage.h"
+#include "Animation/AnimSequence.h"
+#include "Animation/Skeleton.h"
+#include "Engine/SkeletalMesh.h"
+#include "Engine/SkeletalMeshSocket.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshSocket.h"
+#include "ApplyDamageAnimNotifyState.h"
+
+
+void FBakedAttackWindow::Sample(float MontageTime, FVector& OutStartLocation, FVector& OutEndLocation) const
+{
+	//Check Window has Sample
+	if (StartSocketPath.Num() == 0 || StartSocketPath.Num() != EndSocketPath.Num())
+	{
+		OutStartLocation = FVector::ZeroVector;
+		OutEndLocation = FVector::ZeroVector;
+		return;
+	}
+
+	//Find Sample Index and Interpolate Alpha
+	const int32 LastIndex = StartSocketPath.Num() - 1;
+	const float SampleTime = SampleInterval > 0.0f ? (FMath::Clamp(MontageTime, StartTime, EndTime) - StartTime) / SampleInterval : 0.0f;
+	const int32 Index = FMath::Clamp(FMath::FloorToInt(SampleTime), 0, LastIndex);
+	const int32 NextIndex = FMath::Min(Index + 1, LastIndex);
+	const float Alpha = FMath::Clamp(SampleTime - Index, 0.0f, 1.0f);
+
+	OutStartLocation = FVector(FMath::Lerp(StartSocketPath[Index], StartSocketPath[NextIndex], Alpha));
+	OutEndLocation = FVector(FMath::Lerp(EndSocketPath[Index], EndSocketPath[NextIndex], Alpha));
+}
+
+bool FBakedAttackCurve::IsValidFor(const UAnimMontage* TargetMontage) const
+{
+	return TargetMontage != nullptr && Montage == TargetMontage && Windows.Num() > 0;
+}
+
+#if WITH_EDITOR
+//Return Bone Transform in Component Space at Montage Time
+//Only use at Bake Time, this function evaluate every parent bone
+static bool GetMontageBoneComponentTransform(const UAnimMontage* TargetMontage, const FReferenceSkeleton& RefSkeleton, int32 BoneIndex, float MontageTime, FTransform& OutTransform)
+{
+	if (TargetMontage->SlotAnimTracks.Num() == 0)
+	{
+		return false;
+	}
+
+	//Attack Montage use First Slot Track
+	const FAnimSegment* Segment = TargetMontage->SlotAnimTracks[0].AnimTrack.GetSegmentAtTime(MontageTime);
+	if (Segment == nullptr)
+	{
+		return false;
+	}
+
+	const UAnimSequence* Sequence = Cast<UAnimSequence>(Segment->GetAnimReference());
+	if (Sequence == nullptr)
+	{
+		return false;
+	}
+
+	const float SequenceTime = Segment->ConvertTrackPosToAnimPos(MontageTime);
+
+	//Child Transform * Parent Transform, Bone to Root
+	OutTransform = FTransform::Identity;
+	for (int32 Index = BoneIndex; Index != INDEX_NONE; Index = RefSkeleton.GetParentIndex(Index))
+	{
+		FTransform LocalTransform;
+		Sequence->GetBoneTransform(LocalTransform, FSkeletonPoseBoneIndex(Index), SequenceTime, false);
+		OutTransform = OutTransform * LocalTransform;
+	}
+
+	return true;
+}
+
+bool FBakedAttackCurve::Bake(UAnimMontage* TargetMontage, const USkeletalMesh* CharacterMesh, FName CharacterSocketName, const UStaticMesh* WeaponMesh, FName StartSocketName, FName EndSocketName, float SampleRate)
+{
+	Montage = TargetMontage;
+	Windows.Reset();
+
+	if (TargetMontage == nullptr || CharacterMesh == nullptr || WeaponMesh == nullptr || CharacterMesh->GetSkeleton() == nullptr || SampleRate <= 0.0f)
+	{
+		UE_LOG(LogClass, Warning, TEXT("BakeAttackCurve::Invalid Bake Source"));
+		return false;
+	}
+
+	//Character Socket where Weapon Attached
+	const USkeletalMeshSocket* CharacterSocket = CharacterMesh->FindSocket(CharacterSocketName);
+
+	//Weapon Attack Socket
+	const UStaticMeshSocket* StartSocket = WeaponMesh->FindSocket(StartSocketName);
+	const UStaticMeshSocket* EndSocket = WeaponMesh->FindSocket(EndSocketName);
+
+	if (CharacterSocket == nullptr || StartSocket == nullptr || EndSocket == nullptr)
+	{
+		UE_LOG(LogClass, Warning, TEXT("BakeAttackCurve::Socket == nullptr"));
+		return false;
+	}
+
+	const FReferenceSkeleton& RefSkeleton = CharacterMesh->GetSkeleton()->GetReferenceSkeleton();
+	const int32 BoneIndex = RefSkeleton.FindBoneIndex(CharacterSocket->BoneName);
+	if (BoneIndex == INDEX_NONE)
+	{
+		UE_LOG(LogClass, Warning, TEXT("BakeAttackCurve::BoneIndex == INDEX_NONE"));
+		return false;
+	}
+
+	const FTransform CharacterSocketTransform = CharacterSocket->GetSocketLocalTransform();
+	const FTransform StartSocketTransform(StartSocket->RelativeRotation, StartSocket->RelativeLocation);
+	const FTransform EndSocketTransform(EndSocket->RelativeRotation, EndSocket->RelativeLocation);
+	const float SampleInterval = 1.0f / SampleRate;
+
+	//Find ApplyDamage Notify Windows
+	for (const FAnimNotifyEvent& NotifyEvent : TargetMontage->Notifies)
+	{
+		if (Cast<UApplyDamageAnimNotifyState>(NotifyEvent.NotifyStateClass) == nullptr)
+		{
+			continue;
+		}
+
+		FBakedAttackWindow& Window = Windows.AddDefaulted_GetRef();
+		Window.StartTime = NotifyEvent.GetTriggerTime();
+		Window.EndTime = NotifyEvent.GetEndTriggerTime();
+		Window.SampleInterval = SampleInterval;
+
+		const int32 NumSamples = FMath::Max(2, FMath::CeilToInt((Window.EndTime - Window.StartTime) / SampleInterval) + 1);
+		Window.StartSocketPath.Reserve(NumSamples);
+		Window.EndSocketPath.Reserve(NumSamples);
+
+		for (int32 SampleIndex = 0; SampleIndex < NumSamples; ++SampleIndex)
+		{
+			const float SampleTime = FMath::Min(Window.StartTime + SampleIndex * SampleInterval, Window.EndTime);
+
+			FTransform BoneTransform;
+			if (GetMontageBoneComponentTransform(TargetMontage, RefSkeleton, BoneIndex, SampleTime, BoneTransform) == false)
+			{
+				BoneTransform = FTransform::Identity;
+			}
+
+			//Weapon Root is Snapped to Character Socket
+			const FTransform WeaponTransform = CharacterSocketTransform * BoneTransform;
+			Window.StartSocketPath.Add(FVector3f((StartSocketTransform * WeaponTransform).GetLocation()));
+			Window.EndSocketPath.Add(FVector3f((EndSocketTransform * WeaponTransform).GetLocation()));
+		}
+	}
+
+	//Server Evaluate Windows in Time Order
+	Windows.Sort([](const FBakedAttackWindow& A, const FBakedAttackWindow& B) { return A.StartTime < B.StartTime; });
+
+	UE_LOG(LogClass, Warning, TEXT("BakeAttackCurve::%s Window Count :: %d"), *TargetMontage->GetName(), Windows.Num());
+
+	return Windows.Num() > 0;
+}
+#endif
@@ -11,6 +11,18 @@
 #include "Kismet/KismetSystemLibrary.h"
 #include "Math/Vector.h"
 #include "FHProjectCharacter.h"
+#include "CharacterSignificanceSubsystem.h"
+#include "CombatWorldSubsystem.h"
+#include "RpcRateLimitSubsystem.h"
+#include "ImpactEventSubsystem.h"
+#include "WeaponProxySubsystem.h"
+#include "HitboxComponent.h"
+#include "LatencyTraceSubsystem.h"
+#include "CombatEventSubsystem.h"
+#include "NetFrequencySubsystem.h"
+#include "Animation/AnimInstance.h"
+#include "GameFramework/PlayerState.h"
+#include "Engine/OverlapResult.h"
 
 
 
@@ -18,8 +30,8 @@
 // Sets default values
 ABaseWeapon::ABaseWeapon()
 {
- 	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
-	PrimaryActorTick.bCanEverTick = true;
+ 	// Attack State is Updated by CombatWorldSubsystem, Weapon doesn't need Tick
+	PrimaryActorTick.bCanEverTick = false;
 
 	// Setting Static Mesh
 	StaticMesh = CreateDefaultSubobject<UStaticMeshComponent>("Mesh");
@@ -27,6 +39,9 @@ ABaseWeapon::ABaseWeapon()
 	StaticMesh->SetCollisionProfileName("Weapon");
 	StaticMesh->SetSimulatePhysics(true);
 
+	//Sleep Event Demote Resting Weapon to Proxy
+	StaticMesh->BodyInstance.bGenerateWakeEvents = true;
+
 	StaticMesh->OnComponentBeginOverlap.AddDynamic(this, &ABaseWeapon::MeshBeginOverlap);
 
 	//Server Replicate Setting
@@ -35,6 +50,7 @@ ABaseWeapon::ABaseWeapon()
 
 	//Initialize LeftClickCount, int Type
 	LeftClickCount = 0;
+	CachedRightClickDamage = 0.0f;
 	
 	//Initialize ClickAttackDamage, int Type
 	ClickAttackDamage = 0;
@@ -49,6 +65,23 @@ ABaseWeapon::ABaseWeapon()
 
 	AttackRange = 1000.f;
 
+	//Projectile Setting, Line Trace if bUseProjectile is false
+	bUseProjectile = false;
+	ProjectileMesh = nullptr;
+	ProjectileSpeed = 3000.0f;
+	ProjectileGravityScale = 1.0f;
+	ProjectileDrag = 0.0f;
+	ProjectileRadius = 8.0f;
+
+	//Multi Hit Setting, Single is First Blocking Hit Only
+	AttackShape = EAttackShape::Single;
+	SpecialAttackShape = EAttackShape::Single;
+	AreaAttackRadius = 250.0f;
+	AreaAttackHalfAngle = 60.0f;
+	MaxTargets = 8;
+	MultiHitFalloff = 0.15f;
+	MinMultiHitDamageScale = 0.4f;
+
 	//Set Attack Socket Name
 	//If you want to change Socket Name, Edit like this -> FName(TEXT("MySocketName"))
 	AttackStartSocketName = FName(TEXT("Attack_Start"));
@@ -72,32 +105,85 @@ ABaseWeapon::ABaseWeapon()
 	bTraceComplex = false;
 	bIgnoreSelf = true;
 
+	//Baked Hit Window Setting
+	BakedHitSampleRate = 30.0f;
+	ActiveBakedCurve = nullptr;
+	BakedWindowIndex = 0;
+	bBakedWindowOpened = false;
+	bActiveBakedWindowHit = false;
+	BakedWindowTime = 0.0f;
+
+	//Proxy Setting
+	bIsProxied = false;
+	bProxyApplied = false;
+	DroppedCollisionEnabled = ECollisionEnabled::QueryAndPhysics;
+
+#if WITH_EDITORONLY_DATA
+	BakeCharacterMesh = nullptr;
+	BakeCharacterSocketName = FName(TEXT("Weapon"));
+#endif
+
 }
 
 void ABaseWeapon::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME(ABaseWeapon, LeftClickCount);
+	DOREPLIFETIME_CONDITION(ABaseWeapon, LeftClickCount, COND_OwnerOnly);
+	DOREPLIFETIME(ABaseWeapon, bIsProxied);
 }
 
 // Called when the game starts or when spawned
 void ABaseWeapon::BeginPlay()
 {
 	Super::BeginPlay();
-	
+
+	//Damage may be Overridden in Blueprint, Cache Right Click Damage
+	UpdateRightClickDamage();
+
+	//Collision may be Overridden in Blueprint, Restore this When Dropped
+	DroppedCollisionEnabled = StaticMesh->GetCollisionEnabled();
+
+	//Server Decide Proxy, Client Follow bIsProxied
+	if (HasAuthority() == true)
+	{
+		StaticMesh->OnComponentSleep.AddDynamic(this, &ABaseWeapon::MeshSleep);
+
+		//Level Placed Weapon (Rack, Pickup Spot) is Resting by Design, Proxy even without Physics or Awake Body
+		//Spawned Weapon already Resting, Don't wait Sleep Event
+		const bool bIsPlacedInLevel = IsNetStartupActor() == true;
+		const bool bIsResting = StaticMesh->IsSimulatingPhysics() == true && StaticMesh->RigidBodyIsAwake() == false;
+		if (OwnerCharacter == nullptr && (bIsPlacedInLevel == true || bIsResting == true))
+		{
+			SetProxied(true);
+		}
+
+		//Dropped Weapon Send Rarely, Held Weapon Follow Owner's Activity
+		if (UNetFrequencySubsystem* FrequencySubsystem = GetWorld()->GetSubsystem<UNetFrequencySubsystem>())
+		{
+			FrequencySubsystem->RegisterActor(this);
+		}
+	}
 }
 
-// Called every frame
-void ABaseWeapon::Tick(float DeltaTime)
+void ABaseWeapon::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	Super::Tick(DeltaTime);
+	if (UNetFrequencySubsystem* FrequencySubsystem = GetWorld()->GetSubsystem<UNetFrequencySubsystem>())
+	{
+		FrequencySubsystem->UnregisterActor(this);
+	}
 
-	/*if (HasAuthority() == true)
+	//Destroyed Weapon can't Remain as Instance
+	if (bProxyApplied == true)
 	{
-		LeftClickCount = GetLeftClickCount();
-	}*/
+		if (UWeaponProxySubsystem* ProxySubsystem = GetWorld()->GetSubsystem<UWeaponProxySubsystem>())
+		{
+			ProxySubsystem->RemoveProxy(this);
+		}
+		bProxyApplied = false;
+	}
 
+	Super::EndPlay(EndPlayReason);
 }
 
 void ABaseWeapon::MeshBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
@@ -154,6 +240,17 @@ void ABaseWeapon::MeshBeginOverlap(UPrimitiveComponent* OverlappedComponent, AAc
 	UE_LOG(LogClass, Warning, TEXT("MeshBeginOverlap - End"));
 }
 
+bool ABaseWeapon::IsNetRelevantFor(const AActor* RealViewer, const AActor* ViewTarget, const FVector& SrcLocation) const
+{
+	// Hidden Actor Stay at Pickup Location, Follow Owner Character's Relevancy
+	if (IsValid(OwnerCharacter) == true)
+	{
+		return OwnerCharacter->IsNetRelevantFor(RealViewer, ViewTarget, SrcLocation);
+	}
+
+	return Super::IsNetRelevantFor(RealViewer, ViewTarget, SrcLocation);
+}
+
 void ABaseWeapon::Event_Test_Implementation()
 {
 	//Server
@@ -162,6 +259,14 @@ void ABaseWeapon::Event_Test_Implementation()
 
 void ABaseWeapon::Req_TestFunction_Implementation()
 {
+	//Check Rpc Rate Limit
+	URpcRateLimitSubsystem* RateLimitSubsystem = GetWorld()->GetSubsystem<URpcRateLimitSubsystem>();
+	if (RateLimitSubsystem != nullptr && RateLimitSubsystem->ConsumeToken(this, TEXT("Req_TestFunction")) == false)
+	{
+		UE_LOG(LogClass, Warning, TEXT("Req_TestFunction::Rate Limited"));
+		return;
+	}
+
 	//Test Function
 	UE_LOG(LogClass, Warning, TEXT("Req_TestFunction::Event_Test - Start"));
 	UE_LOG(LogClass, Warning, TEXT("Req_TestFunction::Event_Test - End"));
@@ -174,11 +279,29 @@ void ABaseWeapon::Event_AttachToComponent_Implementation(ACharacter* TargetChara
 	// Set Owner Character
 	OwnerCharacter = TargetCharacter;
 
-	// SetSimulatePhysics false Because StaticMesh will attach to Target Socket
+	// Picked up Weapon is Actor again, Remove Instance Before Attach
+	if (HasAuthority() == true)
+	{
+		SetProxied(false);
+	}
+	else if (bProxyApplied == true)
+	{
+		ApplyProxyState();
+	}
+
+	// Character Draw Held Weapon by its Equip Weapon Mesh at Target Socket, Actor is not Attached
+	// No Physics State While in Inventory, Slot Change doesn't Recreate Physics Body
+	// Keep Collision Setting Before Attach, Already Held Weapon has No Collision
+	if (StaticMesh->GetCollisionEnabled() != ECollisionEnabled::NoCollision)
+	{
+		DroppedCollisionEnabled = StaticMesh->GetCollisionEnabled();
+	}
 	StaticMesh->SetSimulatePhysics(false);
+	StaticMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	SetActorHiddenInGame(true);
 
-	// And Attach to Target Component Name ( FName("weapon") ) on Character Mesh
-	AttachToComponent(TargetCharacter->GetMesh(), FAttachmentTransformRules::SnapToTargetNotIncludingScale, TargetSocketName);
+	// Hidden Actor don't Move, No Replicated Movement While Held
+	SetReplicateMovement(false);
 
 	UE_LOG(LogClass, Warning, TEXT("Event_AttachToComponent - End"));
 
@@ -188,14 +311,28 @@ void ABaseWeapon::Event_DetachFromActor_Implementation(ACharacter* TargetCharact
 {
 	UE_LOG(LogClass, Warning, TEXT("Event_DetachFromActor - Start"));
 
+	// Drop from Hand, Start at Equip Weapon Mesh Transform
+	const UStaticMeshComponent* AttackMesh = GetAttackMeshComponent();
+	if (AttackMesh != StaticMesh)
+	{
+		SetActorLocationAndRotation(AttackMesh->GetComponentLocation(), AttackMesh->GetComponentQuat(), false, nullptr, ETeleportType::TeleportPhysics);
+	}
+
 	// Set Owner Character null
 	OwnerCharacter = nullptr;
 
-	// SetSimulatePhysics true Because StaticMesh will Detach from Target Socket
+	// Significance may Hide Equip Weapon Mesh, Dropped Weapon always Visible
+	StaticMesh->SetVisibility(true, true);
+	SetActorHiddenInGame(false);
+
+	// Restore Weapon Collision Before Simulate Physics
+	StaticMesh->SetCollisionEnabled(DroppedCollisionEnabled);
+
+	// SetSimulatePhysics true, Dropped Weapon Fall from Hand
 	StaticMesh->SetSimulatePhysics(true);
 
-	// Detach from Owner Character
-	DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
+	// Server Send Dropped Weapon Movement Again
+	SetReplicateMovement(true);
 
 	UE_LOG(LogClass, Warning, TEXT("Event_DetachFromActor - End"));
 }
@@ -216,13 +353,6 @@ void ABaseWeapon::Event_LeftClickAttack_Implementation(bool IsPressed)
 			return;
 		}
 
-		//Check Any Montage Playing
-		if (OwnerCharacter->GetMesh()->GetAnimInstance()->IsAnyMontagePlaying() == true)
-		{
-			UE_LOG(LogClass, Warning, TEXT("Event_LeftClickAttack::IsAnyMontagePlaying == true"));
-			return;
-		}
-
 		// If AttackMontage Is Not Valid = return
 		if (IsValid(AttackMontage) == false)
 		{
@@ -230,14 +360,15 @@ void ABaseWeapon::Event_LeftClickAttack_Implementation(bool IsPressed)
 			return;
 		}
 
-		//Add Left Click Count
-		AddLeftClickCount();
-		UE_LOG(LogClass, Warning, TEXT("Event_LeftClickAttack::LeftClickCount :: %d"), LeftClickCount);
-
-		PlayAttackAnimMontage(AttackMontage);
+		//Click While Attacking is Buffered, Not Dropped
+		UCombatWorldSubsystem* CombatSubsystem = GetWorld()->GetSubsystem<UCombatWorldSubsystem>();
+		if (CombatSubsystem != nullptr && CombatSubsystem->RequestAttack(Cast<AFHProjectCharacter>(OwnerCharacter), EAttackPhase::LeftClick) == false)
+		{
+			UE_LOG(LogClass, Warning, TEXT("Event_LeftClickAttack::Buffered"));
+			return;
+		}
 
-		//Left Click is true
-		SetIsLeftClick(true);
+		StartLeftClickAttack();
 	}
 	else if (IsPressed == false)
 	{
@@ -263,13 +394,6 @@ void ABaseWeapon::Event_RightClickAttack_Implementation(bool IsPressed)
 			return;
 		}
 
-		//Check Any Montage Playing
-		if (OwnerCharacter->GetMesh()->GetAnimInstance()->IsAnyMontagePlaying() == true)
-		{
-			UE_LOG(LogClass, Warning, TEXT("Event_RightClickAttack::IsAnyMontagePlaying::true"));
-			return;
-		}
-
 		// If SpecialAttackMontage Is Not Valid = return
 		if (IsValid(SpecialAttackMontage) == false)
 		{
@@ -277,15 +401,15 @@ void ABaseWeapon::Event_RightClickAttack_Implementation(bool IsPressed)
 			return;
 		}
 
-		//** Move This function ClickEvent **
-		//float RightClickDamage;
-		//RightClickDamage = GetCalculatedRightClickDamage();
-		//UE_LOG(LogClass, Warning, TEXT("CalculatedRightClickDamage :: %d"), RightClickDamage);
-
-		PlayAttackAnimMontage(SpecialAttackMontage);
+		//Click While Attacking is Buffered, Not Dropped
+		UCombatWorldSubsystem* CombatSubsystem = GetWorld()->GetSubsystem<UCombatWorldSubsystem>();
+		if (CombatSubsystem != nullptr && CombatSubsystem->RequestAttack(Cast<AFHProjectCharacter>(OwnerCharacter), EAttackPhase::RightClick) == false)
+		{
+			UE_LOG(LogClass, Warning, TEXT("Event_RightClickAttack::Buffered"));
+			return;
+		}
 
-		//Left Click is flase
-		SetIsLeftClick(false);
+		StartRightClickAttack();
 	}
 	else if (IsPressed == false)
 	{
@@ -304,6 +428,24 @@ void ABaseWeapon::Event_ClickAttack_Implementation()
 	FVector AttackStartLocation;
 	FVector AttackEndLocation;
 
+	//Projectile Weapon, Damage is Applied When Projectile Hit
+	if (bIsRangeWeapon == true && bUseProjectile == true)
+	{
+		UE_LOG(LogClass, Warning, TEXT("Event_ClickAttack::UseProjectile == true"));
+
+		if (HasAuthority() == true)
+		{
+			RangeAttack();
+		}
+
+		if (ShouldSpawnCosmetics() == true)
+		{
+			UGameplayStatics::SpawnSoundAtLocation(GetWorld(), AttackSound, GetAttackMeshComponent()->GetSocketLocation(AttackSoundSocketName));
+		}
+
+		return;
+	}
+
 	if (bIsRangeWeapon == true)
 	{
 		UE_LOG(LogClass, Warning, TEXT("Event_ClickAttack::IsRangeWeapon == true"));
@@ -324,7 +466,7 @@ void ABaseWeapon::Event_ClickAttack_Implementation()
 
 		//Get Distance to Player's Camera and StaticMesh's Attack Start Socket Location
 		float Distance;
-		Distance = FVector::Distance(CameraLocation, StaticMesh->GetSocketLocation(AttackStartSocketName));
+		Distance = FVector::Distance(CameraLocation, GetAttackMeshComponent()->GetSocketLocation(AttackStartSocketName));
 
 		//Attack Start Location is
 		AttackStartLocation = CameraLocation + (CameraForwardVector * Distance);
@@ -340,7 +482,7 @@ void ABaseWeapon::Event_ClickAttack_Implementation()
 		//If Range Weapon, Spawn Emitter at Attack End Location
 		//Rotation is Weapon StaticMesh's Rotation Value
 		//UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), AttackEffect, AttackEndLocation, StaticMesh->GetRelativeRotation(), AttackEffectScale);
-		//** Move this function Res_SpawnEmitterAtTargetLocation **
+		//** Move this function SpawnImpactEffect, Sent by ImpactEventSubsystem **
 		//Because After Trace, Client can't see Effect
 	}
 	else
@@ -349,261 +491,598 @@ void ABaseWeapon::Event_ClickAttack_Implementation()
 		//Not Range Weapon
 
 		//Set Start, End Point Location Vector by Socket Location, Target is Weapon Mesh's Socket
-		AttackStartLocation = StaticMesh->GetSocketLocation(AttackStartSocketName);
-		AttackEndLocation = StaticMesh->GetSocketLocation(AttackEndSocketName);
+		AttackStartLocation = GetAttackMeshComponent()->GetSocketLocation(AttackStartSocketName);
+		AttackEndLocation = GetAttackMeshComponent()->GetSocketLocation(AttackEndSocketName);
 
 		//Spawn Target Emitter by Weapon Type
 		//If not Range Weapon, Spawn Emitter at AttackEffectSocket's Location, Rotation
-		UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), AttackEffect, StaticMesh->GetSocketLocation(AttackEffectSocketName), StaticMesh->GetSocketRotation(AttackEffectSocketName), AttackEffectScale);
+		if (ShouldSpawnCosmetics() == true)
+		{
+			UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), AttackEffect, GetAttackMeshComponent()->GetSocketLocation(AttackEffectSocketName), GetAttackMeshComponent()->GetSocketRotation(AttackEffectSocketName), AttackEffectScale);
+		}
 	}
 
 	//Spawn Target Sound AttackSoundSocket's Location
-	UGameplayStatics::SpawnSoundAtLocation(GetWorld(), AttackSound, StaticMesh->GetSocketLocation(AttackSoundSocketName));
+	if (ShouldSpawnCosmetics() == true)
+	{
+		UGameplayStatics::SpawnSoundAtLocation(GetWorld(), AttackSound, GetAttackMeshComponent()->GetSocketLocation(AttackSoundSocketName));
+	}
 
-	//----------[ UNetDirver Error Start ]----------
-	//Check Has Authority
-	/*if (HasAuthority() == false)
+	//Server already Evaluate this Attack by Baked Curve, Notify is Cosmetic Only
+	if (HasBakedHitWindow(GetIsLeftClick() == true ? AttackMontage : SpecialAttackMontage) == true)
 	{
-		UE_LOG(LogClass, Warning, TEXT("HasAuthority == false"));
+		UE_LOG(LogClass, Warning, TEXT("Event_ClickAttack::HasBakedHitWindow == true"));
 		return;
-	}*/
+	}
 
-	//Check Weapon's OwnerCharacter is First Index Player
-	if (UGameplayStatics::GetPlayerCharacter(GetWorld(), 0) != OwnerCharacter)
+	//Only Locally Controlled Character Request Damage
+	if (OwnerCharacter == nullptr || OwnerCharacter->IsLocallyControlled() == false)
 	{
-		UE_LOG(LogClass, Warning, TEXT("Event_ClickAttack::GetPlayerCharacter != OwnerCharacter"));
+		UE_LOG(LogClass, Warning, TEXT("Event_ClickAttack::IsLocallyControlled == false"));
 		return;
 	}
-	//----------[ UNetDirver Error End ]----------
 
 
-	//Active Event by Left Click Value
-	//Use Start, End Location is Same, Difference is only Damage
-	if (GetIsLeftClick() == true)
+	//Left and Right Click Send Same Segment
+	//Server Choose Default or Cached Right Click Damage by its Own Click State
+	UE_LOG(LogClass, Warning, TEXT("Event_ClickAttack::GetIsLeftClick == %d"), GetIsLeftClick() == true ? 1 : 0);
+	Req_ApplyDamageToTargetActor(AttackStartLocation, AttackEndLocation);
+
+	UE_LOG(LogClass, Warning, TEXT("Event_ClickAttack - End"));
+}
+
+void ABaseWeapon::StartComboAttack(EAttackPhase NewPhase)
+{
+	//Weapon Dropped While Input Buffered
+	if (OwnerCharacter == nullptr)
 	{
-		UE_LOG(LogClass, Warning, TEXT("Event_ClickAttack::GetIsLeftClick == true"));
+		UE_LOG(LogClass, Warning, TEXT("StartComboAttack::OwnerCharacter == nullptr"));
+		return;
+	}
 
-		//Left Click Damage Event Use Default Damage
-		Req_ApplyDamageToTargetActor(AttackStartLocation, AttackEndLocation, GetClickAttackDamage());
+	if (NewPhase == EAttackPhase::LeftClick && IsValid(AttackMontage) == true)
+	{
+		StartLeftClickAttack();
 	}
-	else
+	else if (NewPhase == EAttackPhase::RightClick && IsValid(SpecialAttackMontage) == true)
 	{
-		UE_LOG(LogClass, Warning, TEXT("Event_ClickAttack::GetIsLeftClick == false"));
-
-		//Right Click Damage Event Use Calculated Damage
-		Req_ApplyDamageToTargetActor(AttackStartLocation, AttackEndLocation, GetCalculatedRightClickDamage());
-	
-		UE_LOG(LogClass, Warning, TEXT("Event_ClickAttack::Initialize LeftClickCount :: %d"), LeftClickCount);
+		StartRightClickAttack();
 	}
-
-	UE_LOG(LogClass, Warning, TEXT("Event_ClickAttack - End"));
 }
 
-void ABaseWeapon::Req_InitializeLeftClickCount_Implementation()
+void ABaseWeapon::StartLeftClickAttack()
 {
-	//Server
-	UE_LOG(LogClass, Warning, TEXT("Req_InitializeLeftClickCount"));
-	Res_InitializeLeftClickCount();
-}
+	StampAttackStart();
 
-void ABaseWeapon::Res_InitializeLeftClickCount_Implementation()
-{
-	//Client
-	UE_LOG(LogClass, Warning, TEXT("Res_InitializeLeftClickCount"));
-	LeftClickCount = 0;
+	//Add Left Click Count
+	//Server and Owner only, LeftClickCount is Owner Only, Simulated Proxy never Get Reset
+	if (HasAuthority() == true || OwnerCharacter->IsLocallyControlled() == true)
+	{
+		AddLeftClickCount();
+	}
+	UE_LOG(LogClass, Warning, TEXT("StartLeftClickAttack::LeftClickCount :: %d"), LeftClickCount);
+
+	PlayAttackAnimMontage(AttackMontage);
+
+	//Left Click is true
+	SetIsLeftClick(true);
+
+	//Server Evaluate Hit by Baked Curve, Don't wait Anim Notify
+	if (HasAuthority() == true && HasBakedHitWindow(AttackMontage) == true)
+	{
+		StartBakedHitWindow(AttackMontage);
+	}
 }
 
-float ABaseWeapon::GetCalculatedRightClickDamage()
+void ABaseWeapon::StartRightClickAttack()
 {
-	UE_LOG(LogClass, Warning, TEXT("GetCalculatedRightClickDamage - Start"));
-	//Calculate Right Click Damage
-
-	//Create Return Value
-	float RightClickDamage;
-	RightClickDamage = 0;
+	StampAttackStart();
 
-	// ** Right Click Damage = Default Damage + ( Default Damage * (Click Count * 0.1f)) **
-	// Default Damage = Click Attack Damage
-	// (Click Count * 0.1f) -> 1 = 0.1, 2 = 0.2, 3 = 0.3,,,
+	PlayAttackAnimMontage(SpecialAttackMontage);
 
-	//RightClickDamage increase by LeftClickCount Value
-	//Each Left Click increase Damage Value 10%
-	UE_LOG(LogClass, Warning, TEXT("GetCalculatedRightClickDamage::LeftClickCount :: %d"), GetLeftClickCount());
-	RightClickDamage = GetClickAttackDamage() + (GetClickAttackDamage() * (GetLeftClickCount() * 0.1f));
+	//Left Click is flase
+	SetIsLeftClick(false);
 
-	//Check Calculated Damage Value
-	if (RightClickDamage > GetMaxRightClickDamage())
+	//Server Evaluate Hit by Baked Curve, Don't wait Anim Notify
+	if (HasAuthority() == true && HasBakedHitWindow(SpecialAttackMontage) == true)
 	{
-		UE_LOG(LogClass, Warning, TEXT("GetCalculatedRightClickDamage::RightClickDamage > GetMaxRightClickDamage"));
-		UE_LOG(LogClass, Warning, TEXT("GetCalculatedRightClickDamage::RightClickDamage Value Before Change:: %f"), RightClickDamage);
-		//If Calculated Value bigger than Max Value, Set Calculated Value to Max Value
-		RightClickDamage = GetMaxRightClickDamage();
+		StartBakedHitWindow(SpecialAttackMontage);
 	}
-	
-	//Check Calculated Value
-	UE_LOG(LogClass, Warning, TEXT("GetCalculatedRightClickDamage::RightClickDamage :: %f"), RightClickDamage);
+}
 
-	UE_LOG(LogClass, Warning, TEXT("GetCalculatedRightClickDamage - End"));
+void ABaseWeapon::StampAttackStart()
+{
+	//Server Only, Client Attack Start is Cosmetic
+	if (HasAuthority() == false)
+	{
+		return;
+	}
 
-	return RightClickDamage;
+	if (ULatencyTraceSubsystem* LatencySubsystem = GetWorld()->GetSubsystem<ULatencyTraceSubsystem>())
+	{
+		LatencySubsystem->StampAttackStart(OwnerCharacter);
+	}
 }
 
-void ABaseWeapon::PlayAttackAnimMontage(UAnimMontage* TargetAttackMontage)
+void ABaseWeapon::ResetLeftClickCount()
 {
-	UE_LOG(LogClass, Warning, TEXT("PlayAttackAnimMontage - Start"));
-	//Play Attack AnimMontage
-
-	OwnerCharacter->PlayAnimMontage(TargetAttackMontage);
+	//Server, No RPC, Owner Client Get 0 by Replication
+	UE_LOG(LogClass, Warning, TEXT("ResetLeftClickCount"));
+	LeftClickCount = 0;
+	UpdateRightClickDamage();
 
-	UE_LOG(LogClass, Warning, TEXT("PlayAttackAnimMontage - End"));
+	if (UCombatWorldSubsystem* CombatSubsystem = GetWorld()->GetSubsystem<UCombatWorldSubsystem>())
+	{
+		CombatSubsystem->ResetComboCount(Cast<AFHProjectCharacter>(OwnerCharacter));
+	}
 }
 
-void ABaseWeapon::RangeAttack()
+void ABaseWeapon::RestoreLeftClickCount(int32 NewCount)
 {
-	UE_LOG(LogClass, Warning, TEXT("RangeAttack - Start"));
+	if (HasAuthority() == false)
+	{
+		return;
+	}
+
+	LeftClickCount = FMath::Max(NewCount, 0);
+	UpdateRightClickDamage();
+
+	//Combo Count Follow Active Weapon only
+	AFHProjectCharacter* OwnerFHCharacter = Cast<AFHProjectCharacter>(OwnerCharacter);
+	if (OwnerFHCharacter == nullptr || OwnerFHCharacter->GetEquipWeapon() != this)
+	{
+		return;
+	}
 
+	if (UCombatWorldSubsystem* CombatSubsystem = GetWorld()->GetSubsystem<UCombatWorldSubsystem>())
+	{
+		CombatSubsystem->SetComboCount(OwnerFHCharacter, LeftClickCount);
+	}
 }
 
-void ABaseWeapon::CloseAttack()
+void ABaseWeapon::OnRep_LeftClickCount()
 {
-	UE_LOG(LogClass, Warning, TEXT("CloseAttack - Start"));
+	//Owner Client, Server Count is Authority
+	UpdateRightClickDamage();
 
+	if (UCombatWorldSubsystem* CombatSubsystem = GetWorld()->GetSubsystem<UCombatWorldSubsystem>())
+	{
+		CombatSubsystem->SetComboCount(Cast<AFHProjectCharacter>(OwnerCharacter), LeftClickCount);
+	}
 }
 
-void ABaseWeapon::Res_SpawnEmitterAtTargetLocation_Implementation(FVector TargetLocation, FRotator TargetRotation)
+void ABaseWeapon::AddLeftClickCount()
 {
-	UE_LOG(LogClass, Warning, TEXT("SpawnEmitterAtTargetLocation - Start"));
-	//Range Weapon Use this function
-
-	UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), AttackEffect, TargetLocation, TargetRotation, AttackEffectScale);
+	//Combo Count is in CombatWorldSubsystem, LeftClickCount is Replicated Copy
+	UCombatWorldSubsystem* CombatSubsystem = GetWorld()->GetSubsystem<UCombatWorldSubsystem>();
+	if (CombatSubsystem == nullptr)
+	{
+		LeftClickCount += 1;
+	}
+	else
+	{
+		LeftClickCount = CombatSubsystem->AddComboCount(Cast<AFHProjectCharacter>(OwnerCharacter));
+	}
 
-	UE_LOG(LogClass, Warning, TEXT("SpawnEmitterAtTargetLocation - End"));
+	UpdateRightClickDamage();
 }
 
-void ABaseWeapon::Req_ApplyDamageToTargetActor_Implementation(FVector StartLocation, FVector EndLocation, float Damage)
+void ABaseWeapon::UpdateRightClickDamage()
 {
-	UE_LOG(LogClass, Warning, TEXT("ApplyDamageToTargetActor - Start"));
+	// ** Right Click Damage = Default Damage + ( Default Damage * (Click Count * 0.1f)) **
+	// Default Damage = Click Attack Damage
+	// (Click Count * 0.1f) -> 1 = 0.1, 2 = 0.2, 3 = 0.3,,,
 
-	//Check Damage Value
-	UE_LOG(LogClass, Warning, TEXT("ApplyDamageToTargetActor::Apply Damage :: %f"), Damage);
+	//RightClickDamage increase by LeftClickCount Value
+	//Each Left Click increase Damage Value 10%
+	const float RightClickDamage = GetClickAttackDamage() + (GetClickAttackDamage() * (GetLeftClickCount() * 0.1f));
 
-	UE_LOG(LogClass, Warning, TEXT("ApplyDamageToTargetActor::StartLocation %s"), *StartLocation.ToString());
-	UE_LOG(LogClass, Warning, TEXT("ApplyDamageToTargetActor::EndLocation %s"), *EndLocation.ToString());
+	//If Calculated Value bigger than Max Value, Set Calculated Value to Max Value
+	CachedRightClickDamage = FMath::Min(RightClickDamage, GetMaxRightClickDamage());
+}
 
-	//Trace Result Value
-	bool bIsHit;
-	bIsHit = true;
+void ABaseWeapon::PlayAttackAnimMontage(UAnimMontage* TargetAttackMontage)
+{
+	UE_LOG(LogClass, Warning, TEXT("PlayAttackAnimMontage - Start"));
+	//Play Attack AnimMontage
 
-	//Set Collision for Trace Function
-	FHitResult AttackHitResult;
-	FCollisionObjectQueryParams QueryParams;
-	QueryParams.AddObjectTypesToQuery(ECollisionChannel::ECC_Pawn);
-	QueryParams.AddObjectTypesToQuery(ECollisionChannel::ECC_WorldStatic);
-	QueryParams.AddObjectTypesToQuery(ECollisionChannel::ECC_WorldDynamic);
-	QueryParams.AddObjectTypesToQuery(ECollisionChannel::ECC_PhysicsBody);
-	QueryParams.AddObjectTypesToQuery(ECollisionChannel::ECC_Vehicle);
-	QueryParams.AddObjectTypesToQuery(ECollisionChannel::ECC_Destructible);
+	const float PlayLength = OwnerCharacter->PlayAnimMontage(TargetAttackMontage);
 
-	//Start Trace by Weapon Type
-	//Range Weapon is LineTrace, else Weapon SphereTrace
-	if (bIsRangeWeapon == true)
+	//Attack Phase End When Montage End
+	if (UCombatWorldSubsystem* CombatSubsystem = GetWorld()->GetSubsystem<UCombatWorldSubsystem>())
 	{
-		UE_LOG(LogClass, Warning, TEXT("ApplyDamageToTargetActor::IsRangeWeapon == true"));
+		const EAttackPhase NewPhase = TargetAttackMontage == AttackMontage ? EAttackPhase::LeftClick : EAttackPhase::RightClick;
+		CombatSubsystem->StartAttackPhase(Cast<AFHProjectCharacter>(OwnerCharacter), NewPhase, PlayLength);
+	}
 
-		//----------[ Add Ignore Actor ]----------
-		FCollisionQueryParams QueryParamsIgnoredActor;
-		QueryParamsIgnoredActor.AddIgnoredActor(OwnerCharacter);
-		QueryParamsIgnoredActor.AddIgnoredActor(this);
+	UE_LOG(LogClass, Warning, TEXT("PlayAttackAnimMontage - End"));
+}
 
-		//Trace by Location Value, Collision
-		bIsHit = GetWorld()->LineTraceSingleByObjectType(AttackHitResult, StartLocation, EndLocation, QueryParams, QueryParamsIgnoredActor);
+UStaticMeshComponent* ABaseWeapon::GetAttackMeshComponent() const
+{
+	// Equip Weapon Mesh has Same Static Mesh and Sockets, Only Active Slot Weapon is Drawn
+	const AFHProjectCharacter* Character = Cast<AFHProjectCharacter>(OwnerCharacter);
+	UStaticMeshComponent* EquipWeaponMesh = Character != nullptr ? Character->GetEquipWeaponMesh() : nullptr;
+	if (EquipWeaponMesh != nullptr && EquipWeaponMesh->GetStaticMesh() != nullptr && EquipWeaponMesh->GetStaticMesh() == StaticMesh->GetStaticMesh())
+	{
+		return EquipWeaponMesh;
+	}
 
-		//DrawDebugLine for Check LineTrace Function is Working
-		DrawDebugLine(GetWorld(), StartLocation, EndLocation, FColor::Yellow, false, 5.0f);
+	return StaticMesh;
+}
 
-		//If LineTrace hit anything, Spawn Emitter at Trace Blocking Location
-		//Not hit anything, Spawn Emitter at Trace End Location
-		if (AttackHitResult.bBlockingHit == true)
-		{
-			UE_LOG(LogClass, Warning, TEXT("ApplyDamageToTargetActor::BlockingHit == true"));
-			Res_SpawnEmitterAtTargetLocation(AttackHitResult.Location, StaticMesh->GetRelativeRotation());
-		}
-		else
-		{
-			UE_LOG(LogClass, Warning, TEXT("ApplyDamageToTargetActor::BlockingHit == false"));
-			Res_SpawnEmitterAtTargetLocation(EndLocation, StaticMesh->GetRelativeRotation());
-		}
+void ABaseWeapon::SetProxied(bool bNewProxied)
+{
+	if (HasAuthority() == false || bIsProxied == bNewProxied)
+	{
+		return;
+	}
 
+	if (bNewProxied == true)
+	{
+		//Send bIsProxied once, then Actor stop Replicating until Promote
+		bIsProxied = true;
+		ForceNetUpdate();
+		SetNetDormancy(DORM_DormantAll);
 	}
 	else
 	{
-		UE_LOG(LogClass, Warning, TEXT("ApplyDamageToTargetActor::IsRangeWeapon == false"));
+		//Wake First, Dormant Actor doesn't Send Changed Property
+		SetNetDormancy(DORM_Awake);
+		bIsProxied = false;
+		ForceNetUpdate();
+	}
 
-		//----------[ Add Ignore Actor ]----------
-		TArray<AActor*> IgnoreActors;
-		//----------[ Check Ignore Character Here ]----------
-		IgnoreActors.Add(OwnerCharacter);
-		IgnoreActors.Add(this);
+	ApplyProxyState();
+}
 
-		//Start SphereTrace
-		//Color Red = Hit false, Green = Hit true
-		bIsHit = UKismetSystemLibrary::SphereTraceSingle
-		(
-			GetWorld(),
-			StartLocation,
-			EndLocation,
-			TraceSphereRadius,
-			UEngineTypes::ConvertToTraceType(ECollisionChannel::ECC_OverlapAll_Deprecated),
-			bTraceComplex,
-			IgnoreActors,
-			EDrawDebugTrace::ForDuration,
-			AttackHitResult,
-			bIgnoreSelf,
-			FColor::Red,
-			FColor::Green,
-			5.f
-		);
+void ABaseWeapon::OnRep_IsProxied()
+{
+	ApplyProxyState();
+}
 
+void ABaseWeapon::ApplyProxyState()
+{
+	//Client may Receive Attach Before bIsProxied, Owned Weapon is never Proxy
+	const bool bShouldApply = bIsProxied == true && OwnerCharacter == nullptr;
+	if (bShouldApply == bProxyApplied)
+	{
+		return;
 	}
 
-	//If Trace(Attack) can't hit Anything, return
-	if (bIsHit == false)
+	UWeaponProxySubsystem* ProxySubsystem = GetWorld()->GetSubsystem<UWeaponProxySubsystem>();
+	if (ProxySubsystem == nullptr)
 	{
-		UE_LOG(LogClass, Warning, TEXT("ApplyDamageToTargetActor::IsHit == false"));
-
-		//Initialize LeftClickCount 0;
-		UE_LOG(LogClass, Warning, TEXT("ApplyDamageToTargetActor::InitializeLeftClickCount"));
-		Req_InitializeLeftClickCount();
-
+		UE_LOG(LogClass, Warning, TEXT("ApplyProxyState::ProxySubsystem == nullptr"));
 		return;
 	}
 
-	//Get Hit Actor
-	AActor* HitTargetObj = Cast<AActor>(AttackHitResult.GetActor());
+	bProxyApplied = bShouldApply;
 
-	//Check Hit Actor nullptr
-	if (HitTargetObj == nullptr)
+	if (bShouldApply == true)
 	{
-		UE_LOG(LogClass, Warning, TEXT("ApplyDamageToTargetActor::HitTargetObj == nullptr"));
+		//Instance Draw Weapon, Actor has No Render, Physics and Collision Cost
+		StaticMesh->SetSimulatePhysics(false);
+		StaticMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		SetActorHiddenInGame(true);
+		ProxySubsystem->AddProxy(this);
 		return;
 	}
-	
-	//Check Hit Actor's Name
-	UE_LOG(LogClass, Warning, TEXT("ApplyDamageToTargetActor::Hit Actor :: %s"), *FString(HitTargetObj->GetName()));
 
-	//Apply Damage to Hit Actor, This function Active Target's TakeDamage
-	UGameplayStatics::ApplyDamage(HitTargetObj, Damage, OwnerCharacter->GetController(), this, UDamageType::StaticClass());
+	ProxySubsystem->RemoveProxy(this);
 
-	//Check Click was Right Click
-	if (GetIsLeftClick() == false)
+	//Held Weapon is Drawn by Owner Character's Equip Weapon Mesh
+	SetActorHiddenInGame(OwnerCharacter != nullptr);
+
+	//Attached Weapon Set own Physics State
+	if (OwnerCharacter == nullptr)
 	{
-		UE_LOG(LogClass, Warning, TEXT("ApplyDamageToTargetActor::GetIsLeftClick == false"));
+		StaticMesh->SetCollisionEnabled(DroppedCollisionEnabled);
+		StaticMesh->SetSimulatePhysics(true);
+	}
+}
 
-		//Initialize LeftClickCount 0;
-		UE_LOG(LogClass, Warning, TEXT("ApplyDamageToTargetActor::InitializeLeftClickCount"));
-		Req_InitializeLeftClickCount();
+void ABaseWeapon::MeshSleep(UPrimitiveComponent* SleepingComponent, FName BoneName)
+{
+	//Dropped Weapon Stop Moving
+	if (OwnerCharacter != nullptr)
+	{
+		return;
+	}
+
+	UE_LOG(LogClass, Warning, TEXT("MeshSleep::SetProxied"));
+	SetProxied(true);
+}
+
+bool ABaseWeapon::ShouldSpawnCosmetics() const
+{
+	const UCharacterSignificanceSubsystem* SignificanceSubsystem = GetWorld()->GetSubsystem<UCharacterSignificanceSubsystem>();
+	if (SignificanceSubsystem == nullptr || OwnerCharacter == nullptr)
+	{
+		return true;
+	}
+
+	return SignificanceSubsystem->ShouldSpawnCosmetics(OwnerCharacter);
+}
+
+void ABaseWeapon::RangeAttack()
+{
+	UE_LOG(LogClass, Warning, TEXT("RangeAttack - Start"));
+
+	//Server Launch, Client Receive Launch Params and Simulate Same Path
+	if (HasAuthority() == false || OwnerCharacter == nullptr)
+	{
+		UE_LOG(LogClass, Warning, TEXT("RangeAttack::HasAuthority == false or OwnerCharacter == nullptr"));
+		return;
+	}
+
+	UProjectileSubsystem* ProjectileSubsystem = GetWorld()->GetSubsystem<UProjectileSubsystem>();
+	if (ProjectileSubsystem == nullptr)
+	{
+		UE_LOG(LogClass, Warning, TEXT("RangeAttack::ProjectileSubsystem == nullptr"));
+		return;
 	}
 
+	//Aim is Owner's Control Rotation, not First Player's Camera
+	const FVector AimDirection = OwnerCharacter->GetBaseAimRotation().Vector();
+
+	FProjectileLaunchParams LaunchParams;
+	LaunchParams.ProjectileId = ProjectileSubsystem->GenerateProjectileId();
+	LaunchParams.Origin = GetAttackMeshComponent()->GetSocketLocation(AttackStartSocketName);
+	LaunchParams.Velocity = AimDirection * ProjectileSpeed;
+	LaunchParams.Quantize();
+
+	const float Damage = GetCurrentAttackDamage();
+	ProjectileSubsystem->LaunchProjectile(this, LaunchParams, Damage);
+
+	Res_LaunchProjectile(LaunchParams);
+
+	UE_LOG(LogClass, Warning, TEXT("RangeAttack - End"));
+}
+
+void ABaseWeapon::Res_LaunchProjectile_Implementation(const FProjectileLaunchParams& LaunchParams)
+{
+	//Client, Server already Launched
+	if (HasAuthority() == true)
+	{
+		return;
+	}
+
+	UProjectileSubsystem* ProjectileSubsystem = GetWorld()->GetSubsystem<UProjectileSubsystem>();
+	if (ProjectileSubsystem == nullptr)
+	{
+		return;
+	}
+
+	//Params Arrive Half Round Trip Late, Simulate Forward
+	float CatchUpTime = 0.0f;
+	APlayerController* LocalController = GetWorld()->GetFirstPlayerController();
+	if (LocalController != nullptr && LocalController->PlayerState != nullptr)
+	{
+		CatchUpTime = LocalController->PlayerState->GetPingInMilliseconds() * 0.5f * 0.001f;
+	}
+
+	//Client Projectile is Cosmetic, No Damage
+	ProjectileSubsystem->LaunchProjectile(this, LaunchParams, 0.0f, CatchUpTime);
+}
+
+UStaticMesh* ABaseWeapon::GetProjectileMesh() const
+{
+	//Throwing Weapon Fly as Itself
+	return ProjectileMesh != nullptr ? ProjectileMesh : StaticMesh->GetStaticMesh();
+}
+
+void ABaseWeapon::CloseAttack()
+{
+	UE_LOG(LogClass, Warning, TEXT("CloseAttack - Start"));
+
+}
+
+void ABaseWeapon::QueueImpactEvent(const FVector& TargetLocation, const FRotator& TargetRotation)
+{
+	//Server, Impact is Cosmetic, Sent Unreliable to Near Connections
+	if (UImpactEventSubsystem* ImpactSubsystem = GetWorld()->GetSubsystem<UImpactEventSubsystem>())
+	{
+		ImpactSubsystem->QueueImpact(this, TargetLocation, TargetRotation);
+	}
+}
+
+void ABaseWeapon::SpawnImpactEffect(const FVector& TargetLocation, const FRotator& TargetRotation)
+{
+	//Range Weapon Use this function
+	//Dedicated Server don't Spawn Cosmetic
+	if (GetNetMode() == NM_DedicatedServer)
+	{
+		return;
+	}
+
+	if (ShouldSpawnCosmetics() == true)
+	{
+		UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), AttackEffect, TargetLocation, TargetRotation, AttackEffectScale);
+	}
+}
+
+bool ABaseWeapon::Req_ApplyDamageToTargetActor_Validate(FVector StartLocation, FVector EndLocation)
+{
+	//Impossible Value Only, Validate Fail Disconnect Client
+	//Stale Position is Normal under Latency, Checked in Implementation
+	if (StartLocation.ContainsNaN() == true || EndLocation.ContainsNaN() == true)
+	{
+		if (URpcRateLimitSubsystem* RateLimitSubsystem = GetWorld()->GetSubsystem<URpcRateLimitSubsystem>())
+		{
+			RateLimitSubsystem->RecordInvalidCall(this, TEXT("Req_ApplyDamageToTargetActor"));
+		}
+
+		return false;
+	}
+
+	return true;
+}
+
+void ABaseWeapon::Req_ApplyDamageToTargetActor_Implementation(FVector StartLocation, FVector EndLocation)
+{
+	//Server
+	//Check Rpc Rate Limit
+	URpcRateLimitSubsystem* RateLimitSubsystem = GetWorld()->GetSubsystem<URpcRateLimitSubsystem>();
+	if (RateLimitSubsystem != nullptr && RateLimitSubsystem->ConsumeToken(this, TEXT("Req_ApplyDamageToTargetActor")) == false)
+	{
+		UE_LOG(LogClass, Warning, TEXT("Req_ApplyDamageToTargetActor::Rate Limited"));
+		return;
+	}
+
+	const float MaxSegmentLength = AttackRange + TraceSphereRadius;
+
+	//Trace Start near Owner, Range Weapon Start from Camera
+	//Too Far is not Latency, Ignore this Attack as Miss
+	if (IsValid(OwnerCharacter) == true && FVector::DistSquared(StartLocation, OwnerCharacter->GetActorLocation()) > FMath::Square(MaxSegmentLength))
+	{
+		UE_LOG(LogClass, Warning, TEXT("Req_ApplyDamageToTargetActor::StartLocation Too Far from Owner"));
+		if (RateLimitSubsystem != nullptr)
+		{
+			RateLimitSubsystem->RecordInvalidCall(this, TEXT("Req_ApplyDamageToTargetActor"));
+		}
+
+		OnAttackTraceResult(false);
+		return;
+	}
+
+	//Trace Segment can't be Longer than Attack Range, Clamp End
+	if (FVector::DistSquared(StartLocation, EndLocation) > FMath::Square(MaxSegmentLength))
+	{
+		UE_LOG(LogClass, Warning, TEXT("Req_ApplyDamageToTargetActor::Segment Clamped to Attack Range"));
+		EndLocation = StartLocation + (EndLocation - StartLocation).GetSafeNormal() * MaxSegmentLength;
+	}
+
+	//Client Count can be Stale, Server Combo State Decide Right Click Damage
+	const bool bIsHit = ApplyDamageToTargetActor(StartLocation, EndLocation, GetCurrentAttackDamage());
+
+	OnAttackTraceResult(bIsHit);
+}
+
+bool ABaseWeapon::ApplyDamageToTargetActor(const FVector& StartLocation, const FVector& EndLocation, float Damage)
+{
+	UE_LOG(LogClass, Warning, TEXT("ApplyDamageToTargetActor - Start"));
+
+	//Check Damage Value
+	UE_LOG(LogClass, Warning, TEXT("ApplyDamageToTargetActor::Apply Damage :: %f"), Damage);
+
+	UE_LOG(LogClass, Warning, TEXT("ApplyDamageToTargetActor::StartLocation %s"), *StartLocation.ToString());
+	UE_LOG(LogClass, Warning, TEXT("ApplyDamageToTargetActor::EndLocation %s"), *EndLocation.ToString());
+
+	if (ULatencyTraceSubsystem* LatencySubsystem = GetWorld()->GetSubsystem<ULatencyTraceSubsystem>())
+	{
+		LatencySubsystem->StampHitResolve(OwnerCharacter);
+	}
+
+	//Multi Hit Shape, One Query for every Target
+	const EAttackShape Shape = GetIsLeftClick() == true ? AttackShape : SpecialAttackShape;
+
+	//Character by Broadphase, Physics Scene Check Occluder and Non Character Target
+	const UCombatWorldSubsystem* CombatSubsystem = GetWorld()->GetSubsystem<UCombatWorldSubsystem>();
+	if (CombatSubsystem != nullptr && CombatSubsystem->UseCapsuleBroadphase() == true && OwnerCharacter != nullptr)
+	{
+		UE_LOG(LogClass, Warning, TEXT("ApplyDamageToTargetActor::UseCapsuleBroadphase == true"));
+		return ApplyBroadphaseDamage(Shape, StartLocation, EndLocation, Damage);
+	}
+	if (Shape != EAttackShape::Single)
+	{
+		UE_LOG(LogClass, Warning, TEXT("ApplyDamageToTargetActor::Shape != Single"));
+		return ApplyMultiHitDamage(Shape, StartLocation, EndLocation, Damage);
+	}
+
+	//Trace Result Value
+	bool bIsHit;
+	bIsHit = true;
+
+	//Set Collision for Trace Function
+	FHitResult AttackHitResult;
+	FCollisionObjectQueryParams QueryParams = GetAttackObjectQueryParams();
+
+	//Start Trace by Weapon Type
+	//Range Weapon is LineTrace, else Weapon SphereTrace
+	if (bIsRangeWeapon == true)
+	{
+		UE_LOG(LogClass, Warning, TEXT("ApplyDamageToTargetActor::IsRangeWeapon == true"));
+
+		//----------[ Add Ignore Actor ]----------
+		FCollisionQueryParams QueryParamsIgnoredActor;
+		QueryParamsIgnoredActor.AddIgnoredActor(OwnerCharacter);
+		QueryParamsIgnoredActor.AddIgnoredActor(this);
+
+		//Trace by Location Value, Collision
+		bIsHit = GetWorld()->LineTraceSingleByObjectType(AttackHitResult, StartLocation, EndLocation, QueryParams, QueryParamsIgnoredActor);
+
+		//DrawDebugLine for Check LineTrace Function is Working
+		DrawDebugLine(GetWorld(), StartLocation, EndLocation, FColor::Yellow, false, 5.0f);
+
+		//If LineTrace hit anything, Spawn Emitter at Trace Blocking Location
+		//Not hit anything, Spawn Emitter at Trace End Location
+		if (AttackHitResult.bBlockingHit == true)
+		{
+			UE_LOG(LogClass, Warning, TEXT("ApplyDamageToTargetActor::BlockingHit == true"));
+			QueueImpactEvent(AttackHitResult.Location, GetAttackMeshComponent()->GetComponentRotation());
+		}
+		else
+		{
+			UE_LOG(LogClass, Warning, TEXT("ApplyDamageToTargetActor::BlockingHit == false"));
+			QueueImpactEvent(EndLocation, GetAttackMeshComponent()->GetComponentRotation());
+		}
+
+	}
+	else
+	{
+		UE_LOG(LogClass, Warning, TEXT("ApplyDamageToTargetActor::IsRangeWeapon == false"));
+
+		//----------[ Add Ignore Actor ]----------
+		TArray<AActor*> IgnoreActors;
+		//----------[ Check Ignore Character Here ]----------
+		IgnoreActors.Add(OwnerCharacter);
+		IgnoreActors.Add(this);
+
+		//Start SphereTrace
+		//Color Red = Hit false, Green = Hit true
+		bIsHit = UKismetSystemLibrary::SphereTraceSingle
+		(
+			GetWorld(),
+			StartLocation,
+			EndLocation,
+			TraceSphereRadius,
+			UEngineTypes::ConvertToTraceType(ECollisionChannel::ECC_OverlapAll_Deprecated),
+			bTraceComplex,
+			IgnoreActors,
+			EDrawDebugTrace::ForDuration,
+			AttackHitResult,
+			bIgnoreSelf,
+			FColor::Red,
+			FColor::Green,
+			5.f
+		);
+
+	}
+
+	//If Trace(Attack) can't hit Anything, return
+	if (bIsHit == false)
+	{
+		UE_LOG(LogClass, Warning, TEXT("ApplyDamageToTargetActor::IsHit == false"));
+		return false;
+	}
+
+	//Get Hit Actor, Proxy Instance Hit Return its Weapon
+	AActor* HitTargetObj = GetHitTarget(AttackHitResult);
+
+	//Check Hit Actor nullptr
+	if (HitTargetObj == nullptr)
+	{
+		UE_LOG(LogClass, Warning, TEXT("ApplyDamageToTargetActor::HitTargetObj == nullptr"));
+		return true;
+	}
+	
+	//Check Hit Actor's Name
+	UE_LOG(LogClass, Warning, TEXT("ApplyDamageToTargetActor::Hit Actor :: %s"), *FString(HitTargetObj->GetName()));
+
+	//Apply Damage to Hit Actor, This function Active Target's TakeDamage
+	ApplyDamageToHitTarget(HitTargetObj, AttackHitResult.ImpactPoint, (EndLocation - StartLocation).GetSafeNormal(), Damage);
+
 	UE_LOG(LogClass, Warning, TEXT("ApplyDamageToTargetActor::ApplyDamage"));
 
 	//Check ApplyDamage End
@@ -611,4 +1090,644 @@ void ABaseWeapon::Req_ApplyDamageToTargetActor_Implementation(FVector StartLocat
 
 	UE_LOG(LogClass, Warning, TEXT("ApplyDamageToTargetActor - End"));
 
+	return true;
+}
+
+bool ABaseWeapon::ApplyMultiHitDamage(EAttackShape Shape, const FVector& StartLocation, const FVector& EndLocation, float Damage)
+{
+	UE_LOG(LogClass, Warning, TEXT("ApplyMultiHitDamage - Start"));
+
+	const FCollisionObjectQueryParams ObjectQueryParams = GetAttackObjectQueryParams();
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(MultiHitAttack), bTraceComplex);
+	QueryParams.AddIgnoredActor(OwnerCharacter);
+	QueryParams.AddIgnoredActor(this);
+
+	TArray<FHitResult> HitResults;
+	FVector Origin = StartLocation;
+	FVector Direction = (EndLocation - StartLocation).GetSafeNormal();
+	FVector ImpactLocation = EndLocation;
+
+	//One Scene Query per Attack, Object Type Query Return every Hit
+	switch (Shape)
+	{
+	case EAttackShape::Arc:
+	case EAttackShape::Cone:
+	{
+		//Sphere Overlap around Owner, Filter by Angle after Query
+		Origin = OwnerCharacter->GetActorLocation();
+		Direction = Shape == EAttackShape::Arc ? OwnerCharacter->GetActorForwardVector().GetSafeNormal2D() : OwnerCharacter->GetBaseAimRotation().Vector();
+
+		TArray<FOverlapResult> OverlapResults;
+		GetWorld()->OverlapMultiByObjectType(OverlapResults, Origin, FQuat::Identity, ObjectQueryParams, FCollisionShape::MakeSphere(AreaAttackRadius), QueryParams);
+
+		const float MinDot = FMath::Cos(FMath::DegreesToRadians(AreaAttackHalfAngle));
+		for (const FOverlapResult& OverlapResult : OverlapResults)
+		{
+			UPrimitiveComponent* OverlapComponent = OverlapResult.GetComponent();
+			if (OverlapComponent == nullptr)
+			{
+				continue;
+			}
+
+			//Closest Point, Big Target at Edge of Arc still Hit
+			FVector TargetLocation;
+			if (OverlapComponent->GetClosestPointOnCollision(Origin, TargetLocation) < 0.0f)
+			{
+				TargetLocation = OverlapComponent->Bounds.Origin;
+			}
+
+			//Arc Ignore Height, Sphere Radius Limit it
+			const FVector ToTarget = Shape == EAttackShape::Arc ? (TargetLocation - Origin).GetSafeNormal2D() : (TargetLocation - Origin).GetSafeNormal();
+
+			//Zero Vector is Target Overlap Origin, always Hit
+			if (ToTarget.IsZero() == false && FVector::DotProduct(ToTarget, Direction) < MinDot)
+			{
+				continue;
+			}
+
+			FHitResult& HitResult = HitResults.Emplace_GetRef(OverlapResult.GetActor(), OverlapComponent, TargetLocation, -ToTarget);
+			HitResult.Item = OverlapResult.ItemIndex;
+		}
+
+		break;
+	}
+	case EAttackShape::CapsuleSweep:
+	{
+		//Sphere Swept along Segment is Capsule
+		GetWorld()->SweepMultiByObjectType(HitResults, StartLocation, EndLocation, FQuat::Identity, ObjectQueryParams, FCollisionShape::MakeSphere(TraceSphereRadius), QueryParams);
+		break;
+	}
+	case EAttackShape::PiercingLine:
+	{
+		GetWorld()->LineTraceMultiByObjectType(HitResults, StartLocation, EndLocation, ObjectQueryParams, QueryParams);
+
+		//Object Type Query Return Hit Behind Wall, Pierce Target but not WorldStatic
+		const int32 WallIndex = HitResults.IndexOfByPredicate([](const FHitResult& HitResult)
+			{
+				return HitResult.GetComponent() != nullptr && HitResult.GetComponent()->GetCollisionObjectType() == ECollisionChannel::ECC_WorldStatic;
+			});
+		if (WallIndex != INDEX_NONE)
+		{
+			ImpactLocation = HitResults[WallIndex].ImpactPoint;
+			HitResults.SetNum(WallIndex);
+		}
+		break;
+	}
+	default:
+		break;
+	}
+
+	//Nearest Target First, Falloff by Target Order
+	HitResults.Sort([&Origin](const FHitResult& A, const FHitResult& B)
+		{
+			return FVector::DistSquared(A.ImpactPoint, Origin) < FVector::DistSquared(B.ImpactPoint, Origin);
+		});
+
+	//Resolve every Target Before Damage, Proxy Promote Change Instance Index
+	TArray<AActor*> HitTargets;
+	TArray<FVector> HitLocations;
+	for (const FHitResult& HitResult : HitResults)
+	{
+		if (HitTargets.Num() >= MaxTargets)
+		{
+			break;
+		}
+
+		//Multi Query Return every Component, Damage One Actor Once
+		AActor* HitTargetObj = GetHitTarget(HitResult);
+		if (IsDamageableTarget(HitTargetObj) == false || HitTargets.Contains(HitTargetObj) == true)
+		{
+			continue;
+		}
+
+		HitTargets.Add(HitTargetObj);
+		HitLocations.Add(HitResult.ImpactPoint);
+	}
+
+	ApplyDamageToHitTargets(HitTargets, HitLocations, Origin, Direction, Damage);
+
+	if (bIsRangeWeapon == true && HitTargets.Num() == 0)
+	{
+		QueueImpactEvent(ImpactLocation, GetAttackMeshComponent()->GetComponentRotation());
+	}
+
+	UE_LOG(LogClass, Warning, TEXT("ApplyMultiHitDamage - End"));
+
+	return HitTargets.Num() > 0;
+}
+
+bool ABaseWeapon::ApplyBroadphaseDamage(EAttackShape Shape, const FVector& StartLocation, const FVector& EndLocation, float Damage)
+{
+	UE_LOG(LogClass, Warning, TEXT("ApplyBroadphaseDamage - Start"));
+
+	const UCombatWorldSubsystem* CombatSubsystem = GetWorld()->GetSubsystem<UCombatWorldSubsystem>();
+	const bool bIsAreaShape = Shape == EAttackShape::Arc || Shape == EAttackShape::Cone;
+
+	//Area Shape is Sphere around Owner, else Swept Sphere along Segment
+	FVector Origin = StartLocation;
+	FVector Direction = (EndLocation - StartLocation).GetSafeNormal();
+	FVector QueryEnd = EndLocation;
+	float QueryRadius = bIsRangeWeapon == true ? 0.0f : TraceSphereRadius;
+
+	if (bIsAreaShape == true)
+	{
+		Origin = OwnerCharacter->GetActorLocation();
+		Direction = Shape == EAttackShape::Arc ? OwnerCharacter->GetActorForwardVector().GetSafeNormal2D() : OwnerCharacter->GetBaseAimRotation().Vector();
+		QueryEnd = Origin;
+		QueryRadius = AreaAttackRadius;
+	}
+	else if (Shape == EAttackShape::PiercingLine)
+	{
+		QueryRadius = 0.0f;
+	}
+
+	TArray<FCapsuleBroadphaseHit> CapsuleHits;
+	CombatSubsystem->QueryCapsules(Origin, QueryEnd, QueryRadius, CapsuleHits);
+
+	//Occluder is Static Geometry Only, Character is not in Physics Query
+	FCollisionObjectQueryParams OccluderObjectParams;
+	OccluderObjectParams.AddObjectTypesToQuery(ECollisionChannel::ECC_WorldStatic);
+
+	FCollisionQueryParams OccluderQueryParams(SCENE_QUERY_STAT(AttackOccluder), false);
+	OccluderQueryParams.AddIgnoredActor(OwnerCharacter);
+	OccluderQueryParams.AddIgnoredActor(this);
+
+	//Non Character Target is Proxied Weapon Instance Only (IsDamageableTarget), still in Physics Scene
+	//Pawn Channel Removed, Character is Resolved by Broadphase Only, Static is Occluder Query
+	FCollisionObjectQueryParams PhysicsObjectParams = GetAttackObjectQueryParams();
+	PhysicsObjectParams.RemoveObjectTypesToQuery(ECollisionChannel::ECC_Pawn);
+	PhysicsObjectParams.RemoveObjectTypesToQuery(ECollisionChannel::ECC_WorldStatic);
+
+	//Instance Bounds Check is Cheap, No Proxy near Attack is No Target Physics Query
+	const UWeaponProxySubsystem* ProxySubsystem = GetWorld()->GetSubsystem<UWeaponProxySubsystem>();
+	const FVector ProxyQueryCenter = bIsAreaShape == true ? Origin : (StartLocation + EndLocation) * 0.5;
+	const float ProxyQueryRadius = bIsAreaShape == true ? AreaAttackRadius : static_cast<float>(FVector::Dist(StartLocation, EndLocation)) * 0.5f + QueryRadius;
+	const bool bHasProxyInRange = ProxySubsystem != nullptr && ProxySubsystem->FindNearestProxy(ProxyQueryCenter, ProxyQueryRadius) != nullptr;
+
+	FCollisionQueryParams PhysicsQueryParams(SCENE_QUERY_STAT(BroadphasePhysicsAttack), bTraceComplex);
+	PhysicsQueryParams.AddIgnoredActor(OwnerCharacter);
+	PhysicsQueryParams.AddIgnoredActor(this);
+
+	const float MinDot = FMath::Cos(FMath::DegreesToRadians(AreaAttackHalfAngle));
+	const int32 TargetLimit = Shape == EAttackShape::Single ? 1 : MaxTargets;
+
+	//Character and Physics Target Together, Sorted by Distance from Origin
+	struct FBroadphaseTarget
+	{
+		AActor* Target;
+		FVector Location;
+		float DistanceSquared;
+	};
+	TArray<FBroadphaseTarget> Targets;
+
+	//Segment Shape, First Occluder Block every Target behind it
+	//Range Weapon always Trace, Impact need Occluder Location
+	FHitResult OccluderHitResult;
+	float OccluderTime = 1.0f;
+	bool bIsBlocked = false;
+
+	if (bIsAreaShape == true && bHasProxyInRange == true)
+	{
+		TArray<FOverlapResult> OverlapResults;
+		GetWorld()->OverlapMultiByObjectType(OverlapResults, Origin, FQuat::Identity, PhysicsObjectParams, FCollisionShape::MakeSphere(AreaAttackRadius), PhysicsQueryParams);
+
+		for (const FOverlapResult& OverlapResult : OverlapResults)
+		{
+			UPrimitiveComponent* OverlapComponent = OverlapResult.GetComponent();
+			if (OverlapComponent == nullptr)
+			{
+				continue;
+			}
+
+			FHitResult OverlapHitResult(OverlapResult.GetActor(), OverlapComponent, OverlapComponent->Bounds.Origin, FVector::ZeroVector);
+			OverlapHitResult.Item = OverlapResult.ItemIndex;
+
+			AActor* HitTargetObj = GetHitTarget(OverlapHitResult);
+			if (IsDamageableTarget(HitTargetObj) == false || HitTargetObj->IsA<APawn>() == true)
+			{
+				continue;
+			}
+
+			//Closest Point, Big Target at Edge of Arc still Hit
+			FVector TargetLocation;
+			if (OverlapComponent->GetClosestPointOnCollision(Origin, TargetLocation) < 0.0f)
+			{
+				TargetLocation = OverlapComponent->Bounds.Origin;
+			}
+
+			//Same Angle Filter as Character
+			const FVector ToTarget = Shape == EAttackShape::Arc ? (TargetLocation - Origin).GetSafeNormal2D() : (TargetLocation - Origin).GetSafeNormal();
+			if (ToTarget.IsZero() == false && FVector::DotProduct(ToTarget, Direction) < MinDot)
+			{
+				continue;
+			}
+
+			Targets.Add({ HitTargetObj, TargetLocation, static_cast<float>(FVector::DistSquared(TargetLocation, Origin)) });
+		}
+	}
+	else if (bIsAreaShape == false)
+	{
+		//Static Geometry Only, First Occluder Block Rest of Segment, Zero Radius is Line Trace
+		if (GetWorld()->SweepSingleByObjectType(OccluderHitResult, StartLocation, EndLocation, FQuat::Identity, OccluderObjectParams, FCollisionShape::MakeSphere(QueryRadius), PhysicsQueryParams) == true)
+		{
+			OccluderTime = OccluderHitResult.Time;
+			bIsBlocked = true;
+
+			//Single Shape Damage Occluder like Trace, Character behind it is Blocked
+			AActor* OccluderActor = GetHitTarget(OccluderHitResult);
+			if (Shape == EAttackShape::Single && OccluderActor != nullptr)
+			{
+				Targets.Add({ OccluderActor, OccluderHitResult.ImpactPoint, static_cast<float>(FVector::DistSquared(OccluderHitResult.ImpactPoint, Origin)) });
+			}
+		}
+
+		//Proxied Weapon in front of Occluder
+		if (bHasProxyInRange == true)
+		{
+			const FVector ClippedEndLocation = FMath::Lerp(StartLocation, EndLocation, static_cast<double>(OccluderTime));
+
+			TArray<FHitResult> PhysicsHits;
+			GetWorld()->SweepMultiByObjectType(PhysicsHits, StartLocation, ClippedEndLocation, FQuat::Identity, PhysicsObjectParams, FCollisionShape::MakeSphere(QueryRadius), PhysicsQueryParams);
+
+			for (const FHitResult& PhysicsHit : PhysicsHits)
+			{
+				AActor* HitTargetObj = GetHitTarget(PhysicsHit);
+				if (IsDamageableTarget(HitTargetObj) == true && HitTargetObj->IsA<APawn>() == false)
+				{
+					Targets.Add({ HitTargetObj, PhysicsHit.ImpactPoint, static_cast<float>(FVector::DistSquared(PhysicsHit.ImpactPoint, Origin)) });
+				}
+			}
+		}
+	}
+
+	for (const FCapsuleBroadphaseHit& CapsuleHit : CapsuleHits)
+	{
+		AFHProjectCharacter* HitCharacter = CombatSubsystem->GetCombatant(CapsuleHit.Index);
+		if (HitCharacter == nullptr || HitCharacter == OwnerCharacter)
+		{
+			continue;
+		}
+
+		if (bIsAreaShape == true)
+		{
+			//Arc Ignore Height, Sphere Radius Limit it
+			const FVector ToTarget = Shape == EAttackShape::Arc ? (CapsuleHit.Location - Origin).GetSafeNormal2D() : (CapsuleHit.Location - Origin).GetSafeNormal();
+			if (ToTarget.IsZero() == false && FVector::DotProduct(ToTarget, Direction) < MinDot)
+			{
+				continue;
+			}
+
+			//Area Target Check Own Line of Sight
+			if (GetWorld()->LineTraceTestByObjectType(Origin, CapsuleHit.Location, OccluderObjectParams, OccluderQueryParams) == true)
+			{
+				continue;
+			}
+		}
+		else if (CapsuleHit.Time > OccluderTime)
+		{
+			//Hits are Sorted by Time, every Next Capsule is behind Occluder
+			break;
+		}
+
+		Targets.Add({ HitCharacter, CapsuleHit.Location, static_cast<float>(FVector::DistSquared(CapsuleHit.Location, Origin)) });
+	}
+
+	//Area Query End is Origin, Capsule Hit Time is always 0, Distance Decide Falloff Order
+	Targets.Sort([](const FBroadphaseTarget& A, const FBroadphaseTarget& B)
+		{
+			return A.DistanceSquared < B.DistanceSquared;
+		});
+
+	TArray<AActor*> HitTargets;
+	TArray<FVector> HitLocations;
+	for (const FBroadphaseTarget& Target : Targets)
+	{
+		if (HitTargets.Num() >= TargetLimit)
+		{
+			break;
+		}
+
+		//Physics Query Return every Component, Damage One Actor Once
+		if (HitTargets.Contains(Target.Target) == true)
+		{
+			continue;
+		}
+
+		HitTargets.Add(Target.Target);
+		HitLocations.Add(Target.Location);
+	}
+
+	ApplyDamageToHitTargets(HitTargets, HitLocations, Origin, Direction, Damage);
+
+	if (bIsRangeWeapon == true && HitTargets.Num() == 0)
+	{
+		QueueImpactEvent(bIsBlocked == true ? FVector(OccluderHitResult.Location) : EndLocation, GetAttackMeshComponent()->GetComponentRotation());
+	}
+
+	UE_LOG(LogClass, Warning, TEXT("ApplyBroadphaseDamage - End"));
+
+	//Single Shape Count Occluder Hit like Trace
+	return HitTargets.Num() > 0 || (Shape == EAttackShape::Single && bIsBlocked == true);
+}
+
+void ABaseWeapon::ApplyDamageToHitTargets(const TArray<AActor*>& HitTargets, const TArray<FVector>& HitLocations, const FVector& Origin, const FVector& Direction, float Damage)
+{
+	for (int32 TargetIndex = 0; TargetIndex < HitTargets.Num(); ++TargetIndex)
+	{
+		const float DamageScale = FMath::Max(1.0f - TargetIndex * MultiHitFalloff, MinMultiHitDamageScale);
+		const FVector HitDirection = (HitLocations[TargetIndex] - Origin).GetSafeNormal();
+
+		UE_LOG(LogClass, Warning, TEXT("ApplyDamageToHitTargets::Hit Actor :: %s, DamageScale :: %f"), *HitTargets[TargetIndex]->GetName(), DamageScale);
+		ApplyDamageToHitTarget(HitTargets[TargetIndex], HitLocations[TargetIndex], HitDirection.IsZero() == true ? Direction : HitDirection, Damage * DamageScale);
+
+		//Range Weapon Impact on every Pierced Target
+		if (bIsRangeWeapon == true)
+		{
+			QueueImpactEvent(HitLocations[TargetIndex], GetAttackMeshComponent()->GetComponentRotation());
+		}
+	}
+}
+
+AActor* ABaseWeapon::GetHitTarget(const FHitResult& HitResult) const
+{
+	if (const UWeaponProxySubsystem* ProxySubsystem = GetWorld()->GetSubsystem<UWeaponProxySubsystem>())
+	{
+		if (ABaseWeapon* HitProxyWeapon = ProxySubsystem->FindHitProxy(HitResult.GetComponent(), HitResult.Item))
+		{
+			return HitProxyWeapon;
+		}
+	}
+
+	return HitResult.GetActor();
+}
+
+bool ABaseWeapon::IsDamageableTarget(const AActor* HitTargetObj)
+{
+	if (HitTargetObj == nullptr)
+	{
+		return false;
+	}
+
+	if (HitTargetObj->IsA<APawn>() == true)
+	{
+		return true;
+	}
+
+	const ABaseWeapon* HitWeapon = Cast<ABaseWeapon>(HitTargetObj);
+	return HitWeapon != nullptr && HitWeapon->IsProxied() == true;
+}
+
+void ABaseWeapon::ApplyDamageToHitTarget(AActor* HitTargetObj, const FVector& HitLocation, const FVector& HitDirection, float Damage)
+{
+	//Hit Proxy Instance, Promote to Weapon Actor and Push it
+	ABaseWeapon* HitWeapon = Cast<ABaseWeapon>(HitTargetObj);
+	UWeaponProxySubsystem* ProxySubsystem = GetWorld()->GetSubsystem<UWeaponProxySubsystem>();
+	if (HitWeapon != nullptr && HitWeapon->IsProxied() == true && ProxySubsystem != nullptr)
+	{
+		HitWeapon->SetProxied(false);
+		HitWeapon->StaticMesh->AddImpulse(HitDirection * ProxySubsystem->GetHitImpulse(), NAME_None, true);
+	}
+
+	//Region Multiplier When Target Hitbox is Active
+	float DamageMultiplier = 1.0f;
+	EHitboxRegion HitRegion = EHitboxRegion::None;
+	if (const AFHProjectCharacter* HitCharacter = Cast<AFHProjectCharacter>(HitTargetObj))
+	{
+		if (const UHitboxComponent* Hitbox = HitCharacter->GetHitboxComponent())
+		{
+			DamageMultiplier = Hitbox->ResolveDamageMultiplier(HitLocation, HitDirection, HitRegion);
+			Damage *= DamageMultiplier;
+			UE_LOG(LogClass, Warning, TEXT("ApplyDamageToHitTarget::Hit Region :: %s"), *UEnum::GetValueAsString(HitRegion));
+		}
+	}
+
+	//Consumer Read Events after Attack Path
+	if (UCombatEventSubsystem* EventSubsystem = GetWorld()->GetSubsystem<UCombatEventSubsystem>())
+	{
+		EventSubsystem->Publish(ECombatEventType::Hit, OwnerCharacter, HitTargetObj, HitLocation, DamageMultiplier, static_cast<int32>(HitRegion));
+		EventSubsystem->Publish(ECombatEventType::Damage, OwnerCharacter, HitTargetObj, HitLocation, Damage, static_cast<int32>(HitRegion));
+	}
+
+	if (ULatencyTraceSubsystem* LatencySubsystem = GetWorld()->GetSubsystem<ULatencyTraceSubsystem>())
+	{
+		LatencySubsystem->StampDamage(OwnerCharacter);
+	}
+
+	AController* InstigatorController = OwnerCharacter != nullptr ? OwnerCharacter->GetController() : nullptr;
+	UGameplayStatics::ApplyDamage(HitTargetObj, Damage, InstigatorController, this, UDamageType::StaticClass());
+}
+
+FCollisionObjectQueryParams ABaseWeapon::GetAttackObjectQueryParams()
+{
+	FCollisionObjectQueryParams QueryParams;
+	QueryParams.AddObjectTypesToQuery(ECollisionChannel::ECC_Pawn);
+	QueryParams.AddObjectTypesToQuery(ECollisionChannel::ECC_WorldStatic);
+	QueryParams.AddObjectTypesToQuery(ECollisionChannel::ECC_WorldDynamic);
+	QueryParams.AddObjectTypesToQuery(ECollisionChannel::ECC_PhysicsBody);
+	QueryParams.AddObjectTypesToQuery(ECollisionChannel::ECC_Vehicle);
+	QueryParams.AddObjectTypesToQuery(ECollisionChannel::ECC_Destructible);
+
+	return QueryParams;
+}
+
+void ABaseWeapon::OnAttackTraceResult(bool bIsHit)
+{
+	//Attack can't hit Anything
+	if (bIsHit == false)
+	{
+		//Initialize LeftClickCount 0;
+		UE_LOG(LogClass, Warning, TEXT("OnAttackTraceResult::IsHit == false, InitializeLeftClickCount"));
+		ResetLeftClickCount();
+		return;
+	}
+
+	//Check Click was Right Click
+	if (GetIsLeftClick() == false)
+	{
+		//Initialize LeftClickCount 0;
+		UE_LOG(LogClass, Warning, TEXT("OnAttackTraceResult::GetIsLeftClick == false, InitializeLeftClickCount"));
+		ResetLeftClickCount();
+	}
+}
+
+const FBakedAttackCurve* ABaseWeapon::GetBakedAttackCurve(const UAnimMontage* TargetMontage) const
+{
+	if (BakedAttackCurve.IsValidFor(TargetMontage) == true)
+	{
+		return &BakedAttackCurve;
+	}
+
+	if (BakedSpecialAttackCurve.IsValidFor(TargetMontage) == true)
+	{
+		return &BakedSpecialAttackCurve;
+	}
+
+	return nullptr;
+}
+
+void ABaseWeapon::StartBakedHitWindow(const UAnimMontage* TargetMontage)
+{
+	UE_LOG(LogClass, Warning, TEXT("StartBakedHitWindow - Start"));
+
+	//Previous Attack Window still Active, Finish it first
+	StopBakedHitWindow();
+
+	ActiveBakedCurve = GetBakedAttackCurve(TargetMontage);
+	if (ActiveBakedCurve == nullptr)
+	{
+		UE_LOG(LogClass, Warning, TEXT("StartBakedHitWindow::ActiveBakedCurve == nullptr"));
+		return;
+	}
+
+	//CombatWorldSubsystem Tick Evaluate Window, Server don't need Animation Tick for this
+	BakedWindowIndex = 0;
+	bBakedWindowOpened = false;
+	bActiveBakedWindowHit = false;
+	BakedWindowTime = 0.0f;
+
+	UE_LOG(LogClass, Warning, TEXT("StartBakedHitWindow - End"));
+}
+
+void ABaseWeapon::StopBakedHitWindow()
+{
+	if (ActiveBakedCurve == nullptr)
+	{
+		return;
+	}
+
+	//Window Opened but Montage Stopped before Hit
+	if (bBakedWindowOpened == true && bActiveBakedWindowHit == false)
+	{
+		OnAttackTraceResult(false);
+	}
+
+	ActiveBakedCurve = nullptr;
+	BakedWindowIndex = 0;
+	bBakedWindowOpened = false;
+	bActiveBakedWindowHit = false;
+}
+
+void ABaseWeapon::TickBakedHitWindow(float DeltaTime)
+{
+	//Check Weapon has OwnerCharacter
+	if (OwnerCharacter == nullptr || ActiveBakedCurve == nullptr)
+	{
+		StopBakedHitWindow();
+		return;
+	}
+
+	//Montage Interrupted
+	UAnimInstance* AnimInstance = OwnerCharacter->GetMesh()->GetAnimInstance();
+	if (AnimInstance == nullptr || AnimInstance->Montage_IsPlaying(ActiveBakedCurve->Montage) == false)
+	{
+		StopBakedHitWindow();
+		return;
+	}
+
+	//Window Time is Fixed Step Time, not Animation Tick Position
+	//Same Input give Same Hit Time on every Server Tick Rate
+	//Play Rate of Montage_Play and Montage_SetPlayRate, Asset Rate Scale is Applied on Top of it
+	const float PlayRate = AnimInstance->Montage_GetPlayRate(ActiveBakedCurve->Montage) * ActiveBakedCurve->Montage->RateScale;
+	const float PreviousPosition = BakedWindowTime;
+	BakedWindowTime += DeltaTime * PlayRate;
+	const float MontagePosition = BakedWindowTime;
+	const FTransform MeshTransform = OwnerCharacter->GetMesh()->GetComponentTransform();
+	const float Damage = GetCurrentAttackDamage();
+
+	while (ActiveBakedCurve->Windows.IsValidIndex(BakedWindowIndex) == true)
+	{
+		const FBakedAttackWindow& Window = ActiveBakedCurve->Windows[BakedWindowIndex];
+
+		//Window not Started
+		if (MontagePosition < Window.StartTime)
+		{
+			break;
+		}
+
+		//Sub Step from Last Tick to Now at Baked Sample Rate, Clamped in Window
+		//Window Shorter than One Frame and Fast Swing between Ticks are still Traced
+		const float StepStart = FMath::Max(PreviousPosition, Window.StartTime);
+		const float StepEnd = FMath::Min(MontagePosition, Window.EndTime);
+		const float StepInterval = Window.SampleInterval > UE_KINDA_SMALL_NUMBER ? Window.SampleInterval : FMath::Max(StepEnd - StepStart, UE_KINDA_SMALL_NUMBER);
+
+		//First Tick in Window Sample Start Too, Later Ticks Continue after Last Sample
+		float SampleTime = bBakedWindowOpened == false ? StepStart : FMath::Min(StepStart + StepInterval, StepEnd);
+		bBakedWindowOpened = true;
+
+		//Trace Socket Path until Window hit Anything
+		while (bActiveBakedWindowHit == false)
+		{
+			FVector AttackStartLocation;
+			FVector AttackEndLocation;
+			Window.Sample(SampleTime, AttackStartLocation, AttackEndLocation);
+
+			bActiveBakedWindowHit = ApplyDamageToTargetActor(MeshTransform.TransformPosition(AttackStartLocation), MeshTransform.TransformPosition(AttackEndLocation), Damage);
+
+			if (bActiveBakedWindowHit == true)
+			{
+				OnAttackTraceResult(true);
+			}
+
+			if (SampleTime >= StepEnd)
+			{
+				break;
+			}
+
+			SampleTime = FMath::Min(SampleTime + StepInterval, StepEnd);
+		}
+
+		//Window still Open
+		if (MontagePosition < Window.EndTime)
+		{
+			break;
+		}
+
+		//Window Closed without Hit
+		if (bActiveBakedWindowHit == false)
+		{
+			OnAttackTraceResult(false);
+		}
+
+		BakedWindowIndex += 1;
+		bBakedWindowOpened = false;
+		bActiveBakedWindowHit = false;
+	}
+
+	//Every Window Evaluated
+	if (ActiveBakedCurve->Windows.IsValidIndex(BakedWindowIndex) == false)
+	{
+		StopBakedHitWindow();
+	}
+}
+
+#if WITH_EDITOR
+void ABaseWeapon::BakeAttackHitWindows()
+{
+	UE_LOG(LogClass, Warning, TEXT("BakeAttackHitWindows - Start"));
+
+	Modify();
+	BakeAttackCurves();
+
+	UE_LOG(LogClass, Warning, TEXT("BakeAttackHitWindows - End"));
+}
+
+void ABaseWeapon::BakeAttackCurves()
+{
+	UStaticMesh* WeaponMesh = StaticMesh != nullptr ? StaticMesh->GetStaticMesh() : nullptr;
+	const float SampleRate = FMath::Max(BakedHitSampleRate, 1.0f);
+
+	BakedAttackCurve.Bake(AttackMontage, BakeCharacterMesh, BakeCharacterSocketName, WeaponMesh, AttackStartSocketName, AttackEndSocketName, SampleRate);
+	BakedSpecialAttackCurve.Bake(SpecialAttackMontage, BakeCharacterMesh, BakeCharacterSocketName, WeaponMesh, AttackStartSocketName, AttackEndSocketName, SampleRate);
+}
+
+void ABaseWeapon::PreSave(FObjectPreSaveContext ObjectSaveContext)
+{
+	Super::PreSave(ObjectSaveContext);
+
+	//Bake again When Cooking, Montage or Socket may be Changed after Last Bake
+	if (ObjectSaveContext.IsCooking() == true && BakeCharacterMesh != nullptr)
+	{
+		BakeAttackCurves();
+	}
 }
+#endif
@@ -0,0 +1,141 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "CapsuleBroadphase.h"
+#include "Math/VectorRegister.h"
+
+
+void FCapsuleBroadphase::Reset(int32 NewCount)
+{
+	Count = NewCount;
+
+	//Padding Lane is Zero, Masked When Query
+	const int32 PaddedCount = Align(NewCount, 4);
+	AxisX.SetNumZeroed(PaddedCount);
+	AxisY.SetNumZeroed(PaddedCount);
+	AxisZMin.SetNumZeroed(PaddedCount);
+	AxisLength.SetNumZeroed(PaddedCount);
+	Radii.SetNumZeroed(PaddedCount);
+}
+
+void FCapsuleBroadphase::SetCapsule(int32 Index, const FVector& Center, float HalfHeight, float Radius)
+{
+	//Half Height include Radius, Axis Segment is between Hemisphere Centers
+	const float AxisHalfLength = FMath::Max(HalfHeight - Radius, 0.0f);
+
+	AxisX[Index] = Center.X;
+	AxisY[Index] = Center.Y;
+	AxisZMin[Index] = Center.Z - AxisHalfLength;
+	AxisLength[Index] = AxisHalfLength * 2.0f;
+	Radii[Index] = Radius;
+}
+
+void FCapsuleBroadphase::Query(const FVector& Start, const FVector& End, float QueryRadius, TArray<FCapsuleBroadphaseHit>& OutHits) const
+{
+	OutHits.Reset();
+
+	if (Count == 0)
+	{
+		return;
+	}
+
+	//Closest Points of Two Segments (Ericson), Query Segment P1 + D1 * S, Capsule Axis P2 + D2 * T
+	//Capsule Axis is Z, D2 = (0, 0, Length)
+	const FVector3f P1 = FVector3f(Start);
+	const FVector3f D1 = FVector3f(End - Start);
+	const float A = D1.SizeSquared();
+
+	const VectorRegister4Float P1X = VectorSetFloat1(P1.X);
+	const VectorRegister4Float P1Y = VectorSetFloat1(P1.Y);
+	const VectorRegister4Float P1Z = VectorSetFloat1(P1.Z);
+	const VectorRegister4Float D1X = VectorSetFloat1(D1.X);
+	const VectorRegister4Float D1Y = VectorSetFloat1(D1.Y);
+	const VectorRegister4Float D1Z = VectorSetFloat1(D1.Z);
+	const VectorRegister4Float VecA = VectorSetFloat1(A);
+	const VectorRegister4Float SafeA = VectorSetFloat1(FMath::Max(A, UE_SMALL_NUMBER));
+	const VectorRegister4Float VecQueryRadius = VectorSetFloat1(QueryRadius);
+	const VectorRegister4Float Zero = VectorZeroFloat();
+	const VectorRegister4Float One = VectorOneFloat();
+	const VectorRegister4Float Epsilon = VectorSetFloat1(UE_SMALL_NUMBER);
+
+	for (int32 Base = 0; Base < Count; Base += 4)
+	{
+		const VectorRegister4Float CapsuleX = VectorLoad(&AxisX[Base]);
+		const VectorRegister4Float CapsuleY = VectorLoad(&AxisY[Base]);
+		const VectorRegister4Float CapsuleZ = VectorLoad(&AxisZMin[Base]);
+		const VectorRegister4Float Length = VectorLoad(&AxisLength[Base]);
+		const VectorRegister4Float Radius = VectorLoad(&Radii[Base]);
+
+		//R = P1 - P2
+		const VectorRegister4Float RX = VectorSubtract(P1X, CapsuleX);
+		const VectorRegister4Float RY = VectorSubtract(P1Y, CapsuleY);
+		const VectorRegister4Float RZ = VectorSubtract(P1Z, CapsuleZ);
+
+		//E = D2.D2, F = D2.R, C = D1.R, B = D1.D2
+		const VectorRegister4Float E = VectorMultiply(Length, Length);
+		const VectorRegister4Float F = VectorMultiply(Length, RZ);
+		const VectorRegister4Float C = VectorMultiplyAdd(D1X, RX, VectorMultiplyAdd(D1Y, RY, VectorMultiply(D1Z, RZ)));
+		const VectorRegister4Float B = VectorMultiply(D1Z, Length);
+
+		//Parallel or Degenerate Segment, S = 0
+		const VectorRegister4Float Denom = VectorSubtract(VectorMultiply(VecA, E), VectorMultiply(B, B));
+		const VectorRegister4Float SafeDenom = VectorMax(Denom, Epsilon);
+		const VectorRegister4Float SGeneral = VectorMin(VectorMax(VectorDivide(VectorSubtract(VectorMultiply(B, F), VectorMultiply(C, E)), SafeDenom), Zero), One);
+		VectorRegister4Float S = VectorSelect(VectorCompareGT(Denom, Epsilon), SGeneral, Zero);
+
+		//Capsule is Sphere, T = 0
+		const VectorRegister4Float SafeE = VectorMax(E, Epsilon);
+		VectorRegister4Float T = VectorSelect(VectorCompareGT(E, Epsilon), VectorDivide(VectorMultiplyAdd(B, S, F), SafeE), Zero);
+
+		//T out of Axis, Clamp T and Recompute S
+		const VectorRegister4Float SLow = VectorMin(VectorMax(VectorDivide(VectorNegate(C), SafeA), Zero), One);
+		const VectorRegister4Float SHigh = VectorMin(VectorMax(VectorDivide(VectorSubtract(B, C), SafeA), Zero), One);
+		S = VectorSelect(VectorCompareLT(T, Zero), SLow, VectorSelect(VectorCompareGT(T, One), SHigh, S));
+		T = VectorMin(VectorMax(T, Zero), One);
+
+		//Capsule is Sphere, Nearest Point of Query Segment to Sphere Center
+		S = VectorSelect(VectorCompareGT(E, Epsilon), S, SLow);
+
+		//Distance between Closest Points
+		const VectorRegister4Float DX = VectorMultiplyAdd(D1X, S, RX);
+		const VectorRegister4Float DY = VectorMultiplyAdd(D1Y, S, RY);
+		const VectorRegister4Float DZ = VectorSubtract(VectorMultiplyAdd(D1Z, S, RZ), VectorMultiply(Length, T));
+		const VectorRegister4Float DistanceSquared = VectorMultiplyAdd(DX, DX, VectorMultiplyAdd(DY, DY, VectorMultiply(DZ, DZ)));
+
+		const VectorRegister4Float HitRadius = VectorAdd(Radius, VecQueryRadius);
+		int32 HitMask = VectorMaskBits(VectorCompareLE(DistanceSquared, VectorMultiply(HitRadius, HitRadius)));
+
+		//Mask Padding Lane
+		const int32 LaneCount = FMath::Min(Count - Base, 4);
+		HitMask &= (1 << LaneCount) - 1;
+		if (HitMask == 0)
+		{
+			continue;
+		}
+
+		//Hit is Rare, Build Result in Scalar
+		float SLanes[4];
+		float TLanes[4];
+		VectorStore(S, SLanes);
+		VectorStore(T, TLanes);
+
+		for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+		{
+			if ((HitMask & (1 << Lane)) == 0)
+			{
+				continue;
+			}
+
+			const int32 Index = Base + Lane;
+			const FVector QueryPoint = Start + (End - Start) * SLanes[Lane];
+			const FVector AxisPoint(AxisX[Index], AxisY[Index], AxisZMin[Index] + AxisLength[Index] * TLanes[Lane]);
+
+			FCapsuleBroadphaseHit& Hit = OutHits.AddDefaulted_GetRef();
+			Hit.Index = Index;
+			Hit.Time = SLanes[Lane];
+			Hit.Location = AxisPoint + (QueryPoint - AxisPoint).GetSafeNormal() * Radii[Index];
+		}
+	}
+
+	OutHits.Sort([](const FCapsuleBroadphaseHit& HitA, const FCapsuleBroadphaseHit& HitB) { return HitA.Time < HitB.Time; });
+}
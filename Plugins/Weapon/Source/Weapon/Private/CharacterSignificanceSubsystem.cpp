@@ -0,0 +1,311 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "CharacterSignificanceSubsystem.h"
+#include "FHProjectCharacter.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Animation/AnimInstance.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/World.h"
+
+
+UCharacterSignificanceSubsystem::UCharacterSignificanceSubsystem()
+{
+	UpdateElapsedTime = 0.0f;
+
+	//Default Value, Override in DefaultGame.ini
+	UpdateInterval = 0.1f;
+
+	HighDistance = 1500.0f;
+	MediumDistance = 4000.0f;
+	CullDistance = 10000.0f;
+
+	NotRenderedScoreScale = 0.25f;
+	CombatScoreBonus = 0.5f;
+
+	MaxHighTierCount = 12;
+	MaxMediumTierCount = 24;
+
+	MediumAnimTickInterval = 1.0f / 30.0f;
+	LowAnimTickInterval = 1.0f / 10.0f;
+	CulledAnimTickInterval = 0.5f;
+
+	bEnableAnimationSharing = false;
+}
+
+bool UCharacterSignificanceSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UCharacterSignificanceSubsystem::Deinitialize()
+{
+	Characters.Reset();
+
+	Super::Deinitialize();
+}
+
+void UCharacterSignificanceSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	//Significance Update is not every Frame
+	UpdateElapsedTime += DeltaTime;
+	if (UpdateElapsedTime < UpdateInterval)
+	{
+		return;
+	}
+
+	UpdateElapsedTime = 0.0f;
+	UpdateSignificance();
+}
+
+TStatId UCharacterSignificanceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCharacterSignificanceSubsystem, STATGROUP_Tickables);
+}
+
+void UCharacterSignificanceSubsystem::RegisterCharacter(AFHProjectCharacter* Character)
+{
+	if (IsValid(Character) == false || FindIndex(Character) != INDEX_NONE)
+	{
+		return;
+	}
+
+	FCharacterSignificance& Significance = Characters.AddDefaulted_GetRef();
+	Significance.Character = Character;
+	Significance.DefaultAnimTickOption = Character->GetMesh()->VisibilityBasedAnimTickOption;
+}
+
+void UCharacterSignificanceSubsystem::UnregisterCharacter(AFHProjectCharacter* Character)
+{
+	const int32 Index = FindIndex(Character);
+	if (Index == INDEX_NONE)
+	{
+		return;
+	}
+
+	//Followers of this Character find New Leader Next Update
+	Characters.RemoveAtSwap(Index);
+}
+
+ESignificanceTier UCharacterSignificanceSubsystem::GetTier(const AActor* Character) const
+{
+	const int32 Index = FindIndex(Character);
+	if (Index == INDEX_NONE)
+	{
+		return ESignificanceTier::High;
+	}
+
+	return Characters[Index].Tier;
+}
+
+bool UCharacterSignificanceSubsystem::ShouldSpawnCosmetics(const AActor* Character) const
+{
+	const ESignificanceTier Tier = GetTier(Character);
+
+	return Tier == ESignificanceTier::High || Tier == ESignificanceTier::Medium;
+}
+
+void UCharacterSignificanceSubsystem::UpdateSignificance()
+{
+	//Significance need Local Viewer, Dedicated Server has not
+	APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+	if (PlayerController == nullptr || PlayerController->IsLocalController() == false)
+	{
+		return;
+	}
+
+	FVector ViewLocation;
+	FRotator ViewRotation;
+	PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+	//Remove Destroyed Character
+	Characters.RemoveAllSwap([](const FCharacterSignificance& Significance) { return Significance.Character.IsValid() == false; });
+
+	//Calculate Score and Tier by Distance
+	for (FCharacterSignificance& Significance : Characters)
+	{
+		float Distance = 0.0f;
+		Significance.Score = CalculateScore(Significance.Character.Get(), ViewLocation, Distance);
+
+		if (Distance <= HighDistance)
+		{
+			Significance.Tier = ESignificanceTier::High;
+		}
+		else if (Distance <= MediumDistance)
+		{
+			Significance.Tier = ESignificanceTier::Medium;
+		}
+		else if (Distance <= CullDistance)
+		{
+			Significance.Tier = ESignificanceTier::Low;
+		}
+		else
+		{
+			Significance.Tier = ESignificanceTier::Culled;
+		}
+	}
+
+	//Bigger Score First, then Demote Character over Tier Count
+	Characters.Sort([](const FCharacterSignificance& A, const FCharacterSignificance& B) { return A.Score > B.Score; });
+
+	int32 HighCount = 0;
+	int32 MediumCount = 0;
+
+	for (FCharacterSignificance& Significance : Characters)
+	{
+		if (Significance.Tier == ESignificanceTier::High)
+		{
+			if (HighCount < MaxHighTierCount)
+			{
+				HighCount += 1;
+			}
+			else
+			{
+				Significance.Tier = ESignificanceTier::Medium;
+			}
+		}
+
+		if (Significance.Tier == ESignificanceTier::Medium)
+		{
+			if (MediumCount < MaxMediumTierCount)
+			{
+				MediumCount += 1;
+			}
+			else
+			{
+				Significance.Tier = ESignificanceTier::Low;
+			}
+		}
+
+		ApplyTier(Significance);
+	}
+
+	if (bEnableAnimationSharing == true)
+	{
+		UpdateAnimationSharing();
+	}
+}
+
+float UCharacterSignificanceSubsystem::CalculateScore(const AFHProjectCharacter* Character, const FVector& ViewLocation, float& OutDistance) const
+{
+	OutDistance = FVector::Dist(Character->GetActorLocation(), ViewLocation);
+
+	//Local Player Character always most Significant
+	//Server NPC is Locally Controlled by AI Controller, not Player
+	if (Character->IsLocallyControlled() == true && Character->IsPlayerControlled() == true)
+	{
+		OutDistance = 0.0f;
+		return TNumericLimits<float>::Max();
+	}
+
+	float Score = 1.0f - FMath::Clamp(OutDistance / CullDistance, 0.0f, 1.0f);
+
+	//Not Rendered Character is less Significant
+	if (Character->WasRecentlyRendered(0.2f) == false)
+	{
+		Score *= NotRenderedScoreScale;
+	}
+
+	//Character in Combat is more Significant
+	const UAnimInstance* AnimInstance = Character->GetMesh()->GetAnimInstance();
+	if (AnimInstance != nullptr && AnimInstance->IsAnyMontagePlaying() == true)
+	{
+		Score += CombatScoreBonus;
+	}
+
+	return Score;
+}
+
+void UCharacterSignificanceSubsystem::ApplyTier(FCharacterSignificance& Significance)
+{
+	if (Significance.Tier == Significance.AppliedTier)
+	{
+		return;
+	}
+
+	AFHProjectCharacter* Character = Significance.Character.Get();
+	USkeletalMeshComponent* CharacterMesh = Character->GetMesh();
+
+	switch (Significance.Tier)
+	{
+	case ESignificanceTier::High:
+	{
+		CharacterMesh->bEnableUpdateRateOptimizations = false;
+		CharacterMesh->VisibilityBasedAnimTickOption = Significance.DefaultAnimTickOption;
+		CharacterMesh->SetComponentTickInterval(0.0f);
+		break;
+	}
+	case ESignificanceTier::Medium:
+	{
+		//Engine Update Rate Optimization skip Frames by Screen Size
+		CharacterMesh->bEnableUpdateRateOptimizations = true;
+		CharacterMesh->VisibilityBasedAnimTickOption = Significance.DefaultAnimTickOption;
+		CharacterMesh->SetComponentTickInterval(MediumAnimTickInterval);
+		break;
+	}
+	case ESignificanceTier::Low:
+	{
+		CharacterMesh->bEnableUpdateRateOptimizations = true;
+		CharacterMesh->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::OnlyTickMontagesWhenNotRendered;
+		CharacterMesh->SetComponentTickInterval(LowAnimTickInterval);
+		break;
+	}
+	case ESignificanceTier::Culled:
+	{
+		CharacterMesh->bEnableUpdateRateOptimizations = true;
+		CharacterMesh->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::OnlyTickMontagesWhenNotRendered;
+		CharacterMesh->SetComponentTickInterval(CulledAnimTickInterval);
+		break;
+	}
+	}
+
+	//Culled Character's Weapon don't need Render
+	if (UStaticMeshComponent* EquipWeaponMesh = Character->GetEquipWeaponMesh())
+	{
+		EquipWeaponMesh->SetVisibility(Significance.Tier != ESignificanceTier::Culled);
+	}
+
+	Significance.AppliedTier = Significance.Tier;
+}
+
+void UCharacterSignificanceSubsystem::UpdateAnimationSharing()
+{
+	//Skeletal Mesh Asset -> Leader Mesh
+	TMap<const USkeletalMesh*, USkinnedMeshComponent*> LeaderMap;
+
+	//Characters are Sorted by Score, First Low Character become Leader
+	for (FCharacterSignificance& Significance : Characters)
+	{
+		USkeletalMeshComponent* CharacterMesh = Significance.Character->GetMesh();
+		USkinnedMeshComponent* NewLeader = nullptr;
+
+		const bool bCanShare = Significance.Tier == ESignificanceTier::Low || Significance.Tier == ESignificanceTier::Culled;
+		if (bCanShare == true && CharacterMesh->GetSkeletalMeshAsset() != nullptr)
+		{
+			USkinnedMeshComponent*& Leader = LeaderMap.FindOrAdd(CharacterMesh->GetSkeletalMeshAsset());
+			if (Leader == nullptr)
+			{
+				//This Character is Leader
+				Leader = CharacterMesh;
+			}
+			else
+			{
+				NewLeader = Leader;
+			}
+		}
+
+		if (Significance.LeaderPoseComponent.Get() != NewLeader)
+		{
+			CharacterMesh->SetLeaderPoseComponent(NewLeader);
+			Significance.LeaderPoseComponent = NewLeader;
+		}
+	}
+}
+
+int32 UCharacterSignificanceSubsystem::FindIndex(const AActor* Character) const
+{
+	return Characters.IndexOfByPredicate([Character](const FCharacterSignificance& Significance) { return Significance.Character.Get() == Character; });
+}
@@ -0,0 +1,222 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "CombatEventSubsystem.h"
+#include "Tasks/Task.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+
+//Console Command
+static FAutoConsoleCommandWithWorld CombatEventsReportCommand(
+	TEXT("Weapon.CombatEvents.Report"),
+	TEXT("Print Combat Event Count per Type"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const UCombatEventSubsystem* EventSubsystem = World != nullptr ? World->GetSubsystem<UCombatEventSubsystem>() : nullptr)
+		{
+			EventSubsystem->Report();
+		}
+	}));
+
+
+UCombatEventSubsystem::UCombatEventSubsystem()
+{
+	//Default Value, Override in DefaultGame.ini
+	bEnableEventStats = false;
+	MaxEventsPerDrain = 4096;
+
+	NextConsumerId = 1;
+	StatsConsumerId = INDEX_NONE;
+	bHasConsumers = false;
+}
+
+bool UCombatEventSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UCombatEventSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	EventStats = MakeShared<FCombatEventStats, ESPMode::ThreadSafe>();
+
+	if (bEnableEventStats == true)
+	{
+		//Telemetry Example, Count on Worker, Attack Path only Enqueue
+		StatsConsumerId = AddWorkerConsumer([Stats = EventStats](const TArray<FCombatEvent>& Events)
+		{
+			for (const FCombatEvent& Event : Events)
+			{
+				Stats->Counts[static_cast<int32>(Event.Type)].fetch_add(1, std::memory_order_relaxed);
+			}
+		});
+	}
+}
+
+void UCombatEventSubsystem::Deinitialize()
+{
+	//Last Events of Match
+	DrainEvents();
+
+	OnCombatEvent.Clear();
+	WorkerConsumers.Reset();
+	UpdateHasConsumers();
+
+	Super::Deinitialize();
+}
+
+void UCombatEventSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	DrainEvents();
+}
+
+TStatId UCombatEventSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatEventSubsystem, STATGROUP_Tickables);
+}
+
+void UCombatEventSubsystem::Publish(ECombatEventType Type, const AActor* Instigator, const AActor* Target, const FVector& Location, float Value, int32 Count)
+{
+	//No Consumer, No Allocation
+	if (bHasConsumers.load(std::memory_order_relaxed) == false)
+	{
+		return;
+	}
+
+	FCombatEvent Event;
+	Event.Type = Type;
+	//World is Game Thread Only, Other Thread's Event is Stamped in Drain
+	Event.Time = IsInGameThread() == true ? GetWorld()->GetTimeSeconds() : -1.0;
+	Event.Instigator = Instigator;
+	Event.Target = Target;
+	Event.InstigatorId = Instigator != nullptr ? Instigator->GetUniqueID() : 0;
+	Event.TargetId = Target != nullptr ? Target->GetUniqueID() : 0;
+	Event.Location = FVector3f(Location);
+	Event.Value = Value;
+	Event.Count = Count;
+
+	EventQueue.Enqueue(MoveTemp(Event));
+}
+
+FDelegateHandle UCombatEventSubsystem::AddListener(FOnCombatEvent::FDelegate&& Listener)
+{
+	const FDelegateHandle Handle = OnCombatEvent.Add(MoveTemp(Listener));
+	UpdateHasConsumers();
+
+	return Handle;
+}
+
+void UCombatEventSubsystem::RemoveListener(FDelegateHandle Handle)
+{
+	OnCombatEvent.Remove(Handle);
+	UpdateHasConsumers();
+}
+
+int32 UCombatEventSubsystem::AddWorkerConsumer(FCombatEventBatchHandler&& Handler)
+{
+	const int32 ConsumerId = NextConsumerId++;
+	FCombatEventWorkerConsumer& Consumer = WorkerConsumers.Add(ConsumerId);
+	Consumer.Handler = MakeShared<FCombatEventBatchHandler, ESPMode::ThreadSafe>(MoveTemp(Handler));
+	UpdateHasConsumers();
+
+	return ConsumerId;
+}
+
+void UCombatEventSubsystem::RemoveWorkerConsumer(int32 ConsumerId)
+{
+	WorkerConsumers.Remove(ConsumerId);
+	UpdateHasConsumers();
+}
+
+void UCombatEventSubsystem::UpdateHasConsumers()
+{
+	bHasConsumers = OnCombatEvent.IsBound() == true || WorkerConsumers.Num() > 0;
+}
+
+void UCombatEventSubsystem::DrainEvents()
+{
+	if (EventQueue.IsEmpty() == true)
+	{
+		return;
+	}
+
+	//Batch is Shared by every Worker Task, Freed When Last Task End
+	TSharedRef<TArray<FCombatEvent>, ESPMode::ThreadSafe> Batch = MakeShared<TArray<FCombatEvent>, ESPMode::ThreadSafe>();
+
+	const double DrainTime = GetWorld()->GetTimeSeconds();
+
+	FCombatEvent Event;
+	while (Batch->Num() < MaxEventsPerDrain && EventQueue.Dequeue(Event) == true)
+	{
+		if (Event.Time < 0.0)
+		{
+			Event.Time = DrainTime;
+		}
+
+		Batch->Add(MoveTemp(Event));
+	}
+
+	//Game Thread Listener, UI and Audio
+	if (OnCombatEvent.IsBound() == true)
+	{
+		for (const FCombatEvent& BatchEvent : *Batch)
+		{
+			OnCombatEvent.Broadcast(BatchEvent);
+		}
+	}
+
+	//Worker Consumer, Logging and Telemetry
+	//Each Batch Wait Previous Batch of Same Consumer, In Order and never Concurrent with Itself
+	for (TPair<int32, FCombatEventWorkerConsumer>& Consumer : WorkerConsumers)
+	{
+		FCombatEventWorkerConsumer& WorkerConsumer = Consumer.Value;
+		auto RunBatch = [Handler = WorkerConsumer.Handler, Batch]()
+		{
+			(*Handler)(*Batch);
+		};
+
+		if (WorkerConsumer.LastTask.IsValid() == true)
+		{
+			WorkerConsumer.LastTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, MoveTemp(RunBatch), UE::Tasks::Prerequisites(WorkerConsumer.LastTask));
+		}
+		else
+		{
+			WorkerConsumer.LastTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, MoveTemp(RunBatch));
+		}
+	}
+}
+
+void UCombatEventSubsystem::Report() const
+{
+	UE_LOG(LogClass, Warning, TEXT("CombatEvents::Report :: Listener %s, Worker Consumer %d"), OnCombatEvent.IsBound() == true ? TEXT("true") : TEXT("false"), WorkerConsumers.Num());
+
+	for (int32 TypeIndex = 0; TypeIndex < static_cast<int32>(ECombatEventType::Count); ++TypeIndex)
+	{
+		UE_LOG(LogClass, Warning, TEXT("CombatEvents::%-8s %lld"), GetEventTypeName(static_cast<ECombatEventType>(TypeIndex)), EventStats.IsValid() == true ? EventStats->Counts[TypeIndex].load() : 0);
+	}
+}
+
+const TCHAR* UCombatEventSubsystem::GetEventTypeName(ECombatEventType Type)
+{
+	switch (Type)
+	{
+	case ECombatEventType::Hit:
+		return TEXT("Hit");
+	case ECombatEventType::Damage:
+		return TEXT("Damage");
+	case ECombatEventType::Equip:
+		return TEXT("Equip");
+	case ECombatEventType::Drop:
+		return TEXT("Drop");
+	case ECombatEventType::Combo:
+		return TEXT("Combo");
+	case ECombatEventType::Roll:
+		return TEXT("Roll");
+	default:
+		return TEXT("Unknown");
+	}
+}
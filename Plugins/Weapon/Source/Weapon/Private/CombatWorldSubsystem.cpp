@@ -0,0 +1,530 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "CombatWorldSubsystem.h"
+#include "FHProjectCharacter.h"
+#include "BaseWeapon.h"
+#include "ProjectileSubsystem.h"
+#include "HitboxComponent.h"
+#include "CombatEventSubsystem.h"
+#include "Engine/World.h"
+#include "Components/CapsuleComponent.h"
+
+
+UCombatWorldSubsystem::UCombatWorldSubsystem()
+{
+	//Default Value, Override in DefaultGame.ini
+	FixedStepRate = 60.0f;
+	MaxStepsPerFrame = 8;
+	bUseCapsuleBroadphase = false;
+	HitboxActivationRadius = 500.0f;
+	CancelWindowRatio = 0.3f;
+	InputBufferTime = 0.4f;
+
+	FixedDeltaTime = 1.0f / FixedStepRate;
+	Accumulator = 0.0;
+	SimulationFrame = 0;
+	InterpolationAlpha = 0.0f;
+}
+
+bool UCombatWorldSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UCombatWorldSubsystem::Deinitialize()
+{
+	for (AFHProjectCharacter* Character : Combatants)
+	{
+		if (IsValid(Character) == true)
+		{
+			Character->SetCombatantIndex(INDEX_NONE);
+		}
+	}
+
+	Combatants.Reset();
+	EquippedWeapons.Reset();
+	Archetypes.Reset();
+	ComboCounts.Reset();
+	AttackPhases.Reset();
+	AttackPhaseRemainingTimes.Reset();
+	CancelWindowTimes.Reset();
+	BufferedAttacks.Reset();
+	BufferedAttackRemainingTimes.Reset();
+	Cooldowns.Reset();
+	Broadphase.Reset(0);
+
+	Super::Deinitialize();
+}
+
+void UCombatWorldSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	//Input is Sampled every Frame
+	TickInputCommands();
+
+	//Capsules Moved in this Frame
+	UpdateBroadphase();
+
+	//Bones Evaluated in this Frame, Before Fixed Step Resolve Hit
+	if (GetWorld()->GetNetMode() != NM_Client)
+	{
+		TickHitboxes();
+	}
+
+	//Config is Loaded after Constructor
+	FixedDeltaTime = 1.0f / FMath::Max(FixedStepRate, 1.0f);
+
+	//Run Fixed Steps for Elapsed Time
+	Accumulator += DeltaTime;
+
+	int32 StepCount = 0;
+	while (Accumulator >= FixedDeltaTime && StepCount < MaxStepsPerFrame)
+	{
+		FixedStep(FixedDeltaTime);
+
+		Accumulator -= FixedDeltaTime;
+		SimulationFrame += 1;
+		StepCount += 1;
+	}
+
+	//Long Hitch, Drop Time can't Simulate in this Frame
+	if (Accumulator >= FixedDeltaTime)
+	{
+		UE_LOG(LogClass, Warning, TEXT("CombatWorldSubsystem::Tick Drop Time :: %f"), Accumulator - FixedDeltaTime);
+		Accumulator = FMath::Fmod(Accumulator, static_cast<double>(FixedDeltaTime));
+	}
+
+	InterpolationAlpha = static_cast<float>(Accumulator / FixedDeltaTime);
+
+	//Sweep Projectile Path Moved in this Frame
+	if (UProjectileSubsystem* ProjectileSubsystem = GetWorld()->GetSubsystem<UProjectileSubsystem>())
+	{
+		ProjectileSubsystem->EndFrame(InterpolationAlpha);
+	}
+
+	//Server Only, Replicated Rotation is not Combat Logic
+	if (GetWorld()->GetNetMode() != NM_Client)
+	{
+		TickPlayerRotations();
+	}
+}
+
+void UCombatWorldSubsystem::FixedStep(float StepDeltaTime)
+{
+	TickCooldowns(StepDeltaTime);
+	TickAttackPhases(StepDeltaTime);
+	TickAttackBuffers(StepDeltaTime);
+
+	//Server and Client Step Same Ballistic Path
+	if (UProjectileSubsystem* ProjectileSubsystem = GetWorld()->GetSubsystem<UProjectileSubsystem>())
+	{
+		ProjectileSubsystem->FixedStep(StepDeltaTime);
+	}
+
+	//Server Only
+	if (GetWorld()->GetNetMode() != NM_Client)
+	{
+		TickBakedHitWindows(StepDeltaTime);
+	}
+}
+
+TStatId UCombatWorldSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatWorldSubsystem, STATGROUP_Tickables);
+}
+
+void UCombatWorldSubsystem::RegisterCombatant(AFHProjectCharacter* Character)
+{
+	if (IsValid(Character) == false || IsRegistered(Character) == true)
+	{
+		return;
+	}
+
+	Character->SetCombatantIndex(Combatants.Num());
+
+	Combatants.Add(Character);
+	EquippedWeapons.Add(nullptr);
+	Archetypes.Add(EItemType::TestWeapon);
+	ComboCounts.Add(0);
+	AttackPhases.Add(EAttackPhase::None);
+	AttackPhaseRemainingTimes.Add(0.0f);
+	CancelWindowTimes.Add(0.0f);
+	BufferedAttacks.Add(EAttackPhase::None);
+	BufferedAttackRemainingTimes.Add(0.0f);
+	Cooldowns.Add(0.0f);
+
+	UpdateBroadphase();
+}
+
+void UCombatWorldSubsystem::UnregisterCombatant(AFHProjectCharacter* Character)
+{
+	if (IsRegistered(Character) == false)
+	{
+		return;
+	}
+
+	//Swap Remove, Last Combatant Move to Removed Index
+	const int32 Index = Character->GetCombatantIndex();
+
+	Combatants.RemoveAtSwap(Index);
+	EquippedWeapons.RemoveAtSwap(Index);
+	Archetypes.RemoveAtSwap(Index);
+	ComboCounts.RemoveAtSwap(Index);
+	AttackPhases.RemoveAtSwap(Index);
+	AttackPhaseRemainingTimes.RemoveAtSwap(Index);
+	CancelWindowTimes.RemoveAtSwap(Index);
+	BufferedAttacks.RemoveAtSwap(Index);
+	BufferedAttackRemainingTimes.RemoveAtSwap(Index);
+	Cooldowns.RemoveAtSwap(Index);
+
+	if (Combatants.IsValidIndex(Index) == true)
+	{
+		Combatants[Index]->SetCombatantIndex(Index);
+	}
+
+	Character->SetCombatantIndex(INDEX_NONE);
+
+	//Capsule Index must Match Swapped Combatant Index
+	UpdateBroadphase();
+}
+
+void UCombatWorldSubsystem::SetEquippedWeapon(AFHProjectCharacter* Character, ABaseWeapon* Weapon)
+{
+	if (IsRegistered(Character) == false)
+	{
+		return;
+	}
+
+	const int32 Index = Character->GetCombatantIndex();
+	EquippedWeapons[Index] = Weapon;
+
+	if (Weapon != nullptr)
+	{
+		Archetypes[Index] = Weapon->eWeaponType;
+	}
+}
+
+int32 UCombatWorldSubsystem::GetComboCount(const AFHProjectCharacter* Character) const
+{
+	if (IsRegistered(Character) == false)
+	{
+		return 0;
+	}
+
+	return ComboCounts[Character->GetCombatantIndex()];
+}
+
+int32 UCombatWorldSubsystem::AddComboCount(AFHProjectCharacter* Character)
+{
+	if (IsRegistered(Character) == false)
+	{
+		return 0;
+	}
+
+	const int32 NewCount = ++ComboCounts[Character->GetCombatantIndex()];
+
+	if (UCombatEventSubsystem* EventSubsystem = GetWorld()->GetSubsystem<UCombatEventSubsystem>())
+	{
+		EventSubsystem->Publish(ECombatEventType::Combo, Character, nullptr, FVector::ZeroVector, 0.0f, NewCount);
+	}
+
+	return NewCount;
+}
+
+void UCombatWorldSubsystem::ResetComboCount(AFHProjectCharacter* Character)
+{
+	if (IsRegistered(Character) == false)
+	{
+		return;
+	}
+
+	ComboCounts[Character->GetCombatantIndex()] = 0;
+
+	if (UCombatEventSubsystem* EventSubsystem = GetWorld()->GetSubsystem<UCombatEventSubsystem>())
+	{
+		EventSubsystem->Publish(ECombatEventType::Combo, Character, nullptr, FVector::ZeroVector, 0.0f, 0);
+	}
+}
+
+void UCombatWorldSubsystem::SetComboCount(AFHProjectCharacter* Character, int32 NewCount)
+{
+	if (IsRegistered(Character) == false)
+	{
+		return;
+	}
+
+	//Owner Client, Combo Count Replicated from Server
+	if (ComboCounts[Character->GetCombatantIndex()] == NewCount)
+	{
+		return;
+	}
+
+	ComboCounts[Character->GetCombatantIndex()] = NewCount;
+
+	if (UCombatEventSubsystem* EventSubsystem = GetWorld()->GetSubsystem<UCombatEventSubsystem>())
+	{
+		EventSubsystem->Publish(ECombatEventType::Combo, Character, nullptr, FVector::ZeroVector, 0.0f, NewCount);
+	}
+}
+
+EComboState UCombatWorldSubsystem::GetComboState(const AFHProjectCharacter* Character) const
+{
+	if (IsRegistered(Character) == false)
+	{
+		return EComboState::Idle;
+	}
+
+	return GetComboState(Character->GetCombatantIndex());
+}
+
+bool UCombatWorldSubsystem::RequestAttack(AFHProjectCharacter* Character, EAttackPhase NewPhase)
+{
+	//Not Registered Character can't Buffer, Start Now
+	if (IsRegistered(Character) == false)
+	{
+		return true;
+	}
+
+	const int32 Index = Character->GetCombatantIndex();
+	if (BufferedAttacks[Index] == EAttackPhase::None && CanStartAttack(Index) == true)
+	{
+		return true;
+	}
+
+	//Newest Input Win, Old Buffered Input is Replaced
+	BufferedAttacks[Index] = NewPhase;
+	BufferedAttackRemainingTimes[Index] = InputBufferTime;
+
+	UE_LOG(LogClass, Warning, TEXT("CombatWorldSubsystem::RequestAttack::Buffered :: %d"), static_cast<int32>(NewPhase));
+	return false;
+}
+
+void UCombatWorldSubsystem::StartAttackPhase(AFHProjectCharacter* Character, EAttackPhase NewPhase, float Duration)
+{
+	if (IsRegistered(Character) == false)
+	{
+		return;
+	}
+
+	const int32 Index = Character->GetCombatantIndex();
+	AttackPhases[Index] = NewPhase;
+	AttackPhaseRemainingTimes[Index] = Duration;
+	CancelWindowTimes[Index] = Duration * CancelWindowRatio;
+}
+
+EAttackPhase UCombatWorldSubsystem::GetAttackPhase(const AFHProjectCharacter* Character) const
+{
+	if (IsRegistered(Character) == false)
+	{
+		return EAttackPhase::None;
+	}
+
+	return AttackPhases[Character->GetCombatantIndex()];
+}
+
+bool UCombatWorldSubsystem::IsOnCooldown(const AFHProjectCharacter* Character) const
+{
+	if (IsRegistered(Character) == false)
+	{
+		return false;
+	}
+
+	return Cooldowns[Character->GetCombatantIndex()] > 0.0f;
+}
+
+void UCombatWorldSubsystem::StartCooldown(AFHProjectCharacter* Character, float Duration)
+{
+	if (IsRegistered(Character) == false)
+	{
+		return;
+	}
+
+	Cooldowns[Character->GetCombatantIndex()] = Duration;
+}
+
+bool UCombatWorldSubsystem::IsRegistered(const AFHProjectCharacter* Character) const
+{
+	return Character != nullptr && Combatants.IsValidIndex(Character->GetCombatantIndex()) == true && Combatants[Character->GetCombatantIndex()] == Character;
+}
+
+void UCombatWorldSubsystem::TickInputCommands()
+{
+	for (AFHProjectCharacter* Character : Combatants)
+	{
+		if (Character->IsLocallyControlled() == true && Character->IsPlayerControlled() == true)
+		{
+			Character->FlushInputCommand();
+		}
+
+		if (Character->HasAuthority() == true)
+		{
+			Character->FlushThrottledInputCommand();
+		}
+	}
+}
+
+void UCombatWorldSubsystem::TickCooldowns(float DeltaTime)
+{
+	for (float& Cooldown : Cooldowns)
+	{
+		Cooldown = FMath::Max(Cooldown - DeltaTime, 0.0f);
+	}
+}
+
+void UCombatWorldSubsystem::TickAttackPhases(float DeltaTime)
+{
+	for (int32 Index = 0; Index < AttackPhases.Num(); ++Index)
+	{
+		if (AttackPhases[Index] == EAttackPhase::None)
+		{
+			continue;
+		}
+
+		AttackPhaseRemainingTimes[Index] -= DeltaTime;
+		if (AttackPhaseRemainingTimes[Index] <= 0.0f)
+		{
+			AttackPhases[Index] = EAttackPhase::None;
+			AttackPhaseRemainingTimes[Index] = 0.0f;
+		}
+	}
+}
+
+void UCombatWorldSubsystem::TickAttackBuffers(float DeltaTime)
+{
+	for (int32 Index = 0; Index < BufferedAttacks.Num(); ++Index)
+	{
+		if (BufferedAttacks[Index] == EAttackPhase::None)
+		{
+			continue;
+		}
+
+		BufferedAttackRemainingTimes[Index] -= DeltaTime;
+		if (BufferedAttackRemainingTimes[Index] <= 0.0f)
+		{
+			BufferedAttacks[Index] = EAttackPhase::None;
+			BufferedAttackRemainingTimes[Index] = 0.0f;
+			continue;
+		}
+
+		if (CanStartAttack(Index) == false)
+		{
+			continue;
+		}
+
+		//Weapon Dropped While Buffered, Input is Lost with Weapon
+		const EAttackPhase BufferedAttack = BufferedAttacks[Index];
+		BufferedAttacks[Index] = EAttackPhase::None;
+		BufferedAttackRemainingTimes[Index] = 0.0f;
+
+		ABaseWeapon* Weapon = EquippedWeapons[Index];
+		if (IsValid(Weapon) == true)
+		{
+			Weapon->StartComboAttack(BufferedAttack);
+		}
+	}
+}
+
+EComboState UCombatWorldSubsystem::GetComboState(int32 Index) const
+{
+	if (AttackPhases[Index] == EAttackPhase::None)
+	{
+		return EComboState::Idle;
+	}
+
+	return AttackPhaseRemainingTimes[Index] <= CancelWindowTimes[Index] ? EComboState::CancelWindow : EComboState::Attacking;
+}
+
+bool UCombatWorldSubsystem::CanStartAttack(int32 Index) const
+{
+	switch (GetComboState(Index))
+	{
+	case EComboState::Idle:
+		//Roll or Other Montage Playing, Wait for it
+		return Combatants[Index]->bIsMontagePlaying() == false;
+	case EComboState::CancelWindow:
+		return true;
+	default:
+		return false;
+	}
+}
+
+void UCombatWorldSubsystem::TickBakedHitWindows(float DeltaTime)
+{
+	//Only Attacking Combatant has Active Hit Window
+	for (int32 Index = 0; Index < AttackPhases.Num(); ++Index)
+	{
+		ABaseWeapon* Weapon = EquippedWeapons[Index];
+		if (IsValid(Weapon) == false || Weapon->IsEvaluatingBakedHitWindow() == false)
+		{
+			continue;
+		}
+
+		Weapon->TickBakedHitWindow(DeltaTime);
+	}
+}
+
+void UCombatWorldSubsystem::TickPlayerRotations()
+{
+	for (AFHProjectCharacter* Character : Combatants)
+	{
+		Character->UpdatePlayerRotation();
+	}
+}
+
+void UCombatWorldSubsystem::UpdateBroadphase()
+{
+	Broadphase.Reset(Combatants.Num());
+
+	for (int32 Index = 0; Index < Combatants.Num(); ++Index)
+	{
+		const UCapsuleComponent* Capsule = Combatants[Index]->GetCapsuleComponent();
+		Broadphase.SetCapsule(Index, Capsule->GetComponentLocation(), Capsule->GetScaledCapsuleHalfHeight(), Capsule->GetScaledCapsuleRadius());
+	}
+}
+
+void UCombatWorldSubsystem::QueryCapsules(const FVector& Start, const FVector& End, float Radius, TArray<FCapsuleBroadphaseHit>& OutHits) const
+{
+	Broadphase.Query(Start, End, Radius, OutHits);
+}
+
+void UCombatWorldSubsystem::TickHitboxes()
+{
+	for (int32 Index = 0; Index < Combatants.Num(); ++Index)
+	{
+		UHitboxComponent* Hitbox = Combatants[Index]->GetHitboxComponent();
+		if (Hitbox == nullptr)
+		{
+			continue;
+		}
+
+		const FVector Location = Combatants[Index]->GetActorLocation();
+
+		//Any Other Combatant in Attack Phase Nearby
+		bool bIsNearAttack = false;
+		for (int32 AttackerIndex = 0; AttackerIndex < Combatants.Num(); ++AttackerIndex)
+		{
+			if (AttackerIndex == Index || AttackPhases[AttackerIndex] == EAttackPhase::None)
+			{
+				continue;
+			}
+
+			float ActivationRadius = HitboxActivationRadius;
+			const ABaseWeapon* Weapon = EquippedWeapons[AttackerIndex];
+			if (IsValid(Weapon) == true && Weapon->bIsRangeWeapon == true)
+			{
+				ActivationRadius = FMath::Max(ActivationRadius, Weapon->AttackRange);
+			}
+
+			if (FVector::DistSquared(Location, Combatants[AttackerIndex]->GetActorLocation()) <= ActivationRadius * ActivationRadius)
+			{
+				bIsNearAttack = true;
+				break;
+			}
+		}
+
+		Hitbox->SetHitboxActive(bIsNearAttack);
+		Hitbox->UpdateHitboxes();
+	}
+}
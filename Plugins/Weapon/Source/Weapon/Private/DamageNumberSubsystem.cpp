@@ -0,0 +1,312 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "DamageNumberSubsystem.h"
+#include "FHProjectCharacter.h"
+#include "CombatEventSubsystem.h"
+#include "Engine/GameViewportClient.h"
+#include "Engine/NetSerialization.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Rendering/DrawElements.h"
+#include "Styling/CoreStyle.h"
+#include "Widgets/SLeafWidget.h"
+
+
+bool FDamageNumber::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	bOutSuccess = SerializePackedVector<1, 24>(Location, Ar);
+
+	uint32 RoundedDamage = static_cast<uint32>(FMath::Max(FMath::RoundToInt(Damage), 0));
+	Ar.SerializeIntPacked(RoundedDamage);
+
+	uint8 RegionByte = static_cast<uint8>(Region);
+	Ar << RegionByte;
+
+	if (Ar.IsLoading() == true)
+	{
+		Damage = static_cast<float>(RoundedDamage);
+		Region = static_cast<EHitboxRegion>(RegionByte);
+	}
+
+	return true;
+}
+
+
+//----------[ Overlay ]----------
+//Draw every Active Number of Subsystem, Leaf Widget has No Child and No Layout
+class SDamageNumberOverlay : public SLeafWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SDamageNumberOverlay) {}
+		SLATE_ARGUMENT(TWeakObjectPtr<UDamageNumberSubsystem>, Subsystem)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs)
+	{
+		Subsystem = InArgs._Subsystem;
+
+		SetVisibility(EVisibility::HitTestInvisible);
+		SetCanTick(false);
+
+		if (Subsystem.IsValid() == true)
+		{
+			Font = FCoreStyle::GetDefaultFontStyle("Bold", Subsystem->GetFontSize());
+		}
+	}
+
+	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override
+	{
+		const UDamageNumberSubsystem* DamageNumberSubsystem = Subsystem.Get();
+		const APlayerController* PlayerController = DamageNumberSubsystem != nullptr ? DamageNumberSubsystem->GetWorld()->GetFirstPlayerController() : nullptr;
+		if (PlayerController == nullptr)
+		{
+			return LayerId;
+		}
+
+		//Projected Position is Viewport Pixel, Geometry Scale include DPI Scale
+		const float InverseScale = 1.0f / FMath::Max(AllottedGeometry.Scale, UE_KINDA_SMALL_NUMBER);
+		const float Lifetime = FMath::Max(DamageNumberSubsystem->GetNumberLifetime(), UE_KINDA_SMALL_NUMBER);
+
+		for (const FDamageNumberEntry& Entry : DamageNumberSubsystem->GetEntries())
+		{
+			if (Entry.Age >= Lifetime)
+			{
+				continue;
+			}
+
+			FVector2D ScreenPosition;
+			if (PlayerController->ProjectWorldLocationToScreen(Entry.Location, ScreenPosition, true) == false)
+			{
+				continue;
+			}
+
+			const float LifeRatio = Entry.Age / Lifetime;
+			FLinearColor Color = DamageNumberSubsystem->GetNumberColor(Entry.Region);
+			Color.A *= 1.0f - LifeRatio * LifeRatio;
+
+			//Rise from Hit Location, Centered Roughly by Digit Count
+			const FString DamageText = FString::FromInt(FMath::RoundToInt(Entry.Damage));
+			const FVector2D Position = ScreenPosition * InverseScale - FVector2D(DamageText.Len() * Font.Size * 0.3f, Entry.Age * DamageNumberSubsystem->GetRiseSpeed() + Font.Size);
+
+			FSlateDrawElement::MakeText(
+				OutDrawElements,
+				LayerId,
+				AllottedGeometry.ToPaintGeometry(FVector2D(1.0f, 1.0f), FSlateLayoutTransform(Position)),
+				DamageText,
+				Font,
+				ESlateDrawEffect::None,
+				Color);
+		}
+
+		//Hit Marker, Four Short Lines around Screen Center
+		const float HitMarkerAlpha = DamageNumberSubsystem->GetHitMarkerAlpha();
+		if (HitMarkerAlpha > 0.0f)
+		{
+			const FVector2D Center = AllottedGeometry.GetLocalSize() * 0.5f;
+			FLinearColor Color = DamageNumberSubsystem->IsHitMarkerCritical() == true ? DamageNumberSubsystem->GetNumberColor(EHitboxRegion::Head) : FLinearColor::White;
+			Color.A *= HitMarkerAlpha;
+
+			const float Inner = 6.0f;
+			const float Outer = 14.0f;
+			for (const FVector2D& Direction : { FVector2D(1.0f, 1.0f), FVector2D(-1.0f, 1.0f), FVector2D(1.0f, -1.0f), FVector2D(-1.0f, -1.0f) })
+			{
+				TArray<FVector2D> Points;
+				Points.Add(Center + Direction * Inner);
+				Points.Add(Center + Direction * Outer);
+				FSlateDrawElement::MakeLines(OutDrawElements, LayerId, AllottedGeometry.ToPaintGeometry(), Points, ESlateDrawEffect::None, Color, true, 2.0f);
+			}
+		}
+
+		return LayerId;
+	}
+
+	virtual FVector2D ComputeDesiredSize(float LayoutScaleMultiplier) const override
+	{
+		//Fill Viewport Overlay Slot, No Own Size
+		return FVector2D::ZeroVector;
+	}
+
+private:
+	TWeakObjectPtr<UDamageNumberSubsystem> Subsystem;
+
+	FSlateFontInfo Font;
+};
+
+
+//----------[ Subsystem ]----------
+UDamageNumberSubsystem::UDamageNumberSubsystem()
+{
+	//Default Value, Override in DefaultGame.ini
+	MaxActiveNumbers = 64;
+	MaxNumbersPerBatch = 16;
+	NumberLifetime = 1.0f;
+	RiseSpeed = 60.0f;
+	FontSize = 18;
+	HitMarkerTime = 0.15f;
+	NormalColor = FLinearColor::White;
+	CriticalColor = FLinearColor(1.0f, 0.8f, 0.1f, 1.0f);
+
+	NextEntryIndex = 0;
+	HitMarkerRemainingTime = 0.0f;
+	bHitMarkerCritical = false;
+}
+
+bool UDamageNumberSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UDamageNumberSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Collection.InitializeDependency<UCombatEventSubsystem>();
+
+	Super::Initialize(Collection);
+
+	//Every Slot is Dead Until Written
+	Entries.SetNum(FMath::Max(MaxActiveNumbers, 1));
+}
+
+void UDamageNumberSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	//Server Listen Damage Events, Listen Server Host also Draw
+	if (InWorld.GetNetMode() != NM_Client)
+	{
+		if (UCombatEventSubsystem* EventSubsystem = InWorld.GetSubsystem<UCombatEventSubsystem>())
+		{
+			CombatEventHandle = EventSubsystem->AddListener(FOnCombatEvent::FDelegate::CreateUObject(this, &UDamageNumberSubsystem::OnCombatEvent));
+		}
+	}
+
+	if (InWorld.GetNetMode() != NM_DedicatedServer)
+	{
+		CreateOverlay();
+	}
+}
+
+void UDamageNumberSubsystem::Deinitialize()
+{
+	if (UCombatEventSubsystem* EventSubsystem = GetWorld()->GetSubsystem<UCombatEventSubsystem>())
+	{
+		EventSubsystem->RemoveListener(CombatEventHandle);
+	}
+
+	RemoveOverlay();
+	PendingBatches.Reset();
+
+	Super::Deinitialize();
+}
+
+void UDamageNumberSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (PendingBatches.Num() > 0)
+	{
+		FlushDamageNumbers();
+	}
+
+	for (FDamageNumberEntry& Entry : Entries)
+	{
+		if (Entry.Age < NumberLifetime)
+		{
+			Entry.Age += DeltaTime;
+		}
+	}
+
+	HitMarkerRemainingTime = FMath::Max(HitMarkerRemainingTime - DeltaTime, 0.0f);
+}
+
+TStatId UDamageNumberSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UDamageNumberSubsystem, STATGROUP_Tickables);
+}
+
+void UDamageNumberSubsystem::OnCombatEvent(const FCombatEvent& Event)
+{
+	if (Event.Type != ECombatEventType::Damage)
+	{
+		return;
+	}
+
+	//Only Player Attacker has Screen
+	AFHProjectCharacter* Attacker = Cast<AFHProjectCharacter>(Event.Instigator.Get());
+	if (Attacker == nullptr || Attacker->IsPlayerControlled() == false)
+	{
+		return;
+	}
+
+	TArray<FDamageNumber>& Batch = PendingBatches.FindOrAdd(Attacker);
+	if (Batch.Num() >= MaxNumbersPerBatch)
+	{
+		return;
+	}
+
+	FDamageNumber& Number = Batch.AddDefaulted_GetRef();
+	Number.Location = FVector(Event.Location);
+	Number.Damage = Event.Value;
+	Number.Region = static_cast<EHitboxRegion>(Event.Count);
+}
+
+void UDamageNumberSubsystem::FlushDamageNumbers()
+{
+	for (const TPair<TWeakObjectPtr<AFHProjectCharacter>, TArray<FDamageNumber>>& Pending : PendingBatches)
+	{
+		if (AFHProjectCharacter* Attacker = Pending.Key.Get())
+		{
+			Attacker->Res_DamageNumbers(Pending.Value);
+		}
+	}
+
+	PendingBatches.Reset();
+}
+
+void UDamageNumberSubsystem::AddDamageNumbers(const TArray<FDamageNumber>& Numbers)
+{
+	for (const FDamageNumber& Number : Numbers)
+	{
+		//Overwrite Oldest Slot, Ring is Fixed Size
+		FDamageNumberEntry& Entry = Entries[NextEntryIndex];
+		Entry.Location = Number.Location;
+		Entry.Damage = Number.Damage;
+		Entry.Region = Number.Region;
+		Entry.Age = 0.0f;
+
+		NextEntryIndex = (NextEntryIndex + 1) % Entries.Num();
+	}
+
+	if (Numbers.Num() > 0)
+	{
+		HitMarkerRemainingTime = HitMarkerTime;
+		bHitMarkerCritical = Numbers.ContainsByPredicate([](const FDamageNumber& Number) { return Number.Region == EHitboxRegion::Head; });
+	}
+}
+
+void UDamageNumberSubsystem::CreateOverlay()
+{
+	UGameViewportClient* GameViewport = GetWorld()->GetGameViewport();
+	if (GameViewport == nullptr || Overlay.IsValid() == true)
+	{
+		return;
+	}
+
+	Overlay = SNew(SDamageNumberOverlay).Subsystem(this);
+	GameViewport->AddViewportWidgetContent(Overlay.ToSharedRef(), 10);
+}
+
+void UDamageNumberSubsystem::RemoveOverlay()
+{
+	if (Overlay.IsValid() == false)
+	{
+		return;
+	}
+
+	if (UGameViewportClient* GameViewport = GetWorld()->GetGameViewport())
+	{
+		GameViewport->RemoveViewportWidgetContent(Overlay.ToSharedRef());
+	}
+
+	Overlay.Reset();
+}
@@ -0,0 +1,32 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "FHAIController.h"
+#include "FHCharacter.h"
+#include "AIBrainSubsystem.h"
+
+AFHAIController::AFHAIController()
+{
+	//NPC is not in Scoreboard, No Player State to Replicate
+	bWantsPlayerState = false;
+}
+
+void AFHAIController::OnPossess(APawn* InPawn)
+{
+	Super::OnPossess(InPawn);
+
+	if (UAIBrainSubsystem* BrainSubsystem = GetWorld()->GetSubsystem<UAIBrainSubsystem>())
+	{
+		BrainSubsystem->RegisterBrain(this, Cast<AFHCharacter>(InPawn));
+	}
+}
+
+void AFHAIController::OnUnPossess()
+{
+	if (UAIBrainSubsystem* BrainSubsystem = GetWorld()->GetSubsystem<UAIBrainSubsystem>())
+	{
+		BrainSubsystem->UnregisterBrain(this);
+	}
+
+	Super::OnUnPossess();
+}
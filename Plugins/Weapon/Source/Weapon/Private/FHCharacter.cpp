@@ -2,27 +2,47 @@
 
 
 #include "FHCharacter.h"
+#include "FHAIController.h"
+#include "BaseWeapon.h"
+#include "WeaponInterface.h"
+#include "Camera/CameraComponent.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/SpringArmComponent.h"
 
 // Sets default values
 AFHCharacter::AFHCharacter()
 {
- 	// Set this character to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
-	PrimaryActorTick.bCanEverTick = true;
+ 	// Combat State is Updated by CombatWorldSubsystem, Character doesn't need Tick
+	PrimaryActorTick.bCanEverTick = false;
 
+	//Spawned and Placed NPC are Possessed by FHAIController
+	AIControllerClass = AFHAIController::StaticClass();
+	AutoPossessAI = EAutoPossessAI::PlacedInWorldOrSpawned;
+
+	//Face Focus Target (Controller Rotation), not Movement Direction
+	GetCharacterMovement()->bOrientRotationToMovement = false;
+	GetCharacterMovement()->bUseControllerDesiredRotation = true;
+
+	//NPC has No View, Camera Boom never Tick
+	GetCameraBoom()->PrimaryComponentTick.bCanEverTick = false;
+	GetCameraBoom()->bAutoActivate = false;
+	GetFollowCamera()->bAutoActivate = false;
+
+	DefaultWeaponClass = nullptr;
 }
 
 // Called when the game starts or when spawned
 void AFHCharacter::BeginPlay()
 {
 	Super::BeginPlay();
-	
+
 }
 
-// Called every frame
-void AFHCharacter::Tick(float DeltaTime)
+void AFHCharacter::PossessedBy(AController* NewController)
 {
-	Super::Tick(DeltaTime);
+	Super::PossessedBy(NewController);
 
+	EquipDefaultWeapon();
 }
 
 // Called to bind functionality to input
@@ -32,3 +52,36 @@ void AFHCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputCompone
 
 }
 
+void AFHCharacter::ProcessAICommand(const FFHInputCommand& Command)
+{
+	//Server, No RPC and No Sequence, Brain is on Server
+	if (HasAuthority() == false)
+	{
+		return;
+	}
+
+	ProcessInputCommand(Command);
+}
+
+void AFHCharacter::EquipDefaultWeapon()
+{
+	//Server, Already Armed When Re-Possessed
+	if (HasAuthority() == false || DefaultWeaponClass == nullptr || GetEquipWeapon() != nullptr)
+	{
+		return;
+	}
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.Owner = GetController();
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	ABaseWeapon* Weapon = GetWorld()->SpawnActor<ABaseWeapon>(DefaultWeaponClass, GetActorTransform(), SpawnParameters);
+	if (Weapon == nullptr)
+	{
+		UE_LOG(LogClass, Warning, TEXT("EquipDefaultWeapon::Spawn Failed"));
+		return;
+	}
+
+	//Same Pick Up Event as Player
+	IWeaponInterface::Execute_Event_GetItem(this, EItemType::TestWeapon, Weapon);
+}
@@ -0,0 +1,42 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "FHDemoNetDriver.h"
+#include "MatchReplaySubsystem.h"
+#include "Engine/World.h"
+
+
+void UFHDemoNetDriver::ProcessRemoteFunction(AActor* Actor, UFunction* Function, void* Parameters, FOutParmRec* OutParms, FFrame* Stack, UObject* SubObject)
+{
+	//Only Recording, Playback Driver never Send
+	if (IsRecording() == true && SubObject == nullptr && GetWorld() != nullptr)
+	{
+		UMatchReplaySubsystem* ReplaySubsystem = GetWorld()->GetSubsystem<UMatchReplaySubsystem>();
+		if (ReplaySubsystem != nullptr && ReplaySubsystem->IsReplayEventFunction(Function) == true)
+		{
+			ReplaySubsystem->RecordFunctionEvent(this, Actor, Function, Parameters);
+			return;
+		}
+	}
+
+	Super::ProcessRemoteFunction(Actor, Function, Parameters, OutParms, Stack, SubObject);
+}
+
+void UFHDemoNetDriver::TickFlush(float DeltaSeconds)
+{
+	if (IsRecording() == false || GetWorld() == nullptr)
+	{
+		Super::TickFlush(DeltaSeconds);
+		return;
+	}
+
+	//Replication, Checkpoint Save Slice and Stream Write Request
+	const double StartTime = FPlatformTime::Seconds();
+
+	Super::TickFlush(DeltaSeconds);
+
+	if (UMatchReplaySubsystem* ReplaySubsystem = GetWorld()->GetSubsystem<UMatchReplaySubsystem>())
+	{
+		ReplaySubsystem->AddRecordTime(FPlatformTime::Seconds() - StartTime);
+	}
+}
@@ -0,0 +1,72 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "FHInputCommand.h"
+
+
+void FFHInputCommand::ResetEdges()
+{
+	PressedButtons = FHInputButton::None;
+	ReleasedButtons = FHInputButton::None;
+	SelectSlotIndex = INDEX_NONE;
+	ClickAge = -1.0f;
+}
+
+void FFHInputCommand::MergeEdges(const FFHInputCommand& Newer)
+{
+	Sequence = Newer.Sequence;
+	HeldButtons = Newer.HeldButtons;
+	PressedButtons |= Newer.PressedButtons;
+	ReleasedButtons |= Newer.ReleasedButtons;
+
+	if (Newer.SelectSlotIndex != INDEX_NONE)
+	{
+		SelectSlotIndex = Newer.SelectSlotIndex;
+	}
+
+	//First Click is Latency Trace Start
+	if (ClickAge < 0.0f)
+	{
+		ClickAge = Newer.ClickAge;
+	}
+}
+
+bool FFHInputCommand::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	Ar << Sequence;
+
+	//Only Used Button Bits are Serialized
+	uint32 Held = HeldButtons;
+	uint32 Pressed = PressedButtons;
+	uint32 Released = ReleasedButtons;
+	Ar.SerializeBits(&Held, FHInputButton::NumBits);
+	Ar.SerializeBits(&Pressed, FHInputButton::NumBits);
+	Ar.SerializeBits(&Released, FHInputButton::NumBits);
+
+	//Slot 0 ~ 5, 7 is No Change
+	uint32 Slot = SelectSlotIndex == INDEX_NONE ? 7 : static_cast<uint32>(SelectSlotIndex);
+	Ar.SerializeBits(&Slot, 3);
+
+	//Click Time Only in Command has Attack Click
+	uint8 bHasClickAge = ClickAge >= 0.0f ? 1 : 0;
+	Ar.SerializeBits(&bHasClickAge, 1);
+	if (bHasClickAge != 0)
+	{
+		Ar << ClickAge;
+	}
+	else if (Ar.IsLoading() == true)
+	{
+		ClickAge = -1.0f;
+	}
+
+	if (Ar.IsLoading() == true)
+	{
+		HeldButtons = static_cast<uint8>(Held);
+		PressedButtons = static_cast<uint8>(Pressed);
+		ReleasedButtons = static_cast<uint8>(Released);
+		SelectSlotIndex = Slot == 7 ? INDEX_NONE : static_cast<int8>(Slot);
+	}
+
+	bOutSuccess = true;
+	return true;
+}
@@ -3,6 +3,7 @@
 #include "FHProjectCharacter.h"
 #include "Camera/CameraComponent.h"
 #include "Components/CapsuleComponent.h"
+#include "Components/StaticMeshComponent.h"
 #include "Components/InputComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "GameFramework/Controller.h"
@@ -13,6 +14,15 @@
 #include "Net/UnrealNetwork.h"
 #include "BaseWeapon.h"
 #include "WeaponInterface.h"
+#include "CharacterSignificanceSubsystem.h"
+#include "CombatWorldSubsystem.h"
+#include "RpcRateLimitSubsystem.h"
+#include "WeaponProxySubsystem.h"
+#include "HitboxComponent.h"
+#include "LatencyTraceSubsystem.h"
+#include "CombatEventSubsystem.h"
+#include "WeaponSnapshotSubsystem.h"
+#include "NetFrequencySubsystem.h"
 
 
 
@@ -21,6 +31,9 @@
 
 AFHProjectCharacter::AFHProjectCharacter()
 {
+	// Combat State and Aim are Updated by CombatWorldSubsystem, Character doesn't need Tick
+	PrimaryActorTick.bCanEverTick = false;
+
 	// Set size for collision capsule
 	GetCapsuleComponent()->InitCapsuleSize(42.f, 96.0f);
 
@@ -89,6 +102,35 @@ AFHProjectCharacter::AFHProjectCharacter()
 	//If you want to change Socket Name, Edit like this -> FName(TEXT("MySocketName"))
 	WeaponSocketName = FName(TEXT("Weapon"));
 
+	//Visual Only Weapon, Mesh is Set When Active Slot Change
+	EquipWeaponMesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("EquipWeaponMesh"));
+	EquipWeaponMesh->SetupAttachment(GetMesh(), WeaponSocketName);
+	EquipWeaponMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	EquipWeaponMesh->SetGenerateOverlapEvents(false);
+	EquipWeaponMesh->SetCanEverAffectNavigation(false);
+	EquipWeaponMesh->CanCharacterStepUpOn = ECB_No;
+
+	CombatantIndex = INDEX_NONE;
+
+	//Per Region Hitbox, Bone Capsules are Set in Component
+	Hitbox = CreateDefaultSubobject<UHitboxComponent>(TEXT("Hitbox"));
+
+	//Hotbar Inventory
+	Inventory.OwnerCharacter = this;
+	ActiveSlotIndex = 0;
+
+	//Input Command Sequence Start from 1
+	LastInputSequence = 0;
+	PendingClickTime = 0.0;
+
+	//Set Roll Cooldown, Second
+	RollCooldown = 0.5f;
+
+	//Aim Replication, 16 Bits per Axis is about 0.0055 Degree
+	PackedAimRotation = 0;
+	AimUpdateThreshold = 0.5f;
+	AimInterpolationDelay = 0.1f;
+
 }
 
 // Network Setting
@@ -96,7 +138,9 @@ void AFHProjectCharacter::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>&
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME(AFHProjectCharacter, PlayerRotation);
+	DOREPLIFETIME_CONDITION(AFHProjectCharacter, PackedAimRotation, COND_SkipOwner);
+	DOREPLIFETIME(AFHProjectCharacter, Inventory);
+	DOREPLIFETIME(AFHProjectCharacter, ActiveSlotIndex);
 }
 
 void AFHProjectCharacter::BeginPlay()
@@ -112,22 +156,167 @@ void AFHProjectCharacter::BeginPlay()
 			Subsystem->AddMappingContext(DefaultMappingContext, 0);
 		}
 	}
+
+	//Dedicated Server don't need Pose, Server Hit use Baked Hit Window and Montage Position only
+	//Montage still Tick for Root Motion and Montage Position
+	//Active Hitbox Refresh Bones While Enemy Attack Window is Open Nearby
+	if (GetNetMode() == NM_DedicatedServer)
+	{
+		GetMesh()->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::OnlyTickMontagesWhenNotRendered;
+	}
+
+	//Register Significance, Animation Update Rate is Set by Distance, Visibility and Combat
+	if (UCharacterSignificanceSubsystem* SignificanceSubsystem = GetWorld()->GetSubsystem<UCharacterSignificanceSubsystem>())
+	{
+		SignificanceSubsystem->RegisterCharacter(this);
+	}
+
+	//Register Combat State
+	if (UCombatWorldSubsystem* CombatSubsystem = GetWorld()->GetSubsystem<UCombatWorldSubsystem>())
+	{
+		CombatSubsystem->RegisterCombatant(this);
+	}
+
+	//Server, Net Update Frequency Follow Combat Activity
+	if (UNetFrequencySubsystem* FrequencySubsystem = GetWorld()->GetSubsystem<UNetFrequencySubsystem>())
+	{
+		FrequencySubsystem->RegisterActor(this);
+	}
 }
 
-void AFHProjectCharacter::Tick(float DeltaTime)
+void AFHProjectCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	Super::Tick(DeltaTime);
+	if (UCharacterSignificanceSubsystem* SignificanceSubsystem = GetWorld()->GetSubsystem<UCharacterSignificanceSubsystem>())
+	{
+		SignificanceSubsystem->UnregisterCharacter(this);
+	}
+
+	if (UCombatWorldSubsystem* CombatSubsystem = GetWorld()->GetSubsystem<UCombatWorldSubsystem>())
+	{
+		CombatSubsystem->UnregisterCombatant(this);
+	}
 
-	//If Has Authority, Set PlayerRotation Uproperty(Replicated)
-	if (HasAuthority() == true)
+	if (UNetFrequencySubsystem* FrequencySubsystem = GetWorld()->GetSubsystem<UNetFrequencySubsystem>())
 	{
-		PlayerRotation = GetControlRotation();
+		FrequencySubsystem->UnregisterActor(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AFHProjectCharacter::PossessedBy(AController* NewController)
+{
+	Super::PossessedBy(NewController);
+
+	//Player State is Set, Loadout Key is Valid
+	if (UWeaponSnapshotSubsystem* SnapshotSubsystem = GetWorld()->GetSubsystem<UWeaponSnapshotSubsystem>())
+	{
+		SnapshotSubsystem->ApplyPendingLoadout(this);
+	}
+}
+
+void AFHProjectCharacter::UpdatePlayerRotation()
+{
+	if (HasAuthority() == false)
+	{
+		return;
+	}
+
+	const uint32 NewPackedAimRotation = PackAimRotation(GetControlRotation());
+	if (NewPackedAimRotation == PackedAimRotation)
+	{
+		return;
+	}
+
+	//Small Aim Change is not Sent, Property stay Unchanged
+	const FRotator SentRotation = UnpackAimRotation(PackedAimRotation);
+	const FRotator NewRotation = UnpackAimRotation(NewPackedAimRotation);
+	const float PitchDelta = FMath::Abs(FRotator::NormalizeAxis(NewRotation.Pitch - SentRotation.Pitch));
+	const float YawDelta = FMath::Abs(FRotator::NormalizeAxis(NewRotation.Yaw - SentRotation.Yaw));
+
+	if (PitchDelta > AimUpdateThreshold || YawDelta > AimUpdateThreshold)
+	{
+		PackedAimRotation = NewPackedAimRotation;
 	}
 }
 
+void AFHProjectCharacter::OnRep_PackedAimRotation()
+{
+	const double Now = GetWorld()->GetTimeSeconds();
+	const FRotator ReceivedRotation = UnpackAimRotation(PackedAimRotation);
+
+	//Aim was Still, Hold Last Aim until One Update Interval Ago, Move doesn't Stretch over Still Time
+	//Client doesn't Know Server's Update Rate, Interval is Observed from Arrivals
+	if (AimSnapshots.Num() > 0)
+	{
+		const FAimSnapshot LastSnapshot = AimSnapshots.Last();
+		const float ArrivalInterval = GetAimArrivalInterval();
+		if (ArrivalInterval > 0.0f && LastSnapshot.Time < Now - ArrivalInterval)
+		{
+			FAimSnapshot& HoldSnapshot = AimSnapshots.Add_GetRef(LastSnapshot);
+			HoldSnapshot.Time = Now - ArrivalInterval;
+		}
+
+		AimArrivalIntervals.Add(static_cast<float>(Now - LastSnapshot.Time));
+		if (AimArrivalIntervals.Num() > MaxAimArrivalIntervals)
+		{
+			AimArrivalIntervals.RemoveAt(0, AimArrivalIntervals.Num() - MaxAimArrivalIntervals, false);
+		}
+	}
+
+	FAimSnapshot& Snapshot = AimSnapshots.AddDefaulted_GetRef();
+	Snapshot.Time = Now;
+	Snapshot.Pitch = ReceivedRotation.Pitch;
+	Snapshot.Yaw = ReceivedRotation.Yaw;
+
+	if (AimSnapshots.Num() > MaxAimSnapshots)
+	{
+		AimSnapshots.RemoveAt(0, AimSnapshots.Num() - MaxAimSnapshots, false);
+	}
+}
+
+float AFHProjectCharacter::GetAimArrivalInterval() const
+{
+	if (AimArrivalIntervals.Num() == 0)
+	{
+		return 0.0f;
+	}
+
+	//Lower Quartile, Still Time Gap is Long and Bunched Packets are Near Zero, Both Ignored
+	TArray<float, TInlineAllocator<MaxAimArrivalIntervals>> SortedIntervals(AimArrivalIntervals);
+	SortedIntervals.Sort();
+
+	return SortedIntervals[SortedIntervals.Num() / 4];
+}
+
+uint32 AFHProjectCharacter::PackAimRotation(const FRotator& Rotation)
+{
+	const uint32 Pitch = FRotator::CompressAxisToShort(Rotation.Pitch);
+	const uint32 Yaw = FRotator::CompressAxisToShort(Rotation.Yaw);
+
+	return (Pitch << 16) | Yaw;
+}
+
+FRotator AFHProjectCharacter::UnpackAimRotation(uint32 Packed)
+{
+	//Pitch -180 ~ 180, Aim Offset use Look Down as Negative
+	const float Pitch = FRotator::NormalizeAxis(FRotator::DecompressAxisFromShort(static_cast<uint16>(Packed >> 16)));
+	const float Yaw = FRotator::NormalizeAxis(FRotator::DecompressAxisFromShort(static_cast<uint16>(Packed & 0xFFFF)));
+
+	return FRotator(Pitch, Yaw, 0.0f);
+}
+
 //----------[ Test function Start ]----------
 void AFHProjectCharacter::Req_Test_Implementation(int32 Value)
 {
+	//Check Rpc Rate Limit
+	URpcRateLimitSubsystem* RateLimitSubsystem = GetWorld()->GetSubsystem<URpcRateLimitSubsystem>();
+	if (RateLimitSubsystem != nullptr && RateLimitSubsystem->ConsumeToken(this, TEXT("Req_Test")) == false)
+	{
+		UE_LOG(LogClass, Warning, TEXT("Req_Test::Rate Limited"));
+		return;
+	}
+
 	Res_Test(Value);
 }
 
@@ -146,48 +335,263 @@ void AFHProjectCharacter::Res_Test_Implementation(int32 Value)
 }
 //----------[ Test function End ]----------
 
-void AFHProjectCharacter::Req_DoRollMove_Implementation()
+void AFHProjectCharacter::Req_InputCommand_Implementation(const FFHInputCommand& Command)
 {
-	//Client
-	Res_DoRollMove();
+	//Server
+	//Drop Old or Duplicated Command
+	if (Command.IsNewerThan(LastInputSequence) == false)
+	{
+		UE_LOG(LogClass, Warning, TEXT("Req_InputCommand::Old Sequence :: %d"), Command.Sequence);
+		return;
+	}
+
+	LastInputSequence = Command.Sequence;
+
+	//Rate Limited Command is Merged, Not Dropped, Released Button never Stuck
+	ThrottledInputCommand.MergeEdges(Command);
+
+	//Check Rpc Rate Limit
+	URpcRateLimitSubsystem* RateLimitSubsystem = GetWorld()->GetSubsystem<URpcRateLimitSubsystem>();
+	if (RateLimitSubsystem != nullptr && RateLimitSubsystem->ConsumeToken(this, TEXT("Req_InputCommand")) == false)
+	{
+		UE_LOG(LogClass, Warning, TEXT("Req_InputCommand::Rate Limited, Edges Merged"));
+		return;
+	}
+
+	RunThrottledInputCommand();
 }
 
-void AFHProjectCharacter::Res_DoRollMove_Implementation()
+void AFHProjectCharacter::FlushThrottledInputCommand()
 {
-	UE_LOG(LogClass, Warning, TEXT("DoRollMove - Start"));
+	//Server, Merged Edges Wait Token, Client may not Send Next Command
+	if (ThrottledInputCommand.HasChanges() == false)
+	{
+		return;
+	}
+
+	URpcRateLimitSubsystem* RateLimitSubsystem = GetWorld()->GetSubsystem<URpcRateLimitSubsystem>();
+	if (RateLimitSubsystem != nullptr && RateLimitSubsystem->ConsumeToken(this, TEXT("Req_InputCommand"), false) == false)
+	{
+		return;
+	}
+
+	RunThrottledInputCommand();
+}
 
+void AFHProjectCharacter::RunThrottledInputCommand()
+{
+	const FFHInputCommand Command = ThrottledInputCommand;
+	ThrottledInputCommand.ResetEdges();
+
+	//Attack Click Start Latency Trace, Stamped Until ApplyDamage
+	if (Command.ClickAge >= 0.0f)
+	{
+		if (ULatencyTraceSubsystem* LatencySubsystem = GetWorld()->GetSubsystem<ULatencyTraceSubsystem>())
+		{
+			LatencySubsystem->BeginTrace(this, Command.ClickAge);
+		}
+	}
+
+	ProcessInputCommand(Command);
+}
+
+void AFHProjectCharacter::ProcessInputCommand(const FFHInputCommand& Command)
+{
+	//Sprint, Only Edge Change Speed, Held Sprint Send Nothing
+	//Walk = 500.0f, Sprint 750.0f
+	if (Command.IsPressed(FHInputButton::Sprint) == true || Command.IsReleased(FHInputButton::Sprint) == true)
+	{
+		Res_SetMaxWalkSpeed(Command.IsHeld(FHInputButton::Sprint) == true ? 750.0f : 500.0f);
+	}
+
+	//Select Slot Before Attack, Attack use New Weapon
+	if (Command.SelectSlotIndex != INDEX_NONE)
+	{
+		SelectSlot(Command.SelectSlotIndex);
+	}
+
+	if (Command.IsPressed(FHInputButton::DropItem) == true)
+	{
+		DropItem();
+	}
+
+	//Pressed and Released in Same Frame, Both Edge Run in Order
+	if (Command.IsPressed(FHInputButton::LeftClick) == true)
+	{
+		Res_LeftClickAttack(true);
+	}
+
+	if (Command.IsReleased(FHInputButton::LeftClick) == true)
+	{
+		Res_LeftClickAttack(false);
+	}
+
+	if (Command.IsPressed(FHInputButton::RightClick) == true)
+	{
+		Res_RightClickAttack(true);
+	}
+
+	if (Command.IsReleased(FHInputButton::RightClick) == true)
+	{
+		Res_RightClickAttack(false);
+	}
+
+	if (Command.IsPressed(FHInputButton::Roll) == true)
+	{
+		DoRollMove();
+	}
+}
+
+void AFHProjectCharacter::PressInputButton(uint8 Button)
+{
+	PendingInputCommand.HeldButtons |= Button;
+	PendingInputCommand.PressedButtons |= Button;
+
+	//First Attack Click of Command is Latency Trace Start, Client Clock
+	const bool bIsAttackButton = Button == FHInputButton::LeftClick || Button == FHInputButton::RightClick;
+	if (bIsAttackButton == true && PendingClickTime == 0.0)
+	{
+		const ULatencyTraceSubsystem* LatencySubsystem = GetWorld()->GetSubsystem<ULatencyTraceSubsystem>();
+		if (LatencySubsystem != nullptr && LatencySubsystem->IsEnabled() == true)
+		{
+			PendingClickTime = FPlatformTime::Seconds();
+		}
+	}
+}
+
+void AFHProjectCharacter::ReleaseInputButton(uint8 Button)
+{
+	PendingInputCommand.HeldButtons &= ~Button;
+	PendingInputCommand.ReleasedButtons |= Button;
+}
+
+#if WITH_DEV_AUTOMATION_TESTS
+void AFHProjectCharacter::SimulateInputButton(uint8 Button, bool bIsPressed)
+{
+	//Attack Input need EquipWeapon, same as Click Input
+	if ((Button == FHInputButton::LeftClick || Button == FHInputButton::RightClick) && EquipWeapon == nullptr)
+	{
+		return;
+	}
+
+	if (bIsPressed == true)
+	{
+		PressInputButton(Button);
+	}
+	else
+	{
+		ReleaseInputButton(Button);
+	}
+}
+#endif
+
+void AFHProjectCharacter::FlushInputCommand()
+{
+	//Nothing Changed this Frame, No RPC
+	if (PendingInputCommand.HasChanges() == false)
+	{
+		return;
+	}
+
+	PendingInputCommand.Sequence += 1;
+
+	//Sequence 0 is Initial Value of Server, Skip When Wrap Around
+	if (PendingInputCommand.Sequence == 0)
+	{
+		PendingInputCommand.Sequence = 1;
+	}
+
+	//Click Age is Measured on Client Clock Only, No Server Clock Estimate Error
+	const double ClickAge = PendingClickTime > 0.0 ? FPlatformTime::Seconds() - PendingClickTime : -1.0;
+	PendingInputCommand.ClickAge = static_cast<float>(ClickAge);
+
+	Req_InputCommand(PendingInputCommand);
+
+	if (PendingClickTime > 0.0)
+	{
+		if (ULatencyTraceSubsystem* LatencySubsystem = GetWorld()->GetSubsystem<ULatencyTraceSubsystem>())
+		{
+			LatencySubsystem->RecordStage(ELatencyStage::InputToSend, ClickAge);
+		}
+
+		PendingClickTime = 0.0;
+	}
+
+	PendingInputCommand.ResetEdges();
+}
+
+bool AFHProjectCharacter::CanRollMove()
+{
 	// Play Target AnimMontage When Target AnimMontage Is not Playing
 	if (bIsMontagePlaying() == true)
 	{
 		UE_LOG(LogClass, Warning, TEXT("DoRollMove::IsMontagePlaying == true"));
-		return;
+		return false;
 	}
 
 	// If Character Is Falling = return
 	if (GetCharacterMovement()->IsFalling() == true)
 	{
 		UE_LOG(LogClass, Warning, TEXT("DoRollMove::IsFalling == true"));
-		return;
+		return false;
 	}
 
 	// if Character Is Crouched = return
 	if (bIsCrouched == true)
 	{
 		UE_LOG(LogClass, Warning, TEXT("DoRollMove::IsCrouched == true"));
-		return;
+		return false;
 	}
 
 	// If StandToRollMontage Is Not Valid = return
 	if (IsValid(StandToRollMontage) == false)
 	{
 		UE_LOG(LogClass, Warning, TEXT("DoRollMove::IsValid(StandToRollMontage) == false"));
-		return;
+		return false;
 	}
 
 	// If RunToRollMontage Is Not Valid = return
 	if (IsValid(RunToRollMontage) == false)
 	{
 		UE_LOG(LogClass, Warning, TEXT("DoRollMove::IsValid(RunToRollMontage) == false"));
+		return false;
+	}
+
+	return true;
+}
+
+void AFHProjectCharacter::DoRollMove()
+{
+	//Rejected Roll doesn't Spend Cooldown
+	if (CanRollMove() == false)
+	{
+		return;
+	}
+
+	//Check Roll Cooldown
+	UCombatWorldSubsystem* CombatSubsystem = GetWorld()->GetSubsystem<UCombatWorldSubsystem>();
+	if (CombatSubsystem != nullptr)
+	{
+		if (CombatSubsystem->IsOnCooldown(this) == true)
+		{
+			UE_LOG(LogClass, Warning, TEXT("DoRollMove::IsOnCooldown == true"));
+			return;
+		}
+
+		CombatSubsystem->StartCooldown(this, RollCooldown);
+	}
+
+	//Client
+	Res_DoRollMove();
+}
+
+void AFHProjectCharacter::Res_DoRollMove_Implementation()
+{
+	UE_LOG(LogClass, Warning, TEXT("DoRollMove - Start"));
+
+	// Server Checked Same Before Cooldown, Client State may Differ
+	if (CanRollMove() == false)
+	{
 		return;
 	}
 
@@ -209,61 +613,33 @@ void AFHProjectCharacter::Res_DoRollMove_Implementation()
 		PlayAnimMontage(RunToRollMontage);
 	}
 
+	if (UCombatEventSubsystem* EventSubsystem = GetWorld()->GetSubsystem<UCombatEventSubsystem>())
+	{
+		EventSubsystem->Publish(ECombatEventType::Roll, this, nullptr, GetActorLocation());
+	}
+
 	UE_LOG(LogClass, Warning, TEXT("DoRollMove - End"));
 }
 
 
-void AFHProjectCharacter::Req_SetMaxWalkSpeed_Implementation(float NewSpeed)
-{
-	//Sprint and StopSprint Action Use This Function
-	//Default Value 500.f
-	//Walk = 500.0f, Sprint 750.0f
-	UE_LOG(LogClass, Warning, TEXT("SetMaxWalkSpeed - Start"));
-
-	// Set MaxWalkSpeed New Speed - Server
-	Res_SetMaxWalkSpeed(NewSpeed);
-
-	UE_LOG(LogClass, Warning, TEXT("SetMaxWalkSpeed - End"));
-}
-
 void AFHProjectCharacter::Res_SetMaxWalkSpeed_Implementation(float NewSpeed)
 {
 	// Set MaxWalkSpeed New Speed - Client
 	GetCharacterMovement()->MaxWalkSpeed = NewSpeed;
 }
 
-void AFHProjectCharacter::Res_AttachToWeaponSocket_Implementation(AActor* Item)
+void AFHProjectCharacter::Req_GetItem_Implementation()
 {
-	UE_LOG(LogClass, Warning, TEXT("Res_AttachToWeaponSocket - Start"));
-
-	// EquipWeapon is Target Item
-	EquipWeapon = Item;
-
-	// Check EquipWeapon Is Valid
-	if (IsValid(EquipWeapon) == true)
-	{
-		UE_LOG(LogClass, Warning, TEXT("Res_AttachToWeaponSocket::IsValid(EquipWeapon) == true"));
-	}
-
-	// Cast WeaponInterface - Item
-	IWeaponInterface* WeaponInterfaceObj = Cast<IWeaponInterface>(Item);
+	UE_LOG(LogClass, Warning, TEXT("Req_GetItem - Start"));
 
-	// Cast WeaponInterface pointer is nullptr = return
-	if (WeaponInterfaceObj == nullptr)
+	//Check Rpc Rate Limit
+	URpcRateLimitSubsystem* RateLimitSubsystem = GetWorld()->GetSubsystem<URpcRateLimitSubsystem>();
+	if (RateLimitSubsystem != nullptr && RateLimitSubsystem->ConsumeToken(this, TEXT("Req_GetItem")) == false)
 	{
-		UE_LOG(LogClass, Warning, TEXT("Res_AttachToWeaponSocket::WeaponInterfaceObj == nullptr"));
+		UE_LOG(LogClass, Warning, TEXT("Req_GetItem::Rate Limited"));
 		return;
 	}
 
-	// Item's Event_AttachToComponent, Attach Target Character is Self
-	WeaponInterfaceObj->Execute_Event_AttachToComponent(Item, this, WeaponSocketName);
-
-	UE_LOG(LogClass, Warning, TEXT("Res_AttachToWeaponSocket - End"));
-}
-
-void AFHProjectCharacter::Req_GetItem_Implementation()
-{
-	UE_LOG(LogClass, Warning, TEXT("Req_GetItem - Start"));
 	AActor* Weapon = FindWeapon();
 
 	if(Weapon == nullptr)
@@ -272,8 +648,18 @@ void AFHProjectCharacter::Req_GetItem_Implementation()
 		return;
 	}
 
+	// Check Inventory has Empty Slot
+	const int32 FreeSlotIndex = Inventory.FindFreeSlot();
+	if (FreeSlotIndex == INDEX_NONE)
+	{
+		UE_LOG(LogClass, Warning, TEXT("Req_GetItem::FreeSlotIndex == INDEX_NONE"));
+		return;
+	}
+
 	Weapon->SetOwner(GetController());
 
+	Inventory.AddWeapon(FreeSlotIndex, Cast<ABaseWeapon>(Weapon));
+
 	Res_GetItem(Weapon);
 	UE_LOG(LogClass, Warning, TEXT("Req_GetItem - End"));
 }
@@ -282,14 +668,6 @@ void AFHProjectCharacter::Res_GetItem_Implementation(AActor* Item)
 {
 	UE_LOG(LogClass, Warning, TEXT("Res_GetItem - Start"));
 
-	if (IsValid(EquipWeapon) == true)
-	{
-		UE_LOG(LogClass, Warning, TEXT("Res_GetItem::IsValid(EquipWeapon) == true"));
-		return;
-	}
-
-	EquipWeapon = Item;
-
 	IWeaponInterface* WeaponInterfaceObj = Cast<IWeaponInterface>(Item);
 	if (WeaponInterfaceObj == nullptr)
 	{
@@ -299,43 +677,52 @@ void AFHProjectCharacter::Res_GetItem_Implementation(AActor* Item)
 
 	WeaponInterfaceObj->Execute_Event_AttachToComponent(Item, this, WeaponSocketName);
 
+	RefreshEquipWeapon();
+
 	UE_LOG(LogClass, Warning, TEXT("Res_GetItem - End"));
 }
 
-void AFHProjectCharacter::Req_DropItem_Implementation()
+void AFHProjectCharacter::DropItem()
 {
 	//Server
-	Res_DropItem();
+	//Drop Active Slot Weapon
+	ABaseWeapon* DroppedWeapon = Inventory.GetWeapon(ActiveSlotIndex);
+	if (DroppedWeapon == nullptr)
+	{
+		UE_LOG(LogClass, Warning, TEXT("DropItem::Active Slot is Empty"));
+		return;
+	}
+
+	Inventory.RemoveWeapon(ActiveSlotIndex);
+
+	Res_DropItem(DroppedWeapon);
 }
 
-void AFHProjectCharacter::Res_DropItem_Implementation()
+void AFHProjectCharacter::Res_DropItem_Implementation(ABaseWeapon* DroppedWeapon)
 {
 	//Client
 	UE_LOG(LogClass, Warning, TEXT("Res_DropItem - Start"));
 
-	// Cast WeaponInterface - EquipWeapon
-	IWeaponInterface* WeaponInterfaceObj = Cast<IWeaponInterface>(EquipWeapon);
-
-	// Cast WeaponInterface pointer is nullptr = return
-	if (WeaponInterfaceObj == nullptr)
+	// Dropped Weapon not Relevant, or Already Picked up by Other Character
+	if (IsValid(DroppedWeapon) == false || DroppedWeapon->GetOwnerCharacter() != this)
 	{
-		UE_LOG(LogClass, Warning, TEXT("Res_DropItem::WeaponInterfaceObj == nullptr"));
+		UE_LOG(LogClass, Warning, TEXT("Res_DropItem::DroppedWeapon not Held"));
+		RefreshEquipWeapon(DroppedWeapon);
 		return;
 	}
 
 	// Item's Event_DetachFromActor, Detach Target Character is Self
-	WeaponInterfaceObj->Execute_Event_DetachFromActor(EquipWeapon, this);
+	IWeaponInterface::Execute_Event_DetachFromActor(DroppedWeapon, this);
 
-	// Set EquipWeapon null
-	EquipWeapon = nullptr;
+	if (UCombatEventSubsystem* EventSubsystem = GetWorld()->GetSubsystem<UCombatEventSubsystem>())
+	{
+		EventSubsystem->Publish(ECombatEventType::Drop, this, DroppedWeapon, GetActorLocation());
+	}
 
-	UE_LOG(LogClass, Warning, TEXT("Res_DropItem - End"));
-}
+	// Slot Removal may Replicate after this, Dropped Weapon is not Shown Again
+	RefreshEquipWeapon(DroppedWeapon);
 
-void AFHProjectCharacter::Req_LeftClickAttack_Implementation(bool IsPressed)
-{
-	//Client
-	Res_LeftClickAttack(IsPressed);
+	UE_LOG(LogClass, Warning, TEXT("Res_DropItem - End"));
 }
 
 void AFHProjectCharacter::Res_LeftClickAttack_Implementation(bool IsPressed)
@@ -357,12 +744,6 @@ void AFHProjectCharacter::Res_LeftClickAttack_Implementation(bool IsPressed)
 	UE_LOG(LogClass, Warning, TEXT("Res_LeftClickAttack - End"));
 }
 
-void AFHProjectCharacter::Req_RightClickAttack_Implementation(bool IsPressed)
-{
-	//Client
-	Res_RightClickAttack(IsPressed);
-}
-
 void AFHProjectCharacter::Res_RightClickAttack_Implementation(bool IsPressed)
 {
 	UE_LOG(LogClass, Warning, TEXT("Res_RightClickAttack - Start"));
@@ -382,6 +763,30 @@ void AFHProjectCharacter::Res_RightClickAttack_Implementation(bool IsPressed)
 	UE_LOG(LogClass, Warning, TEXT("Res_RightClickAttack - End"));
 }
 
+void AFHProjectCharacter::Res_ImpactEvents_Implementation(const TArray<FImpactEvent>& Impacts)
+{
+	//Client
+	for (const FImpactEvent& Impact : Impacts)
+	{
+		//Weapon not Relevant to this Client
+		if (IsValid(Impact.Weapon) == false)
+		{
+			continue;
+		}
+
+		Impact.Weapon->SpawnImpactEffect(Impact.Location, Impact.Rotation);
+	}
+}
+
+void AFHProjectCharacter::Res_DamageNumbers_Implementation(const TArray<FDamageNumber>& Numbers)
+{
+	//Client
+	if (UDamageNumberSubsystem* DamageNumberSubsystem = GetWorld()->GetSubsystem<UDamageNumberSubsystem>())
+	{
+		DamageNumberSubsystem->AddDamageNumbers(Numbers);
+	}
+}
+
 void AFHProjectCharacter::Event_GetItem_Implementation(EItemType eWeaponType, AActor* Item)
 {
 	UE_LOG(LogClass, Warning, TEXT("EventGetItem - Start"));
@@ -408,16 +813,19 @@ void AFHProjectCharacter::Event_GetItem_Implementation(EItemType eWeaponType, AA
 			return;
 		}
 
-		// Check EquipWeapon null
-		if (EquipWeapon != nullptr)
+		// Check Inventory has Empty Slot
+		const int32 FreeSlotIndex = Inventory.FindFreeSlot();
+		if (FreeSlotIndex == INDEX_NONE)
 		{
-			UE_LOG(LogClass, Warning, TEXT("EventGetItem::EquipWeapon != nullptr"));
+			UE_LOG(LogClass, Warning, TEXT("EventGetItem::FreeSlotIndex == INDEX_NONE"));
 
 			return;
 		}
 
+		Inventory.AddWeapon(FreeSlotIndex, BaseWeaponObj);
 
-		Res_AttachToWeaponSocket(Item);
+		//Client Attach When Slot Replicated
+		AttachInventoryWeapon(BaseWeaponObj);
 
 		break;
 	}
@@ -455,23 +863,191 @@ AActor* AFHProjectCharacter::FindWeapon()
 		Weapon = TargetWeapon;
 	}
 
+	//Proxied Weapon has No Collision, Find Instance Near Character
+	//Attach Promote it to Actor
+	if (UWeaponProxySubsystem* ProxySubsystem = GetWorld()->GetSubsystem<UWeaponProxySubsystem>())
+	{
+		ABaseWeapon* ProxyWeapon = ProxySubsystem->FindNearestProxy(GetActorLocation(), ProxySubsystem->GetPickupRadius());
+		if (ProxyWeapon != nullptr && FVector::Dist(ProxyWeapon->GetActorLocation(), GetActorLocation()) < MostShortDistance)
+		{
+			Weapon = ProxyWeapon;
+		}
+	}
+
 	UE_LOG(LogClass, Warning, TEXT("FindWeapon - End"));
 
 	return Weapon;
 }
 
-FRotator AFHProjectCharacter::GetPlayerRotation()
+void AFHProjectCharacter::SelectSlot(int32 NewSlotIndex)
 {
-	//Get Player Character index 0
-	ACharacter* PlayerCharacter0 = UGameplayStatics::GetPlayerCharacter(GetWorld(), 0);
+	//Server
+	UE_LOG(LogClass, Warning, TEXT("SelectSlot :: %d"), NewSlotIndex);
 
-	//If index 0 Player = Self, Get Controller Roatation
-	if (PlayerCharacter0 == this)
+	//Check Slot Index Range
+	if (NewSlotIndex < 0 || NewSlotIndex >= FWeaponInventoryArray::MaxSlotCount)
+	{
+		UE_LOG(LogClass, Warning, TEXT("SelectSlot::Invalid Slot Index"));
+		return;
+	}
+
+	//Can't Change Weapon While Attack or Roll
+	if (bIsMontagePlaying() == true)
+	{
+		UE_LOG(LogClass, Warning, TEXT("SelectSlot::IsMontagePlaying == true"));
+		return;
+	}
+
+	//ActiveSlotIndex Replicate, Client Refresh in OnRep_ActiveSlotIndex
+	ActiveSlotIndex = NewSlotIndex;
+	RefreshEquipWeapon();
+}
+
+bool AFHProjectCharacter::RestoreInventorySlot(int32 SlotIndex, ABaseWeapon* Weapon)
+{
+	//Server, Same as Req_GetItem without Overlap and Rate Limit
+	if (HasAuthority() == false || Weapon == nullptr)
+	{
+		return false;
+	}
+
+	if (SlotIndex < 0 || SlotIndex >= FWeaponInventoryArray::MaxSlotCount || Inventory.GetWeapon(SlotIndex) != nullptr)
+	{
+		UE_LOG(LogClass, Warning, TEXT("RestoreInventorySlot::Invalid or Used Slot :: %d"), SlotIndex);
+		return false;
+	}
+
+	//Held Weapon is never Instance
+	Weapon->SetProxied(false);
+	Weapon->SetOwner(GetController());
+
+	Inventory.AddWeapon(SlotIndex, Weapon);
+
+	//Client Attach When Slot Replicated, Restored Player may not Have Character on Client yet
+	AttachInventoryWeapon(Weapon);
+
+	return true;
+}
+
+void AFHProjectCharacter::RestoreActiveSlot(int32 NewSlotIndex)
+{
+	if (HasAuthority() == false || NewSlotIndex < 0 || NewSlotIndex >= FWeaponInventoryArray::MaxSlotCount)
+	{
+		return;
+	}
+
+	ActiveSlotIndex = NewSlotIndex;
+	RefreshEquipWeapon();
+}
+
+void AFHProjectCharacter::OnRep_ActiveSlotIndex()
+{
+	RefreshEquipWeapon();
+}
+
+void AFHProjectCharacter::AttachInventoryWeapon(ABaseWeapon* Weapon)
+{
+	//Not Mapped yet on Client, Slot Change Call Again When Weapon Replicated
+	//Already Attached by Res_GetItem is Skipped
+	if (IsValid(Weapon) == true && Weapon->GetOwnerCharacter() != this)
+	{
+		// Weapon stay Attached While in Inventory, Only Active Slot Weapon is Visible
+		IWeaponInterface::Execute_Event_AttachToComponent(Weapon, this, WeaponSocketName);
+	}
+
+	// EquipWeapon is Active Slot Weapon
+	RefreshEquipWeapon();
+}
+
+void AFHProjectCharacter::RefreshEquipWeapon(const ABaseWeapon* RemovedWeapon)
+{
+	ABaseWeapon* ActiveWeapon = Inventory.GetWeapon(ActiveSlotIndex);
+
+	//Dropped but Slot Still Here, Removal Arrive Later or is Being Applied
+	if (ActiveWeapon != nullptr && (ActiveWeapon == RemovedWeapon || ActiveWeapon->GetOwnerCharacter() != this))
+	{
+		ActiveWeapon = nullptr;
+	}
+
+	//Swap is only Mesh Change, No Attach, No Physics, No Spawn
+	if (IsValid(ActiveWeapon) == true)
+	{
+		const UStaticMeshComponent* WeaponMesh = ActiveWeapon->StaticMesh;
+		EquipWeaponMesh->SetStaticMesh(WeaponMesh->GetStaticMesh());
+		for (int32 MaterialIndex = 0; MaterialIndex < WeaponMesh->GetNumMaterials(); ++MaterialIndex)
+		{
+			EquipWeaponMesh->SetMaterial(MaterialIndex, WeaponMesh->GetMaterial(MaterialIndex));
+		}
+
+		//Same as Attach Snap Not Including Scale
+		EquipWeaponMesh->SetWorldScale3D(ActiveWeapon->GetActorScale3D());
+	}
+	else
+	{
+		EquipWeaponMesh->SetStaticMesh(nullptr);
+	}
+
+	// Refresh without Slot Change is not Equip
+	if (EquipWeapon != ActiveWeapon && IsValid(ActiveWeapon) == true)
+	{
+		if (UCombatEventSubsystem* EventSubsystem = GetWorld()->GetSubsystem<UCombatEventSubsystem>())
+		{
+			EventSubsystem->Publish(ECombatEventType::Equip, this, ActiveWeapon, GetActorLocation(), 0.0f, ActiveSlotIndex);
+		}
+	}
+
+	EquipWeapon = ActiveWeapon;
+
+	// Set Combatant Weapon Archetype
+	if (UCombatWorldSubsystem* CombatSubsystem = GetWorld()->GetSubsystem<UCombatWorldSubsystem>())
+	{
+		CombatSubsystem->SetEquippedWeapon(this, ActiveWeapon);
+	}
+}
+
+FRotator AFHProjectCharacter::GetPlayerRotation()
+{
+	//Local Player and Server has Control Rotation
+	if (IsLocallyControlled() == true || HasAuthority() == true)
 	{
 		return GetControlRotation();
 	}
 
-	return PlayerRotation;
+	if (AimSnapshots.Num() == 0)
+	{
+		return UnpackAimRotation(PackedAimRotation);
+	}
+
+	//Render in the Past, Interpolate Snapshots around Render Time
+	const double RenderTime = GetWorld()->GetTimeSeconds() - AimInterpolationDelay;
+
+	const FAimSnapshot& NewestSnapshot = AimSnapshots.Last();
+	if (RenderTime >= NewestSnapshot.Time || AimSnapshots.Num() == 1)
+	{
+		return FRotator(NewestSnapshot.Pitch, NewestSnapshot.Yaw, 0.0f);
+	}
+
+	for (int32 Index = AimSnapshots.Num() - 1; Index > 0; --Index)
+	{
+		const FAimSnapshot& From = AimSnapshots[Index - 1];
+		const FAimSnapshot& To = AimSnapshots[Index];
+		if (RenderTime < From.Time)
+		{
+			continue;
+		}
+
+		const float Alpha = static_cast<float>(FMath::Clamp((RenderTime - From.Time) / FMath::Max(To.Time - From.Time, UE_KINDA_SMALL_NUMBER), 0.0, 1.0));
+
+		//Shortest Way, Yaw 179 to -179 is 2 Degree
+		const float Pitch = From.Pitch + FRotator::NormalizeAxis(To.Pitch - From.Pitch) * Alpha;
+		const float Yaw = From.Yaw + FRotator::NormalizeAxis(To.Yaw - From.Yaw) * Alpha;
+
+		return FRotator(Pitch, FRotator::NormalizeAxis(Yaw), 0.0f);
+	}
+
+	//Render Time is Older than Buffer
+	const FAimSnapshot& OldestSnapshot = AimSnapshots[0];
+	return FRotator(OldestSnapshot.Pitch, OldestSnapshot.Yaw, 0.0f);
 }
 
 
@@ -496,43 +1072,43 @@ void AFHProjectCharacter::SetupPlayerInputComponent(class UInputComponent* Playe
 		EnhancedInputComponent->BindAction(LookAction, ETriggerEvent::Triggered, this, &AFHProjectCharacter::Look);
 
 		//Roll
-		EnhancedInputComponent->BindAction(RollAction, ETriggerEvent::Triggered, this, &AFHProjectCharacter::RollInput);
+		EnhancedInputComponent->BindAction(RollAction, ETriggerEvent::Started, this, &AFHProjectCharacter::RollInput);
 
 		//Sprint
-		EnhancedInputComponent->BindAction(SprintAction, ETriggerEvent::Triggered, this, &AFHProjectCharacter::SprintInput);
+		EnhancedInputComponent->BindAction(SprintAction, ETriggerEvent::Started, this, &AFHProjectCharacter::SprintInput);
 		EnhancedInputComponent->BindAction(SprintAction, ETriggerEvent::Completed, this, &AFHProjectCharacter::StopSprintInput);
 
 		//Crouch
-		EnhancedInputComponent->BindAction(CrouchAction, ETriggerEvent::Triggered, this, &AFHProjectCharacter::CrouchInput);
+		EnhancedInputComponent->BindAction(CrouchAction, ETriggerEvent::Started, this, &AFHProjectCharacter::CrouchInput);
 		EnhancedInputComponent->BindAction(CrouchAction, ETriggerEvent::Completed, this, &AFHProjectCharacter::StopCrouchInput);
 
 		//Get Item
-		EnhancedInputComponent->BindAction(GetItemAction, ETriggerEvent::Triggered, this, &AFHProjectCharacter::GetItemInput);
+		EnhancedInputComponent->BindAction(GetItemAction, ETriggerEvent::Started, this, &AFHProjectCharacter::GetItemInput);
 
 		//Drop Item
-		EnhancedInputComponent->BindAction(DropItemAction, ETriggerEvent::Triggered, this, &AFHProjectCharacter::DropItemInput);
+		EnhancedInputComponent->BindAction(DropItemAction, ETriggerEvent::Started, this, &AFHProjectCharacter::DropItemInput);
 
 		//Attack - RightClick
-		EnhancedInputComponent->BindAction(RightClickAction, ETriggerEvent::Triggered, this, &AFHProjectCharacter::RightClickInput);
+		EnhancedInputComponent->BindAction(RightClickAction, ETriggerEvent::Started, this, &AFHProjectCharacter::RightClickInput);
 		EnhancedInputComponent->BindAction(RightClickAction, ETriggerEvent::Completed, this, &AFHProjectCharacter::StopRightClickInput);
 
 		//Attack - LeftClick
-		EnhancedInputComponent->BindAction(LeftClickAction, ETriggerEvent::Triggered, this, &AFHProjectCharacter::LeftClickInput);
+		EnhancedInputComponent->BindAction(LeftClickAction, ETriggerEvent::Started, this, &AFHProjectCharacter::LeftClickInput);
 		EnhancedInputComponent->BindAction(LeftClickAction, ETriggerEvent::Completed, this, &AFHProjectCharacter::StopLeftClickInput);
 
 
 		//----------[ NumberKey Action ]----------
-		EnhancedInputComponent->BindAction(NumberKey1Action, ETriggerEvent::Triggered, this, &AFHProjectCharacter::NumberKey1Input);
+		EnhancedInputComponent->BindAction(NumberKey1Action, ETriggerEvent::Started, this, &AFHProjectCharacter::NumberKey1Input);
 
-		EnhancedInputComponent->BindAction(NumberKey2Action, ETriggerEvent::Triggered, this, &AFHProjectCharacter::NumberKey2Input);
+		EnhancedInputComponent->BindAction(NumberKey2Action, ETriggerEvent::Started, this, &AFHProjectCharacter::NumberKey2Input);
 
-		EnhancedInputComponent->BindAction(NumberKey3Action, ETriggerEvent::Triggered, this, &AFHProjectCharacter::NumberKey3Input);
+		EnhancedInputComponent->BindAction(NumberKey3Action, ETriggerEvent::Started, this, &AFHProjectCharacter::NumberKey3Input);
 
-		EnhancedInputComponent->BindAction(NumberKey4Action, ETriggerEvent::Triggered, this, &AFHProjectCharacter::NumberKey4Input);
+		EnhancedInputComponent->BindAction(NumberKey4Action, ETriggerEvent::Started, this, &AFHProjectCharacter::NumberKey4Input);
 
-		EnhancedInputComponent->BindAction(NumberKey5Action, ETriggerEvent::Triggered, this, &AFHProjectCharacter::NumberKey5Input);
+		EnhancedInputComponent->BindAction(NumberKey5Action, ETriggerEvent::Started, this, &AFHProjectCharacter::NumberKey5Input);
 
-		EnhancedInputComponent->BindAction(NumberKey6Action, ETriggerEvent::Triggered, this, &AFHProjectCharacter::NumberKey6Input);
+		EnhancedInputComponent->BindAction(NumberKey6Action, ETriggerEvent::Started, this, &AFHProjectCharacter::NumberKey6Input);
 
 	}
 
@@ -579,8 +1155,8 @@ void AFHProjectCharacter::RollInput(const FInputActionValue& Value)
 	//Roll Action Input
 	UE_LOG(LogClass, Warning, TEXT("RollInput"));
 
-	//Server
-	Req_DoRollMove();
+	//Sent to Server by FlushInputCommand
+	PressInputButton(FHInputButton::Roll);
 }
 
 void AFHProjectCharacter::SprintInput(const FInputActionValue& Value)
@@ -589,8 +1165,8 @@ void AFHProjectCharacter::SprintInput(const FInputActionValue& Value)
 	//If you want change Sprint Speed, Fix Value SetMaxWalkSpeed(here);
 	UE_LOG(LogClass, Warning, TEXT("SprintInput"));
 
-	//Server
-	Req_SetMaxWalkSpeed(750.0f);
+	//Sent to Server by FlushInputCommand, Held Sprint Send Nothing
+	PressInputButton(FHInputButton::Sprint);
 }
 
 void AFHProjectCharacter::StopSprintInput(const FInputActionValue& Value)
@@ -600,8 +1176,8 @@ void AFHProjectCharacter::StopSprintInput(const FInputActionValue& Value)
 	//And Check AFHProjectCharacter(), GetCharacterMovement()->MaxWalkSpeed = here;
 	UE_LOG(LogClass, Warning, TEXT("StopSprintInput"));
 
-	//Server
-	Req_SetMaxWalkSpeed(500.0f);
+	//Sent to Server by FlushInputCommand
+	ReleaseInputButton(FHInputButton::Sprint);
 }
 
 void AFHProjectCharacter::CrouchInput(const FInputActionValue& Value)
@@ -664,8 +1240,8 @@ void AFHProjectCharacter::DropItemInput(const FInputActionValue& Value)
 	//Drop Item Action Input
 	UE_LOG(LogClass, Warning, TEXT("DropItemInput"));
 
-	//Server
-	Req_DropItem();
+	//Sent to Server by FlushInputCommand
+	PressInputButton(FHInputButton::DropItem);
 }
 
 void AFHProjectCharacter::RightClickInput(const FInputActionValue& Value)
@@ -681,9 +1257,9 @@ void AFHProjectCharacter::RightClickInput(const FInputActionValue& Value)
 		return;
 	}
 
-	//Server
+	//Sent to Server by FlushInputCommand
 	//IsPressed is true
-	Req_RightClickAttack(true);
+	PressInputButton(FHInputButton::RightClick);
 }
 
 void AFHProjectCharacter::StopRightClickInput(const FInputActionValue& Value)
@@ -699,9 +1275,9 @@ void AFHProjectCharacter::StopRightClickInput(const FInputActionValue& Value)
 		return;
 	}
 
-	//Server
+	//Sent to Server by FlushInputCommand
 	//IsPressed is false
-	Req_RightClickAttack(false);
+	ReleaseInputButton(FHInputButton::RightClick);
 }
 
 void AFHProjectCharacter::LeftClickInput(const FInputActionValue& Value)
@@ -717,9 +1293,9 @@ void AFHProjectCharacter::LeftClickInput(const FInputActionValue& Value)
 		return;
 	}
 
-	//Server
+	//Sent to Server by FlushInputCommand
 	//IsPressed is true
-	Req_LeftClickAttack(true);
+	PressInputButton(FHInputButton::LeftClick);
 }
 
 void AFHProjectCharacter::StopLeftClickInput(const FInputActionValue& Value)
@@ -737,46 +1313,41 @@ void AFHProjectCharacter::StopLeftClickInput(const FInputActionValue& Value)
 
 	//UE_LOG(LogClass, Warning, TEXT("LeftClickCount :: %d"), LeftClickCount);
 
-	//Server
+	//Sent to Server by FlushInputCommand
 	//IsPressed is false
-	Req_LeftClickAttack(false);
+	ReleaseInputButton(FHInputButton::LeftClick);
 }
 
 void AFHProjectCharacter::NumberKey1Input(const FInputActionValue& Value)
 {
-	Req_Test(1);
+	//Sent to Server by FlushInputCommand
+	//Slot Index Start from 0
+	PendingInputCommand.SelectSlotIndex = 0;
 }
 
 void AFHProjectCharacter::NumberKey2Input(const FInputActionValue& Value)
 {
-
-	Req_Test(2);
+	PendingInputCommand.SelectSlotIndex = 1;
 }
 
 void AFHProjectCharacter::NumberKey3Input(const FInputActionValue& Value)
 {
-
-	Req_Test(3);
+	PendingInputCommand.SelectSlotIndex = 2;
 }
 
 void AFHProjectCharacter::NumberKey4Input(const FInputActionValue& Value)
 {
-
-	Req_Test(4);
+	PendingInputCommand.SelectSlotIndex = 3;
 }
 
 void AFHProjectCharacter::NumberKey5Input(const FInputActionValue& Value)
 {
-
-	Req_Test(5);
-
+	PendingInputCommand.SelectSlotIndex = 4;
 }
 
 void AFHProjectCharacter::NumberKey6Input(const FInputActionValue& Value)
 {
-
-	Req_Test(6);
-
+	PendingInputCommand.SelectSlotIndex = 5;
 }
 
 
@@ -0,0 +1,209 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "HitboxComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "GameFramework/Character.h"
+
+
+UHitboxComponent::UHitboxComponent()
+{
+	//Updated by CombatWorldSubsystem, Component doesn't need Tick
+	PrimaryComponentTick.bCanEverTick = false;
+
+	ProbeHalfLength = 90.0f;
+	ProbeRadius = 4.0f;
+
+	//Default Value, Override in DefaultGame.ini
+	HeadDamageMultiplier = 2.0f;
+	TorsoDamageMultiplier = 1.0f;
+	ArmDamageMultiplier = 0.75f;
+	LegDamageMultiplier = 0.75f;
+
+	Mesh = nullptr;
+	bHitboxActive = false;
+	bBonesRefreshed = false;
+	bHitboxValid = false;
+	SavedAnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPose;
+
+	//Default Capsules, Bone X Axis is along Bone
+	//Right Side Bone Axis is Mirrored
+	auto AddCapsule = [this](const TCHAR* BoneName, EHitboxRegion Region, float Length, float Radius)
+	{
+		FHitboxCapsule& Capsule = Capsules.AddDefaulted_GetRef();
+		Capsule.BoneName = FName(BoneName);
+		Capsule.Region = Region;
+		Capsule.LocalEnd = FVector(Length, 0.0f, 0.0f);
+		Capsule.Radius = Radius;
+	};
+
+	AddCapsule(TEXT("head"), EHitboxRegion::Head, 18.0f, 11.0f);
+	AddCapsule(TEXT("spine_01"), EHitboxRegion::Torso, 30.0f, 18.0f);
+	AddCapsule(TEXT("spine_03"), EHitboxRegion::Torso, 25.0f, 18.0f);
+	AddCapsule(TEXT("upperarm_l"), EHitboxRegion::Arm, 28.0f, 7.0f);
+	AddCapsule(TEXT("upperarm_r"), EHitboxRegion::Arm, -28.0f, 7.0f);
+	AddCapsule(TEXT("lowerarm_l"), EHitboxRegion::Arm, 26.0f, 6.0f);
+	AddCapsule(TEXT("lowerarm_r"), EHitboxRegion::Arm, -26.0f, 6.0f);
+	AddCapsule(TEXT("thigh_l"), EHitboxRegion::Leg, 42.0f, 9.0f);
+	AddCapsule(TEXT("thigh_r"), EHitboxRegion::Leg, -42.0f, 9.0f);
+	AddCapsule(TEXT("calf_l"), EHitboxRegion::Leg, 40.0f, 7.0f);
+	AddCapsule(TEXT("calf_r"), EHitboxRegion::Leg, -40.0f, 7.0f);
+}
+
+void UHitboxComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	ACharacter* OwnerCharacter = Cast<ACharacter>(GetOwner());
+	Mesh = OwnerCharacter != nullptr ? OwnerCharacter->GetMesh() : nullptr;
+
+	//Resolve Bone Index Once, Capsule of Missing Bone is not Packed
+	BoneIndices.Reset();
+	Regions.Reset();
+	LocalStarts.Reset();
+	LocalEnds.Reset();
+	Radii.Reset();
+
+	if (Mesh == nullptr)
+	{
+		UE_LOG(LogClass, Warning, TEXT("UHitboxComponent::BeginPlay::Mesh == nullptr"));
+		return;
+	}
+
+	for (const FHitboxCapsule& Capsule : Capsules)
+	{
+		const int32 BoneIndex = Mesh->GetBoneIndex(Capsule.BoneName);
+		if (BoneIndex == INDEX_NONE)
+		{
+			UE_LOG(LogClass, Warning, TEXT("UHitboxComponent::BeginPlay::Missing Bone :: %s"), *Capsule.BoneName.ToString());
+			continue;
+		}
+
+		BoneIndices.Add(BoneIndex);
+		Regions.Add(Capsule.Region);
+		LocalStarts.Add(FVector3f(Capsule.LocalStart));
+		LocalEnds.Add(FVector3f(Capsule.LocalEnd));
+		Radii.Add(Capsule.Radius);
+	}
+
+	WorldStarts.SetNumZeroed(Radii.Num());
+	WorldEnds.SetNumZeroed(Radii.Num());
+}
+
+void UHitboxComponent::SetHitboxActive(bool bNewActive)
+{
+	if (bHitboxActive == bNewActive || Mesh == nullptr)
+	{
+		return;
+	}
+
+	bHitboxActive = bNewActive;
+
+	if (bHitboxActive == true)
+	{
+		//Dedicated Server and Culled Character don't Refresh Bones, Force it While Active
+		SavedAnimTickOption = Mesh->VisibilityBasedAnimTickOption;
+		Mesh->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
+
+		//Tick Option Apply from Next Mesh Tick, Bone Transform is Valid after that Refresh
+		bBonesRefreshed = false;
+		Mesh->OnBoneTransformsFinalized.AddUniqueDynamic(this, &UHitboxComponent::OnBoneTransformsFinalized);
+	}
+	else
+	{
+		Mesh->OnBoneTransformsFinalized.RemoveDynamic(this, &UHitboxComponent::OnBoneTransformsFinalized);
+
+		//Significance may Changed Tick Option While Active, Keep it
+		if (Mesh->VisibilityBasedAnimTickOption == EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones)
+		{
+			Mesh->VisibilityBasedAnimTickOption = SavedAnimTickOption;
+		}
+
+		bBonesRefreshed = false;
+		bHitboxValid = false;
+	}
+}
+
+void UHitboxComponent::OnBoneTransformsFinalized()
+{
+	//One Refresh is Enough, Later Refresh Happen every Tick While Active
+	bBonesRefreshed = true;
+
+	if (Mesh != nullptr)
+	{
+		Mesh->OnBoneTransformsFinalized.RemoveDynamic(this, &UHitboxComponent::OnBoneTransformsFinalized);
+	}
+}
+
+void UHitboxComponent::UpdateHitboxes()
+{
+	//Bone Transform not Refreshed Yet, Region Fall Back to 1 until Next Update
+	if (bHitboxActive == false || bBonesRefreshed == false || Mesh == nullptr)
+	{
+		return;
+	}
+
+	for (int32 Index = 0; Index < BoneIndices.Num(); ++Index)
+	{
+		const FTransform BoneTransform = Mesh->GetBoneTransform(BoneIndices[Index]);
+		WorldStarts[Index] = FVector3f(BoneTransform.TransformPosition(FVector(LocalStarts[Index])));
+		WorldEnds[Index] = FVector3f(BoneTransform.TransformPosition(FVector(LocalEnds[Index])));
+	}
+
+	bHitboxValid = true;
+}
+
+float UHitboxComponent::ResolveDamageMultiplier(const FVector& HitLocation, const FVector& HitDirection, EHitboxRegion& OutRegion) const
+{
+	OutRegion = EHitboxRegion::None;
+
+	if (bHitboxValid == false || HitDirection.IsNearlyZero() == true)
+	{
+		return 1.0f;
+	}
+
+	const FVector ProbeStart = HitLocation - HitDirection * ProbeHalfLength;
+	const FVector ProbeEnd = HitLocation + HitDirection * ProbeHalfLength;
+
+	float NearestDistanceSquared = TNumericLimits<float>::Max();
+
+	for (int32 Index = 0; Index < Radii.Num(); ++Index)
+	{
+		FVector ProbePoint;
+		FVector CapsulePoint;
+		FMath::SegmentDistToSegmentSafe(ProbeStart, ProbeEnd, FVector(WorldStarts[Index]), FVector(WorldEnds[Index]), ProbePoint, CapsulePoint);
+
+		const float HitRadius = Radii[Index] + ProbeRadius;
+		if (FVector::DistSquared(ProbePoint, CapsulePoint) > HitRadius * HitRadius)
+		{
+			continue;
+		}
+
+		//Region Probe Enter First
+		const float DistanceSquared = FVector::DistSquared(ProbeStart, ProbePoint);
+		if (DistanceSquared < NearestDistanceSquared)
+		{
+			NearestDistanceSquared = DistanceSquared;
+			OutRegion = Regions[Index];
+		}
+	}
+
+	return GetRegionDamageMultiplier(OutRegion);
+}
+
+float UHitboxComponent::GetRegionDamageMultiplier(EHitboxRegion Region) const
+{
+	switch (Region)
+	{
+	case EHitboxRegion::Head:
+		return HeadDamageMultiplier;
+	case EHitboxRegion::Torso:
+		return TorsoDamageMultiplier;
+	case EHitboxRegion::Arm:
+		return ArmDamageMultiplier;
+	case EHitboxRegion::Leg:
+		return LegDamageMultiplier;
+	default:
+		return 1.0f;
+	}
+}
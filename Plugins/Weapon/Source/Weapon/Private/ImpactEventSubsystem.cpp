@@ -0,0 +1,156 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ImpactEventSubsystem.h"
+#include "BaseWeapon.h"
+#include "FHProjectCharacter.h"
+#include "MatchReplaySubsystem.h"
+#include "GameFramework/PlayerController.h"
+#include "UObject/CoreNet.h"
+#include "Engine/NetSerialization.h"
+#include "Engine/World.h"
+
+
+bool FImpactEvent::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	UObject* WeaponObj = Weapon;
+	bOutSuccess = Map->SerializeObject(Ar, ABaseWeapon::StaticClass(), WeaponObj);
+
+	//Same Quantize as FVector_NetQuantize
+	bOutSuccess &= SerializePackedVector<1, 24>(Location, Ar);
+
+	Rotation.SerializeCompressedShort(Ar);
+
+	if (Ar.IsLoading() == true)
+	{
+		Weapon = Cast<ABaseWeapon>(WeaponObj);
+	}
+
+	return true;
+}
+
+UImpactEventSubsystem::UImpactEventSubsystem()
+{
+	//Default Value, Override in DefaultGame.ini
+	ImpactCullDistance = 8000.0f;
+	MaxEventsPerBatch = 32;
+}
+
+bool UImpactEventSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UImpactEventSubsystem::Deinitialize()
+{
+	PendingImpacts.Reset();
+
+	Super::Deinitialize();
+}
+
+void UImpactEventSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (PendingImpacts.Num() == 0)
+	{
+		return;
+	}
+
+	FlushImpacts();
+
+	//Client RPC is not in Replay, Server Record Every Impact
+	if (UMatchReplaySubsystem* ReplaySubsystem = GetWorld()->GetSubsystem<UMatchReplaySubsystem>())
+	{
+		ReplaySubsystem->RecordImpacts(PendingImpacts);
+	}
+
+	PendingImpacts.Reset();
+}
+
+TStatId UImpactEventSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UImpactEventSubsystem, STATGROUP_Tickables);
+}
+
+void UImpactEventSubsystem::QueueImpact(ABaseWeapon* Weapon, const FVector& Location, const FRotator& Rotation)
+{
+	if (GetWorld()->GetNetMode() == NM_Client)
+	{
+		return;
+	}
+
+	FImpactEvent& Impact = PendingImpacts.AddDefaulted_GetRef();
+	Impact.Weapon = Weapon;
+	Impact.Location = Location;
+	Impact.Rotation = Rotation;
+}
+
+void UImpactEventSubsystem::FlushImpacts()
+{
+	const float CullDistanceSquared = FMath::Square(ImpactCullDistance);
+
+	TArray<FImpactEvent> Batch;
+	TArray<float> BatchDistances;
+
+	for (FConstPlayerControllerIterator Iterator = GetWorld()->GetPlayerControllerIterator(); Iterator; ++Iterator)
+	{
+		APlayerController* PlayerController = Iterator->Get();
+		if (PlayerController == nullptr)
+		{
+			continue;
+		}
+
+		//Character Receive Batch by Client RPC
+		AFHProjectCharacter* Character = Cast<AFHProjectCharacter>(PlayerController->GetPawn());
+		if (Character == nullptr)
+		{
+			continue;
+		}
+
+		FVector ViewLocation;
+		FRotator ViewRotation;
+		PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+		//Only Impacts near this Connection's View
+		Batch.Reset();
+		BatchDistances.Reset();
+		for (const FImpactEvent& Impact : PendingImpacts)
+		{
+			const float DistanceSquared = FVector::DistSquared(Impact.Location, ViewLocation);
+			if (DistanceSquared <= CullDistanceSquared)
+			{
+				Batch.Add(Impact);
+				BatchDistances.Add(DistanceSquared);
+			}
+		}
+
+		if (Batch.Num() == 0)
+		{
+			continue;
+		}
+
+		//Nearest First Always, Unreliable Batch Lost or Cut Keep Closest Impacts
+		TArray<int32> Order;
+		Order.Reserve(Batch.Num());
+		for (int32 Index = 0; Index < Batch.Num(); ++Index)
+		{
+			Order.Add(Index);
+		}
+
+		Order.Sort([&BatchDistances](int32 A, int32 B) { return BatchDistances[A] < BatchDistances[B]; });
+
+		//Too Many Impacts, Keep Nearest
+		const int32 SendCount = FMath::Min(Batch.Num(), MaxEventsPerBatch);
+		TArray<FImpactEvent> NearestBatch;
+		NearestBatch.Reserve(SendCount);
+		for (int32 Index = 0; Index < SendCount; ++Index)
+		{
+			NearestBatch.Add(Batch[Order[Index]]);
+		}
+
+		Batch = MoveTemp(NearestBatch);
+
+		Character->Res_ImpactEvents(Batch);
+	}
+}
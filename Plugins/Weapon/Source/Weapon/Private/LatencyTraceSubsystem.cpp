@@ -0,0 +1,335 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "LatencyTraceSubsystem.h"
+#include "Engine/World.h"
+#include "Engine/NetConnection.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+
+//Console Command
+static FAutoConsoleCommandWithWorld LatencyReportCommand(
+	TEXT("Weapon.Latency.Report"),
+	TEXT("Print p50, p95, p99 of every Attack Pipeline Stage"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const ULatencyTraceSubsystem* LatencySubsystem = World != nullptr ? World->GetSubsystem<ULatencyTraceSubsystem>() : nullptr)
+		{
+			LatencySubsystem->Report();
+		}
+	}));
+
+static FAutoConsoleCommandWithWorld LatencyResetCommand(
+	TEXT("Weapon.Latency.Reset"),
+	TEXT("Clear Attack Pipeline Latency Histograms"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (ULatencyTraceSubsystem* LatencySubsystem = World != nullptr ? World->GetSubsystem<ULatencyTraceSubsystem>() : nullptr)
+		{
+			LatencySubsystem->ResetHistograms();
+		}
+	}));
+
+static FAutoConsoleCommandWithWorld LatencyWriteCsvCommand(
+	TEXT("Weapon.Latency.WriteCsv"),
+	TEXT("Write Attack Pipeline Latency Percentiles to Saved/Profiling"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const ULatencyTraceSubsystem* LatencySubsystem = World != nullptr ? World->GetSubsystem<ULatencyTraceSubsystem>() : nullptr)
+		{
+			LatencySubsystem->WriteCsv();
+		}
+	}));
+
+
+//----------[ Histogram ]----------
+FLatencyHistogram::FLatencyHistogram()
+{
+	Buckets.SetNumZeroed(BucketCount);
+	TotalCount = 0;
+	TotalSeconds = 0.0;
+	MaxMicros = 0;
+}
+
+void FLatencyHistogram::Record(double Seconds)
+{
+	const uint64 Micros = static_cast<uint64>(FMath::Max(Seconds, 0.0) * 1.0e6);
+
+	Buckets[GetBucketIndex(Micros)] += 1;
+	TotalCount += 1;
+	TotalSeconds += FMath::Max(Seconds, 0.0);
+	MaxMicros = FMath::Max(MaxMicros, Micros);
+}
+
+void FLatencyHistogram::Reset()
+{
+	FMemory::Memzero(Buckets.GetData(), Buckets.Num() * sizeof(uint32));
+	TotalCount = 0;
+	TotalSeconds = 0.0;
+	MaxMicros = 0;
+}
+
+double FLatencyHistogram::GetPercentile(double Percentile) const
+{
+	if (TotalCount == 0)
+	{
+		return 0.0;
+	}
+
+	//Rank of Target Sample, 1 Based
+	const int64 TargetCount = FMath::Max<int64>(FMath::CeilToInt64(FMath::Clamp(Percentile, 0.0, 100.0) * 0.01 * TotalCount), 1);
+
+	int64 AccumulatedCount = 0;
+	for (int32 Index = 0; Index < BucketCount; ++Index)
+	{
+		AccumulatedCount += Buckets[Index];
+		if (AccumulatedCount >= TargetCount)
+		{
+			//Bucket Highest Value can be over Recorded Max
+			return FMath::Min(GetBucketHighestValue(Index), MaxMicros) * 1.0e-6;
+		}
+	}
+
+	return GetMax();
+}
+
+int32 FLatencyHistogram::GetBucketIndex(uint64 Micros)
+{
+	//First Octave is Linear
+	if (Micros < SubBucketCount)
+	{
+		return static_cast<int32>(Micros);
+	}
+
+	//Top Bits Select Sub Bucket in Octave
+	const int32 HighestBit = static_cast<int32>(FMath::FloorLog2_64(Micros));
+	const int32 Shift = HighestBit - SubBucketBits;
+	const int32 Octave = Shift + 1;
+	const int32 SubBucket = static_cast<int32>(Micros >> Shift) - SubBucketCount;
+
+	return FMath::Min(Octave * SubBucketCount + SubBucket, BucketCount - 1);
+}
+
+uint64 FLatencyHistogram::GetBucketHighestValue(int32 Index)
+{
+	const int32 Octave = Index / SubBucketCount;
+	const int32 SubBucket = Index % SubBucketCount;
+
+	if (Octave == 0)
+	{
+		return SubBucket;
+	}
+
+	const int32 Shift = Octave - 1;
+	const uint64 LowestValue = static_cast<uint64>(SubBucketCount + SubBucket) << Shift;
+
+	return LowestValue + (uint64(1) << Shift) - 1;
+}
+
+
+//----------[ Subsystem ]----------
+ULatencyTraceSubsystem::ULatencyTraceSubsystem()
+{
+	//Default Value, Override in DefaultGame.ini
+	bEnableLatencyTrace = true;
+	bWriteCsvOnEnd = true;
+	MaxTraceTime = 3.0f;
+}
+
+bool ULatencyTraceSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void ULatencyTraceSubsystem::Deinitialize()
+{
+	//World End is Match End
+	if (bWriteCsvOnEnd == true)
+	{
+		WriteCsv();
+	}
+
+	Traces.Reset();
+
+	Super::Deinitialize();
+}
+
+void ULatencyTraceSubsystem::RecordStage(ELatencyStage Stage, double Seconds)
+{
+	if (bEnableLatencyTrace == false)
+	{
+		return;
+	}
+
+	Histograms[static_cast<int32>(Stage)].Record(Seconds);
+}
+
+void ULatencyTraceSubsystem::BeginTrace(const AActor* Character, float ClickAge)
+{
+	if (bEnableLatencyTrace == false || Character == nullptr)
+	{
+		return;
+	}
+
+	//Client Server Time Estimate is Off by One Way Latency, not Used
+	//Click Age is Client Clock Only, Network Part is Half of Measured Round Trip, Asymmetric Route is not Seen
+	const UNetConnection* Connection = Character->GetNetConnection();
+	const double OneWayTime = Connection != nullptr ? Connection->AvgLag * 0.5 : 0.0;
+	const double Now = FPlatformTime::Seconds();
+	const double InputToServer = FMath::Max(static_cast<double>(ClickAge), 0.0) + OneWayTime;
+	RecordStage(ELatencyStage::InputToServer, InputToServer);
+
+	//Newer Click Replace Unfinished Trace
+	FLatencyTrace& Trace = Traces.FindOrAdd(FObjectKey(Character));
+	Trace.ClickTime = Now - InputToServer;
+	Trace.LastStampTime = Now;
+	Trace.LastStage = ELatencyStage::InputToServer;
+}
+
+void ULatencyTraceSubsystem::StampAttackStart(const AActor* Character)
+{
+	StampStage(Character, ELatencyStage::InputToServer, ELatencyStage::ServerToAttack);
+}
+
+void ULatencyTraceSubsystem::StampHitResolve(const AActor* Character)
+{
+	//Missed Window Resolve again, Damage Measure from Last Resolve
+	if (FLatencyTrace* Trace = Traces.Find(FObjectKey(Character)))
+	{
+		if (Trace->LastStage == ELatencyStage::AttackToHit)
+		{
+			Trace->LastStampTime = FPlatformTime::Seconds();
+			return;
+		}
+	}
+
+	StampStage(Character, ELatencyStage::ServerToAttack, ELatencyStage::AttackToHit);
+}
+
+void ULatencyTraceSubsystem::StampDamage(const AActor* Character)
+{
+	FLatencyTrace* Trace = Traces.Find(FObjectKey(Character));
+	if (Trace == nullptr || Trace->LastStage != ELatencyStage::AttackToHit)
+	{
+		return;
+	}
+
+	const double ClickTime = Trace->ClickTime;
+
+	StampStage(Character, ELatencyStage::AttackToHit, ELatencyStage::HitToDamage);
+	RecordStage(ELatencyStage::InputToDamage, FPlatformTime::Seconds() - ClickTime);
+
+	Traces.Remove(FObjectKey(Character));
+}
+
+void ULatencyTraceSubsystem::StampStage(const AActor* Character, ELatencyStage PreviousStage, ELatencyStage Stage)
+{
+	if (bEnableLatencyTrace == false || Character == nullptr)
+	{
+		return;
+	}
+
+	FLatencyTrace* Trace = Traces.Find(FObjectKey(Character));
+	if (Trace == nullptr || Trace->LastStage != PreviousStage)
+	{
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+
+	//Attack Missed or Cancelled, Trace never Reach Damage
+	if (Now - Trace->ClickTime > MaxTraceTime)
+	{
+		Traces.Remove(FObjectKey(Character));
+		return;
+	}
+
+	RecordStage(Stage, Now - Trace->LastStampTime);
+	Trace->LastStampTime = Now;
+	Trace->LastStage = Stage;
+}
+
+void ULatencyTraceSubsystem::Report() const
+{
+	UE_LOG(LogClass, Warning, TEXT("Latency::Report :: %s"), GetWorld()->GetNetMode() == NM_Client ? TEXT("Client") : TEXT("Server"));
+
+	for (int32 StageIndex = 0; StageIndex < static_cast<int32>(ELatencyStage::Count); ++StageIndex)
+	{
+		const FLatencyHistogram& Histogram = Histograms[StageIndex];
+		UE_LOG(LogClass, Warning, TEXT("Latency::%-16s Count %6lld, p50 %7.2fms, p95 %7.2fms, p99 %7.2fms, Max %7.2fms"),
+			GetStageName(static_cast<ELatencyStage>(StageIndex)),
+			Histogram.GetCount(),
+			Histogram.GetPercentile(50.0) * 1000.0,
+			Histogram.GetPercentile(95.0) * 1000.0,
+			Histogram.GetPercentile(99.0) * 1000.0,
+			Histogram.GetMax() * 1000.0);
+	}
+}
+
+FString ULatencyTraceSubsystem::WriteCsv() const
+{
+	bool bHasSample = false;
+	FString Csv = TEXT("Stage,Count,MeanMs,P50Ms,P95Ms,P99Ms,MaxMs\n");
+
+	for (int32 StageIndex = 0; StageIndex < static_cast<int32>(ELatencyStage::Count); ++StageIndex)
+	{
+		const FLatencyHistogram& Histogram = Histograms[StageIndex];
+		bHasSample |= Histogram.GetCount() > 0;
+
+		Csv += FString::Printf(TEXT("%s,%lld,%.3f,%.3f,%.3f,%.3f,%.3f\n"),
+			GetStageName(static_cast<ELatencyStage>(StageIndex)),
+			Histogram.GetCount(),
+			Histogram.GetMean() * 1000.0,
+			Histogram.GetPercentile(50.0) * 1000.0,
+			Histogram.GetPercentile(95.0) * 1000.0,
+			Histogram.GetPercentile(99.0) * 1000.0,
+			Histogram.GetMax() * 1000.0);
+	}
+
+	if (bHasSample == false)
+	{
+		return FString();
+	}
+
+	//Server and Client Write Different File
+	const TCHAR* NetModeName = GetWorld()->GetNetMode() == NM_Client ? TEXT("Client") : TEXT("Server");
+	const FString CsvPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Profiling"), FString::Printf(TEXT("Latency_%s_%s.csv"), NetModeName, *FDateTime::Now().ToString()));
+	FFileHelper::SaveStringToFile(Csv, *CsvPath);
+
+	UE_LOG(LogClass, Warning, TEXT("Latency::WriteCsv :: %s"), *CsvPath);
+
+	return CsvPath;
+}
+
+void ULatencyTraceSubsystem::ResetHistograms()
+{
+	for (FLatencyHistogram& Histogram : Histograms)
+	{
+		Histogram.Reset();
+	}
+
+	Traces.Reset();
+}
+
+const TCHAR* ULatencyTraceSubsystem::GetStageName(ELatencyStage Stage)
+{
+	switch (Stage)
+	{
+	case ELatencyStage::InputToSend:
+		return TEXT("InputToSend");
+	case ELatencyStage::InputToServer:
+		return TEXT("InputToServer");
+	case ELatencyStage::ServerToAttack:
+		return TEXT("ServerToAttack");
+	case ELatencyStage::AttackToHit:
+		return TEXT("AttackToHit");
+	case ELatencyStage::HitToDamage:
+		return TEXT("HitToDamage");
+	case ELatencyStage::InputToDamage:
+		return TEXT("InputToDamage");
+	default:
+		return TEXT("Unknown");
+	}
+}
@@ -0,0 +1,541 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "MatchReplaySubsystem.h"
+#include "ImpactEventSubsystem.h"
+#include "BaseWeapon.h"
+#include "Engine/DemoNetDriver.h"
+#include "Engine/GameInstance.h"
+#include "Engine/NetConnection.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Serialization/BitWriter.h"
+#include "Serialization/BitReader.h"
+
+
+//Console Command
+static FAutoConsoleCommandWithWorld ReplayReportCommand(
+	TEXT("Weapon.Replay.Report"),
+	TEXT("Print Replay Recording Cost per Frame and Replay Event Count"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const UMatchReplaySubsystem* ReplaySubsystem = World != nullptr ? World->GetSubsystem<UMatchReplaySubsystem>() : nullptr)
+		{
+			ReplaySubsystem->Report();
+		}
+	}));
+
+static FAutoConsoleCommandWithWorld ReplayResetCommand(
+	TEXT("Weapon.Replay.Reset"),
+	TEXT("Clear Replay Recording Cost Histogram"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (UMatchReplaySubsystem* ReplaySubsystem = World != nullptr ? World->GetSubsystem<UMatchReplaySubsystem>() : nullptr)
+		{
+			ReplaySubsystem->ResetCost();
+		}
+	}));
+
+
+UMatchReplaySubsystem::UMatchReplaySubsystem()
+{
+	//Default Value, Override in DefaultGame.ini
+	bRecordMatches = false;
+	RecordHz = 10.0f;
+	MinRecordHz = 2.0f;
+	CheckpointInterval = 30.0f;
+	CheckpointSaveMaxMSPerFrame = 2.0f;
+	bWriteCsvOnEnd = true;
+
+	FrameRecordSeconds = 0.0;
+	EventCount = 0;
+	EventBytes = 0;
+
+	PlaybackEventIndex = 0;
+	LastPlaybackTime = 0.0f;
+	bPlaybackEventsRequested = false;
+}
+
+bool UMatchReplaySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UMatchReplaySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	ReplayEventFunctionSet.Append(ReplayEventFunctions);
+}
+
+void UMatchReplaySubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	//Server Record, Replay Playback World don't Record again
+	//Config or Command Line Enable Recording for this Session
+	const bool bShouldRecord = bRecordMatches == true || FParse::Param(FCommandLine::Get(), TEXT("RecordMatch")) == true;
+	const ENetMode NetMode = InWorld.GetNetMode();
+	if (bShouldRecord == false || (NetMode != NM_DedicatedServer && NetMode != NM_ListenServer) || InWorld.IsPlayingReplay() == true)
+	{
+		return;
+	}
+
+	UGameInstance* GameInstance = InWorld.GetGameInstance();
+	if (GameInstance == nullptr)
+	{
+		UE_LOG(LogClass, Warning, TEXT("MatchReplay::GameInstance == nullptr"));
+		return;
+	}
+
+	ApplyDemoSettings();
+
+	ReplayName = FString::Printf(TEXT("Match_%s"), *FDateTime::Now().ToString());
+	GameInstance->StartRecordingReplay(ReplayName, ReplayName);
+
+	UE_LOG(LogClass, Warning, TEXT("MatchReplay::StartRecording :: %s"), *ReplayName);
+}
+
+void UMatchReplaySubsystem::Deinitialize()
+{
+	//World Cleanup Stop Demo, Only Write Cost Here
+	if (bWriteCsvOnEnd == true)
+	{
+		WriteCsv();
+	}
+
+	ReplayEventFunctionSet.Reset();
+	PlaybackEvents.Reset();
+
+	Super::Deinitialize();
+}
+
+void UMatchReplaySubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	UDemoNetDriver* DemoNetDriver = GetWorld()->GetDemoNetDriver();
+	if (DemoNetDriver != nullptr && DemoNetDriver->IsPlaying() == true)
+	{
+		TickPlayback(DemoNetDriver);
+		return;
+	}
+
+	if (IsRecording() == false)
+	{
+		FrameRecordSeconds = 0.0;
+		return;
+	}
+
+	//Demo Flush of Last Frame and Events of this Frame
+	FrameCostHistogram.Record(FrameRecordSeconds);
+	FrameRecordSeconds = 0.0;
+}
+
+TStatId UMatchReplaySubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UMatchReplaySubsystem, STATGROUP_Tickables);
+}
+
+bool UMatchReplaySubsystem::IsRecording() const
+{
+	const UDemoNetDriver* DemoNetDriver = GetWorld()->GetDemoNetDriver();
+	return DemoNetDriver != nullptr && DemoNetDriver->IsRecording() == true;
+}
+
+void UMatchReplaySubsystem::ApplyDemoSettings() const
+{
+	auto SetConsoleVariable = [](const TCHAR* Name, float Value)
+	{
+		if (IConsoleVariable* ConsoleVariable = IConsoleManager::Get().FindConsoleVariable(Name))
+		{
+			ConsoleVariable->Set(Value, ECVF_SetByCode);
+		}
+		else
+		{
+			UE_LOG(LogClass, Warning, TEXT("MatchReplay::ApplyDemoSettings::%s == nullptr"), Name);
+		}
+	};
+
+	//Demo Driver Clamp Actor's Net Update Frequency to this Range
+	SetConsoleVariable(TEXT("demo.RecordHz"), RecordHz);
+	SetConsoleVariable(TEXT("demo.MinRecordHz"), FMath::Min(MinRecordHz, RecordHz));
+	SetConsoleVariable(TEXT("demo.CheckpointUploadDelayInSeconds"), CheckpointInterval);
+	SetConsoleVariable(TEXT("demo.CheckpointSaveMaxMSPerFrameOverride"), CheckpointSaveMaxMSPerFrame);
+}
+
+void UMatchReplaySubsystem::RecordFunctionEvent(UDemoNetDriver* DemoNetDriver, AActor* Actor, UFunction* Function, void* Parameters)
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	UPackageMap* PackageMap = GetPackageMap(DemoNetDriver);
+	if (PackageMap == nullptr || Actor == nullptr)
+	{
+		return;
+	}
+
+	//Actor Guid is Same as Replay's Actor Channel
+	FBitWriter Writer(256, true);
+	UObject* ActorObj = Actor;
+	PackageMap->SerializeObject(Writer, AActor::StaticClass(), ActorObj);
+	SerializeParameters(Writer, PackageMap, Function, Parameters);
+
+	if (Writer.IsError() == true)
+	{
+		UE_LOG(LogClass, Warning, TEXT("MatchReplay::RecordFunctionEvent::%s Serialize Error"), *Function->GetName());
+		return;
+	}
+
+	const TArray<uint8> Data(Writer.GetData(), static_cast<int32>(Writer.GetNumBytes()));
+	DemoNetDriver->AddEvent(TEXT("Combat"), Function->GetName(), Data);
+
+	EventCount += 1;
+	EventBytes += Data.Num();
+	FrameRecordSeconds += FPlatformTime::Seconds() - StartTime;
+}
+
+void UMatchReplaySubsystem::RecordImpacts(const TArray<FImpactEvent>& Impacts)
+{
+	UDemoNetDriver* DemoNetDriver = GetWorld()->GetDemoNetDriver();
+	if (Impacts.Num() == 0 || DemoNetDriver == nullptr || DemoNetDriver->IsRecording() == false)
+	{
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	UPackageMap* PackageMap = GetPackageMap(DemoNetDriver);
+	if (PackageMap == nullptr)
+	{
+		return;
+	}
+
+	//Every Impact of this Frame in One Event, Same Quantize as Client Batch
+	FBitWriter Writer(256, true);
+	uint32 ImpactCount = Impacts.Num();
+	Writer.SerializeIntPacked(ImpactCount);
+
+	for (FImpactEvent Impact : Impacts)
+	{
+		bool bSuccess = true;
+		Impact.NetSerialize(Writer, PackageMap, bSuccess);
+	}
+
+	if (Writer.IsError() == true)
+	{
+		UE_LOG(LogClass, Warning, TEXT("MatchReplay::RecordImpacts::Serialize Error"));
+		return;
+	}
+
+	const TArray<uint8> Data(Writer.GetData(), static_cast<int32>(Writer.GetNumBytes()));
+	DemoNetDriver->AddEvent(TEXT("Combat"), TEXT("Impacts"), Data);
+
+	EventCount += 1;
+	EventBytes += Data.Num();
+	FrameRecordSeconds += FPlatformTime::Seconds() - StartTime;
+}
+
+void UMatchReplaySubsystem::RequestPlaybackEvents(UDemoNetDriver* DemoNetDriver)
+{
+	bPlaybackEventsRequested = true;
+	PlaybackEvents.Reset();
+	PlaybackEventIndex = 0;
+
+	//Streamer Callback can Arrive after World End
+	TWeakObjectPtr<UMatchReplaySubsystem> WeakThis(this);
+	TWeakObjectPtr<UDemoNetDriver> WeakDemoNetDriver(DemoNetDriver);
+
+	DemoNetDriver->EnumerateEvents(TEXT("Combat"), [WeakThis, WeakDemoNetDriver](const FEnumerateEventsResult& Result)
+	{
+		UMatchReplaySubsystem* ReplaySubsystem = WeakThis.Get();
+		UDemoNetDriver* PlaybackDriver = WeakDemoNetDriver.Get();
+		if (ReplaySubsystem == nullptr || PlaybackDriver == nullptr || Result.WasSuccessful() == false)
+		{
+			UE_LOG(LogClass, Warning, TEXT("MatchReplay::RequestPlaybackEvents::Enumerate Failed"));
+			return;
+		}
+
+		TArray<FReplayEventListItem> Items = Result.ReplayEventList.ReplayEvents;
+		Items.Sort([](const FReplayEventListItem& A, const FReplayEventListItem& B) { return A.Time1 < B.Time1; });
+
+		for (const FReplayEventListItem& Item : Items)
+		{
+			FPlaybackEvent& PlaybackEvent = ReplaySubsystem->PlaybackEvents.AddDefaulted_GetRef();
+			PlaybackEvent.EventName = Item.Metadata;
+			PlaybackEvent.Time = Item.Time1;
+		}
+
+		UE_LOG(LogClass, Warning, TEXT("MatchReplay::RequestPlaybackEvents :: %d Events"), Items.Num());
+
+		//Index is Stable, Array is not Changed after this
+		for (int32 EventIndex = 0; EventIndex < Items.Num(); ++EventIndex)
+		{
+			PlaybackDriver->RequestEventData(Items[EventIndex].ID, [WeakThis, EventIndex](const FRequestEventDataResult& DataResult)
+			{
+				UMatchReplaySubsystem* DataReplaySubsystem = WeakThis.Get();
+				if (DataReplaySubsystem == nullptr || DataReplaySubsystem->PlaybackEvents.IsValidIndex(EventIndex) == false)
+				{
+					return;
+				}
+
+				//Failed Event is Skipped, not Waited Forever
+				FPlaybackEvent& PlaybackEvent = DataReplaySubsystem->PlaybackEvents[EventIndex];
+				PlaybackEvent.Data = DataResult.WasSuccessful() == true ? DataResult.ReplayEventListItem : TArray<uint8>();
+				PlaybackEvent.bIsLoaded = true;
+			});
+		}
+	});
+}
+
+void UMatchReplaySubsystem::TickPlayback(UDemoNetDriver* DemoNetDriver)
+{
+	if (bPlaybackEventsRequested == false)
+	{
+		RequestPlaybackEvents(DemoNetDriver);
+	}
+
+	const float PlaybackTime = DemoNetDriver->GetDemoCurrentTime();
+	const uint32 PlaybackTimeMS = static_cast<uint32>(PlaybackTime * 1000.0f);
+
+	//Scrub Back, Replay Events from New Time
+	if (PlaybackTime < LastPlaybackTime)
+	{
+		PlaybackEventIndex = PlaybackEvents.IndexOfByPredicate([PlaybackTimeMS](const FPlaybackEvent& PlaybackEvent) { return PlaybackEvent.Time >= PlaybackTimeMS; });
+		PlaybackEventIndex = PlaybackEventIndex == INDEX_NONE ? PlaybackEvents.Num() : PlaybackEventIndex;
+	}
+
+	LastPlaybackTime = PlaybackTime;
+
+	//Fast Forward to Checkpoint Skip Cosmetic, Only Events at Play Speed are Shown
+	const bool bIsSkipping = DemoNetDriver->IsFastForwarding();
+
+	while (PlaybackEvents.IsValidIndex(PlaybackEventIndex) == true)
+	{
+		const FPlaybackEvent& PlaybackEvent = PlaybackEvents[PlaybackEventIndex];
+		if (PlaybackEvent.Time > PlaybackTimeMS)
+		{
+			break;
+		}
+
+		//Data not Arrived Yet, Keep Order and Wait
+		if (PlaybackEvent.bIsLoaded == false)
+		{
+			break;
+		}
+
+		if (bIsSkipping == false && PlaybackEvent.Data.Num() > 0)
+		{
+			DispatchPlaybackEvent(DemoNetDriver, PlaybackEvent.EventName, PlaybackEvent.Data);
+		}
+
+		PlaybackEventIndex += 1;
+	}
+}
+
+void UMatchReplaySubsystem::DispatchPlaybackEvent(UDemoNetDriver* DemoNetDriver, const FString& EventName, const TArray<uint8>& Data) const
+{
+	UPackageMap* PackageMap = GetPackageMap(DemoNetDriver);
+	if (PackageMap == nullptr)
+	{
+		return;
+	}
+
+	FBitReader Reader(const_cast<uint8*>(Data.GetData()), Data.Num() * 8);
+
+	//Same Batch Format as RecordImpacts
+	if (EventName == TEXT("Impacts"))
+	{
+		uint32 ImpactCount = 0;
+		Reader.SerializeIntPacked(ImpactCount);
+
+		for (uint32 ImpactIndex = 0; ImpactIndex < ImpactCount && Reader.IsError() == false; ++ImpactIndex)
+		{
+			FImpactEvent Impact;
+			bool bSuccess = true;
+			Impact.NetSerialize(Reader, PackageMap, bSuccess);
+
+			//Weapon not in Replay at this Time
+			if (IsValid(Impact.Weapon) == true)
+			{
+				Impact.Weapon->SpawnImpactEffect(Impact.Location, Impact.Rotation);
+			}
+		}
+
+		return;
+	}
+
+	UObject* ActorObj = nullptr;
+	PackageMap->SerializeObject(Reader, AActor::StaticClass(), ActorObj);
+	AActor* Actor = Cast<AActor>(ActorObj);
+	if (Actor == nullptr)
+	{
+		return;
+	}
+
+	UFunction* Function = Actor->FindFunction(FName(*EventName));
+	if (Function == nullptr || Function->HasAnyFunctionFlags(FUNC_NetMulticast) == false)
+	{
+		UE_LOG(LogClass, Warning, TEXT("MatchReplay::DispatchPlaybackEvent::%s not Multicast of %s"), *EventName, *Actor->GetClass()->GetName());
+		return;
+	}
+
+	uint8* Parameters = static_cast<uint8*>(FMemory_Alloca(Function->ParmsSize));
+	FMemory::Memzero(Parameters, Function->ParmsSize);
+	Function->InitializeStruct(Parameters);
+
+	SerializeParameters(Reader, PackageMap, Function, Parameters);
+
+	//Playback World is Client, Multicast Run its Implementation Locally like Received Rpc
+	if (Reader.IsError() == false)
+	{
+		Actor->ProcessEvent(Function, Parameters);
+	}
+	else
+	{
+		UE_LOG(LogClass, Warning, TEXT("MatchReplay::DispatchPlaybackEvent::%s Deserialize Error"), *EventName);
+	}
+
+	Function->DestroyStruct(Parameters);
+}
+
+void UMatchReplaySubsystem::SerializeParameters(FArchive& Ar, UPackageMap* PackageMap, const UStruct* Struct, void* Data)
+{
+	const bool bIsFunction = Struct->IsA<UFunction>();
+
+	for (TFieldIterator<FProperty> It(Struct); It; ++It)
+	{
+		FProperty* Property = *It;
+
+		//Function Struct has Return Value and Locals
+		if (bIsFunction == true && (Property->PropertyFlags & (CPF_Parm | CPF_ReturnParm)) != CPF_Parm)
+		{
+			continue;
+		}
+
+		if (Property->HasAnyPropertyFlags(CPF_RepSkip) == true)
+		{
+			continue;
+		}
+
+		for (int32 ArrayIndex = 0; ArrayIndex < Property->ArrayDim; ++ArrayIndex)
+		{
+			SerializeProperty(Ar, PackageMap, Property, Property->ContainerPtrToValuePtr<void>(Data, ArrayIndex));
+		}
+	}
+}
+
+void UMatchReplaySubsystem::SerializeProperty(FArchive& Ar, UPackageMap* PackageMap, FProperty* Property, void* Data)
+{
+	if (Ar.IsError() == true)
+	{
+		return;
+	}
+
+	//Dynamic Array, Element Count then every Element
+	if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+	{
+		//Corrupt Count can't Allocate Huge Array
+		constexpr uint32 MaxArrayNum = 2048;
+
+		FScriptArrayHelper ArrayHelper(ArrayProperty, Data);
+		uint32 ArrayNum = ArrayHelper.Num();
+		Ar.SerializeIntPacked(ArrayNum);
+
+		if (ArrayNum > MaxArrayNum)
+		{
+			Ar.SetError();
+			return;
+		}
+
+		if (Ar.IsLoading() == true)
+		{
+			ArrayHelper.Resize(ArrayNum);
+		}
+
+		for (int32 Index = 0; Index < ArrayHelper.Num(); ++Index)
+		{
+			SerializeProperty(Ar, PackageMap, ArrayProperty->Inner, ArrayHelper.GetRawPtr(Index));
+		}
+
+		return;
+	}
+
+	//Struct without Net Serializer, Serialize its Members
+	const FStructProperty* StructProperty = CastField<FStructProperty>(Property);
+	if (StructProperty != nullptr && (StructProperty->Struct->StructFlags & STRUCT_NetSerializeNative) == 0)
+	{
+		SerializeParameters(Ar, PackageMap, StructProperty->Struct, Data);
+		return;
+	}
+
+	Property->NetSerializeItem(Ar, PackageMap, Data);
+}
+
+UPackageMap* UMatchReplaySubsystem::GetPackageMap(const UDemoNetDriver* DemoNetDriver)
+{
+	//Playback Driver Read Guid by Server Connection, Same Guid as Recording
+	if (DemoNetDriver != nullptr && DemoNetDriver->IsPlaying() == true)
+	{
+		return DemoNetDriver->ServerConnection != nullptr ? DemoNetDriver->ServerConnection->PackageMap : nullptr;
+	}
+
+	//Recording Driver has One Client Connection
+	if (DemoNetDriver == nullptr || DemoNetDriver->ClientConnections.Num() == 0 || DemoNetDriver->ClientConnections[0] == nullptr)
+	{
+		return nullptr;
+	}
+
+	return DemoNetDriver->ClientConnections[0]->PackageMap;
+}
+
+void UMatchReplaySubsystem::Report() const
+{
+	UE_LOG(LogClass, Warning, TEXT("MatchReplay::Report :: %s, Recording %s"), *ReplayName, IsRecording() == true ? TEXT("true") : TEXT("false"));
+	UE_LOG(LogClass, Warning, TEXT("MatchReplay::FrameCost Frames %6lld, Mean %6.3fms, p50 %6.3fms, p95 %6.3fms, p99 %6.3fms, Max %6.3fms"),
+		FrameCostHistogram.GetCount(),
+		FrameCostHistogram.GetMean() * 1000.0,
+		FrameCostHistogram.GetPercentile(50.0) * 1000.0,
+		FrameCostHistogram.GetPercentile(95.0) * 1000.0,
+		FrameCostHistogram.GetPercentile(99.0) * 1000.0,
+		FrameCostHistogram.GetMax() * 1000.0);
+	UE_LOG(LogClass, Warning, TEXT("MatchReplay::Events Count %lld, Bytes %lld"), EventCount, EventBytes);
+}
+
+void UMatchReplaySubsystem::ResetCost()
+{
+	FrameCostHistogram.Reset();
+	FrameRecordSeconds = 0.0;
+	EventCount = 0;
+	EventBytes = 0;
+}
+
+FString UMatchReplaySubsystem::WriteCsv() const
+{
+	if (FrameCostHistogram.GetCount() == 0)
+	{
+		return FString();
+	}
+
+	FString Csv = TEXT("Replay,Frames,MeanMs,P50Ms,P95Ms,P99Ms,MaxMs,Events,EventBytes\n");
+	Csv += FString::Printf(TEXT("%s,%lld,%.3f,%.3f,%.3f,%.3f,%.3f,%lld,%lld\n"),
+		*ReplayName,
+		FrameCostHistogram.GetCount(),
+		FrameCostHistogram.GetMean() * 1000.0,
+		FrameCostHistogram.GetPercentile(50.0) * 1000.0,
+		FrameCostHistogram.GetPercentile(95.0) * 1000.0,
+		FrameCostHistogram.GetPercentile(99.0) * 1000.0,
+		FrameCostHistogram.GetMax() * 1000.0,
+		EventCount,
+		EventBytes);
+
+	const FString CsvPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Profiling"), FString::Printf(TEXT("Replay_Server_%s.csv"), *FDateTime::Now().ToString()));
+	FFileHelper::SaveStringToFile(Csv, *CsvPath);
+
+	UE_LOG(LogClass, Warning, TEXT("MatchReplay::WriteCsv :: %s"), *CsvPath);
+
+	return CsvPath;
+}
@@ -0,0 +1,303 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "NetFrequencySubsystem.h"
+#include "BaseWeapon.h"
+#include "FHProjectCharacter.h"
+#include "CombatWorldSubsystem.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+
+//Console Command
+static FAutoConsoleCommandWithWorld NetFrequencyReportCommand(
+	TEXT("Weapon.NetFrequency.Report"),
+	TEXT("Print Actor Count per Net Activity and Sum of Net Update Frequency"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const UNetFrequencySubsystem* FrequencySubsystem = World != nullptr ? World->GetSubsystem<UNetFrequencySubsystem>() : nullptr)
+		{
+			FrequencySubsystem->Report();
+		}
+	}));
+
+
+float FNetFrequencyRule::GetFrequency(ENetActivity Activity) const
+{
+	switch (Activity)
+	{
+	case ENetActivity::Combat:
+		return CombatFrequency;
+	case ENetActivity::Engaged:
+		return EngagedFrequency;
+	case ENetActivity::Resting:
+		return RestingFrequency;
+	default:
+		return IdleFrequency;
+	}
+}
+
+
+UNetFrequencySubsystem::UNetFrequencySubsystem()
+{
+	//Default Value, Override in DefaultGame.ini
+	UpdateInterval = 0.25f;
+	CombatHoldTime = 2.0f;
+	EngageRadius = 1000.0f;
+
+	UpdateElapsedTime = 0.0f;
+	FrequencyChangeCount = 0;
+}
+
+bool UNetFrequencySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UNetFrequencySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Collection.InitializeDependency<UCombatWorldSubsystem>();
+
+	Super::Initialize(Collection);
+
+	//Resolve Once, Register only Look Up
+	RuleClasses.Reset(ClassRules.Num());
+	for (const FNetFrequencyRule& Rule : ClassRules)
+	{
+		UClass* RuleClass = Rule.ActorClass.LoadSynchronous();
+		if (RuleClass == nullptr)
+		{
+			UE_LOG(LogClass, Warning, TEXT("NetFrequencySubsystem::Initialize :: Class not Found %s"), *Rule.ActorClass.ToString());
+		}
+
+		RuleClasses.Add(RuleClass);
+	}
+}
+
+void UNetFrequencySubsystem::Deinitialize()
+{
+	Actors.Reset();
+	RuleClasses.Reset();
+
+	Super::Deinitialize();
+}
+
+void UNetFrequencySubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	//Activity Change Slower than Frame, Evaluate at Interval
+	UpdateElapsedTime += DeltaTime;
+	if (UpdateElapsedTime < UpdateInterval)
+	{
+		return;
+	}
+	UpdateElapsedTime = 0.0f;
+
+	UpdateActivities();
+}
+
+TStatId UNetFrequencySubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UNetFrequencySubsystem, STATGROUP_Tickables);
+}
+
+void UNetFrequencySubsystem::RegisterActor(AActor* Actor)
+{
+	//Client doesn't Send, Nothing to Adapt
+	if (Actor == nullptr || Actor->HasAuthority() == false || GetWorld()->GetNetMode() == NM_Client)
+	{
+		return;
+	}
+
+	const int32 RuleIndex = FindRuleIndex(Actor->GetClass());
+	if (RuleIndex == INDEX_NONE || FindIndex(Actor) != INDEX_NONE)
+	{
+		return;
+	}
+
+	FNetFrequencyActor& Entry = Actors.AddDefaulted_GetRef();
+	Entry.Actor = Actor;
+	Entry.RuleIndex = RuleIndex;
+
+	//Start Idle, Next Update Raise if in Combat
+	Entry.Activity = ENetActivity::Count;
+	ApplyFrequency(Entry, ENetActivity::Idle);
+}
+
+void UNetFrequencySubsystem::UnregisterActor(AActor* Actor)
+{
+	const int32 Index = FindIndex(Actor);
+	if (Index != INDEX_NONE)
+	{
+		Actors.RemoveAtSwap(Index);
+	}
+}
+
+ENetActivity UNetFrequencySubsystem::GetActivity(const AActor* Actor) const
+{
+	const int32 Index = FindIndex(Actor);
+	return Index != INDEX_NONE ? Actors[Index].Activity : ENetActivity::Idle;
+}
+
+void UNetFrequencySubsystem::UpdateActivities()
+{
+	const double CurrentTime = GetWorld()->GetTimeSeconds();
+
+	//Remove Destroyed Actor, Not Unregistered by EndPlay
+	Actors.RemoveAllSwap([](const FNetFrequencyActor& Entry) { return Entry.Actor.IsValid() == false; });
+
+	//Character First, Held Weapon Follow Owner's Activity
+	TMap<const AActor*, ENetActivity> CharacterActivities;
+	for (FNetFrequencyActor& Entry : Actors)
+	{
+		if (Entry.Actor->IsA<AFHProjectCharacter>() == true)
+		{
+			const ENetActivity NewActivity = EvaluateCharacter(Entry, CurrentTime);
+			CharacterActivities.Add(Entry.Actor.Get(), NewActivity);
+			ApplyFrequency(Entry, NewActivity);
+		}
+	}
+
+	for (FNetFrequencyActor& Entry : Actors)
+	{
+		if (Entry.Actor->IsA<ABaseWeapon>() == true)
+		{
+			ApplyFrequency(Entry, EvaluateWeapon(Entry, CharacterActivities));
+		}
+	}
+}
+
+ENetActivity UNetFrequencySubsystem::EvaluateCharacter(FNetFrequencyActor& Entry, double CurrentTime) const
+{
+	AFHProjectCharacter* Character = CastChecked<AFHProjectCharacter>(Entry.Actor.Get());
+	UCombatWorldSubsystem* CombatSubsystem = GetWorld()->GetSubsystem<UCombatWorldSubsystem>();
+	if (CombatSubsystem == nullptr)
+	{
+		return ENetActivity::Idle;
+	}
+
+	//Roll and Hit React are Montage without Attack Phase
+	const bool bIsAttacking = CombatSubsystem->GetAttackPhase(Character) != EAttackPhase::None;
+	const bool bIsMontagePlaying = Character->GetMesh()->GetAnimInstance() != nullptr && Character->bIsMontagePlaying() == true;
+	if (bIsAttacking == true || bIsMontagePlaying == true)
+	{
+		Entry.LastCombatTime = CurrentTime;
+	}
+
+	if (CurrentTime - Entry.LastCombatTime <= CombatHoldTime)
+	{
+		return ENetActivity::Combat;
+	}
+
+	//Capsule Broadphase already Packed this Frame, Hit Include Self
+	TArray<FCapsuleBroadphaseHit> Hits;
+	const FVector Location = Character->GetActorLocation();
+	CombatSubsystem->QueryCapsules(Location, Location, EngageRadius, Hits);
+
+	const int32 SelfIndex = Character->GetCombatantIndex();
+	for (const FCapsuleBroadphaseHit& Hit : Hits)
+	{
+		if (Hit.Index != SelfIndex)
+		{
+			return ENetActivity::Engaged;
+		}
+	}
+
+	return ENetActivity::Idle;
+}
+
+ENetActivity UNetFrequencySubsystem::EvaluateWeapon(const FNetFrequencyActor& Entry, const TMap<const AActor*, ENetActivity>& CharacterActivities) const
+{
+	ABaseWeapon* Weapon = CastChecked<ABaseWeapon>(Entry.Actor.Get());
+
+	if (const ACharacter* OwnerCharacter = Weapon->GetOwnerCharacter())
+	{
+		const ENetActivity* OwnerActivity = CharacterActivities.Find(OwnerCharacter);
+		return OwnerActivity != nullptr ? *OwnerActivity : ENetActivity::Idle;
+	}
+
+	//Proxied Weapon is Dormant, Frequency only Matter When Woken
+	if (Weapon->IsProxied() == true)
+	{
+		return ENetActivity::Resting;
+	}
+
+	const bool bIsMoving = Weapon->StaticMesh != nullptr && Weapon->StaticMesh->IsSimulatingPhysics() == true && Weapon->StaticMesh->RigidBodyIsAwake() == true;
+	return bIsMoving == true ? ENetActivity::Idle : ENetActivity::Resting;
+}
+
+void UNetFrequencySubsystem::ApplyFrequency(FNetFrequencyActor& Entry, ENetActivity NewActivity)
+{
+	if (Entry.Activity == NewActivity)
+	{
+		return;
+	}
+
+	AActor* Actor = Entry.Actor.Get();
+	const FNetFrequencyRule& Rule = ClassRules[Entry.RuleIndex];
+	const float Frequency = FMath::Max(Rule.GetFrequency(NewActivity), 0.1f);
+
+	//Combat Start, Send Now instead of Waiting Idle Interval
+	const bool bIsRaised = Frequency > Actor->NetUpdateFrequency;
+
+	Actor->NetUpdateFrequency = Frequency;
+	Actor->MinNetUpdateFrequency = FMath::Min(Rule.MinNetUpdateFrequency, Frequency);
+
+	if (bIsRaised == true && NewActivity == ENetActivity::Combat)
+	{
+		Actor->ForceNetUpdate();
+	}
+
+	Entry.Activity = NewActivity;
+	FrequencyChangeCount += 1;
+}
+
+int32 UNetFrequencySubsystem::FindRuleIndex(const UClass* ActorClass) const
+{
+	int32 BestIndex = INDEX_NONE;
+	for (int32 RuleIndex = 0; RuleIndex < RuleClasses.Num(); ++RuleIndex)
+	{
+		const UClass* RuleClass = RuleClasses[RuleIndex];
+		if (RuleClass == nullptr || ActorClass->IsChildOf(RuleClass) == false)
+		{
+			continue;
+		}
+
+		//Child Class Rule Override Parent Class Rule
+		if (BestIndex == INDEX_NONE || RuleClass->IsChildOf(RuleClasses[BestIndex]) == true)
+		{
+			BestIndex = RuleIndex;
+		}
+	}
+
+	return BestIndex;
+}
+
+int32 UNetFrequencySubsystem::FindIndex(const AActor* Actor) const
+{
+	return Actors.IndexOfByPredicate([Actor](const FNetFrequencyActor& Entry) { return Entry.Actor.Get() == Actor; });
+}
+
+void UNetFrequencySubsystem::Report() const
+{
+	int32 Counts[static_cast<int32>(ENetActivity::Count)] = {};
+	float FrequencySum = 0.0f;
+
+	for (const FNetFrequencyActor& Entry : Actors)
+	{
+		if (const AActor* Actor = Entry.Actor.Get())
+		{
+			Counts[static_cast<int32>(Entry.Activity)] += 1;
+			FrequencySum += Actor->NetUpdateFrequency;
+		}
+	}
+
+	UE_LOG(LogClass, Warning, TEXT("NetFrequency::Report :: Actors %d, Frequency Sum %.1f Hz, Changes %lld"), Actors.Num(), FrequencySum, FrequencyChangeCount);
+	UE_LOG(LogClass, Warning, TEXT("NetFrequency::Combat %d, Engaged %d, Idle %d, Resting %d"),
+		Counts[static_cast<int32>(ENetActivity::Combat)],
+		Counts[static_cast<int32>(ENetActivity::Engaged)],
+		Counts[static_cast<int32>(ENetActivity::Idle)],
+		Counts[static_cast<int32>(ENetActivity::Resting)]);
+}
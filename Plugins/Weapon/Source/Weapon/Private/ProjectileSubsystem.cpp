@@ -0,0 +1,437 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ProjectileSubsystem.h"
+#include "BaseWeapon.h"
+#include "CombatWorldSubsystem.h"
+#include "WeaponProxySubsystem.h"
+#include "FHProjectCharacter.h"
+#include "HitboxComponent.h"
+#include "LatencyTraceSubsystem.h"
+#include "CombatEventSubsystem.h"
+#include "Async/ParallelFor.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/SceneComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/Controller.h"
+#include "Kismet/GameplayStatics.h"
+
+
+void FProjectileLaunchParams::Quantize()
+{
+	//FVector_NetQuantize is 1 Unit, FVector_NetQuantize10 is 0.1 Unit
+	Origin = FVector(FMath::RoundToDouble(Origin.X), FMath::RoundToDouble(Origin.Y), FMath::RoundToDouble(Origin.Z));
+	Velocity = FVector(FMath::RoundToDouble(Velocity.X * 10.0) / 10.0, FMath::RoundToDouble(Velocity.Y * 10.0) / 10.0, FMath::RoundToDouble(Velocity.Z * 10.0) / 10.0);
+}
+
+UProjectileSubsystem::UProjectileSubsystem()
+{
+	//Default Value, Override in DefaultGame.ini
+	MaxProjectiles = 1024;
+	MaxLifetime = 5.0f;
+	ParallelThreshold = 64;
+	MaxCatchUpTime = 0.25f;
+
+	NextProjectileId = 0;
+	VisualHostActor = nullptr;
+}
+
+bool UProjectileSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UProjectileSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	SweepDelegate.BindUObject(this, &UProjectileSubsystem::OnSweepCompleted);
+}
+
+void UProjectileSubsystem::Deinitialize()
+{
+	ProjectileIds.Reset();
+	Weapons.Reset();
+	Instigators.Reset();
+	Positions.Reset();
+	PreviousPositions.Reset();
+	SweepStartPositions.Reset();
+	Velocities.Reset();
+	GravityZs.Reset();
+	Drags.Reset();
+	Radii.Reset();
+	RemainingLifetimes.Reset();
+	Damages.Reset();
+	VisualPoolIndices.Reset();
+	VisualInstanceIndices.Reset();
+	IdToIndex.Reset();
+
+	VisualPools.Reset();
+	VisualHostActor = nullptr;
+
+	SweepDelegate.Unbind();
+
+	Super::Deinitialize();
+}
+
+void UProjectileSubsystem::IntegrateProjectile(FVector& Position, FVector& Velocity, float GravityZ, float Drag, float DeltaTime)
+{
+	//Linear Drag, Velocity First then Position
+	Velocity += (FVector(0.0, 0.0, GravityZ) - Velocity * Drag) * DeltaTime;
+	Position += Velocity * DeltaTime;
+}
+
+void UProjectileSubsystem::LaunchProjectile(ABaseWeapon* Weapon, const FProjectileLaunchParams& Params, float Damage, float CatchUpTime)
+{
+	if (IsValid(Weapon) == false)
+	{
+		return;
+	}
+
+	//Already Launched, Listen Server or Duplicated Params
+	if (IdToIndex.Contains(Params.ProjectileId) == true)
+	{
+		return;
+	}
+
+	//Full, Recycle Oldest Projectile as Miss, Every Launch still Report Result
+	if (ProjectileIds.Num() >= MaxProjectiles && ProjectileIds.Num() > 0)
+	{
+		UE_LOG(LogClass, Warning, TEXT("LaunchProjectile::ProjectileIds.Num >= MaxProjectiles, Recycle Oldest"));
+
+		//Swap Remove Break Launch Order, Oldest has Least Lifetime
+		int32 OldestIndex = 0;
+		for (int32 Index = 1; Index < ProjectileIds.Num(); ++Index)
+		{
+			if (RemainingLifetimes[Index] < RemainingLifetimes[OldestIndex])
+			{
+				OldestIndex = Index;
+			}
+		}
+
+		if (GetWorld()->GetNetMode() != NM_Client && IsValid(Weapons[OldestIndex]) == true)
+		{
+			Weapons[OldestIndex]->OnAttackTraceResult(false);
+		}
+
+		RemoveProjectile(OldestIndex);
+	}
+
+	FVector Position = Params.Origin;
+	FVector Velocity = Params.Velocity;
+	const float GravityZ = GetWorld()->GetGravityZ() * Weapon->GetProjectileGravityScale();
+	const float Drag = Weapon->GetProjectileDrag();
+
+	//Client Receive Params Late, Simulate Same Fixed Steps Forward
+	float Lifetime = MaxLifetime;
+	const UCombatWorldSubsystem* CombatSubsystem = GetWorld()->GetSubsystem<UCombatWorldSubsystem>();
+	if (CombatSubsystem != nullptr && CatchUpTime > 0.0f)
+	{
+		const float StepDeltaTime = CombatSubsystem->GetFixedDeltaTime();
+		const int32 CatchUpSteps = FMath::FloorToInt(FMath::Min(CatchUpTime, MaxCatchUpTime) / StepDeltaTime);
+		for (int32 Step = 0; Step < CatchUpSteps; ++Step)
+		{
+			IntegrateProjectile(Position, Velocity, GravityZ, Drag, StepDeltaTime);
+		}
+
+		Lifetime -= CatchUpSteps * StepDeltaTime;
+	}
+
+	const int32 Index = ProjectileIds.Add(Params.ProjectileId);
+	Weapons.Add(Weapon);
+	Instigators.Add(Weapon->GetOwnerCharacter());
+	Positions.Add(Position);
+	PreviousPositions.Add(Position);
+	//Catch Up Path is Swept in First Frame
+	SweepStartPositions.Add(Params.Origin);
+	Velocities.Add(Velocity);
+	GravityZs.Add(GravityZ);
+	Drags.Add(Drag);
+	Radii.Add(Weapon->GetProjectileRadius());
+	RemainingLifetimes.Add(Lifetime);
+	Damages.Add(Damage);
+
+	int32 PoolIndex = INDEX_NONE;
+	int32 InstanceIndex = INDEX_NONE;
+	AcquireVisual(Weapon->GetProjectileMesh(), PoolIndex, InstanceIndex);
+	VisualPoolIndices.Add(PoolIndex);
+	VisualInstanceIndices.Add(InstanceIndex);
+
+	IdToIndex.Add(Params.ProjectileId, Index);
+}
+
+void UProjectileSubsystem::FixedStep(float StepDeltaTime)
+{
+	const int32 ProjectileCount = ProjectileIds.Num();
+	if (ProjectileCount == 0)
+	{
+		return;
+	}
+
+	//Each Index Write Own Element Only, Safe in Worker Threads
+	const EParallelForFlags ParallelFlags = ProjectileCount < ParallelThreshold ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None;
+	ParallelFor(ProjectileCount, [this, StepDeltaTime](int32 Index)
+		{
+			PreviousPositions[Index] = Positions[Index];
+			IntegrateProjectile(Positions[Index], Velocities[Index], GravityZs[Index], Drags[Index], StepDeltaTime);
+			RemainingLifetimes[Index] -= StepDeltaTime;
+		}, ParallelFlags);
+
+	//Expired Projectile is Miss, Reverse for Swap Remove
+	for (int32 Index = ProjectileCount - 1; Index >= 0; --Index)
+	{
+		if (RemainingLifetimes[Index] > 0.0f)
+		{
+			continue;
+		}
+
+		if (GetWorld()->GetNetMode() != NM_Client && IsValid(Weapons[Index]) == true)
+		{
+			Weapons[Index]->OnAttackTraceResult(false);
+		}
+
+		RemoveProjectile(Index);
+	}
+}
+
+void UProjectileSubsystem::EndFrame(float InterpolationAlpha)
+{
+	if (ProjectileIds.Num() == 0)
+	{
+		return;
+	}
+
+	//Same Object Types as Weapon Trace
+	const FCollisionObjectQueryParams ObjectQueryParams = ABaseWeapon::GetAttackObjectQueryParams();
+
+	//One Async Sweep per Projectile per Frame, Engine Run Batch in Worker Threads
+	for (int32 Index = 0; Index < ProjectileIds.Num(); ++Index)
+	{
+		if (Positions[Index].Equals(SweepStartPositions[Index]) == true)
+		{
+			continue;
+		}
+
+		FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(ProjectileSweep), false);
+		QueryParams.AddIgnoredActor(Weapons[Index]);
+		QueryParams.AddIgnoredActor(Instigators[Index]);
+
+		GetWorld()->AsyncSweepByObjectType(EAsyncTraceType::Single, SweepStartPositions[Index], Positions[Index], FQuat::Identity, ObjectQueryParams, FCollisionShape::MakeSphere(Radii[Index]), QueryParams, &SweepDelegate, ProjectileIds[Index]);
+
+		SweepStartPositions[Index] = Positions[Index];
+	}
+
+	UpdateVisuals(InterpolationAlpha);
+}
+
+void UProjectileSubsystem::RemoveProjectile(int32 Index)
+{
+	ReleaseVisual(VisualPoolIndices[Index], VisualInstanceIndices[Index]);
+	IdToIndex.Remove(ProjectileIds[Index]);
+
+	//Swap Remove, Last Projectile Move to Removed Index
+	ProjectileIds.RemoveAtSwap(Index);
+	Weapons.RemoveAtSwap(Index);
+	Instigators.RemoveAtSwap(Index);
+	Positions.RemoveAtSwap(Index);
+	PreviousPositions.RemoveAtSwap(Index);
+	SweepStartPositions.RemoveAtSwap(Index);
+	Velocities.RemoveAtSwap(Index);
+	GravityZs.RemoveAtSwap(Index);
+	Drags.RemoveAtSwap(Index);
+	Radii.RemoveAtSwap(Index);
+	RemainingLifetimes.RemoveAtSwap(Index);
+	Damages.RemoveAtSwap(Index);
+	VisualPoolIndices.RemoveAtSwap(Index);
+	VisualInstanceIndices.RemoveAtSwap(Index);
+
+	if (ProjectileIds.IsValidIndex(Index) == true)
+	{
+		IdToIndex.Add(ProjectileIds[Index], Index);
+	}
+}
+
+void UProjectileSubsystem::OnSweepCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+{
+	//Projectile Removed before Result, Expired or Hit by Previous Sweep
+	const int32* Index = IdToIndex.Find(TraceDatum.UserData);
+	if (Index == nullptr)
+	{
+		return;
+	}
+
+	if (TraceDatum.OutHits.Num() == 0 || TraceDatum.OutHits[0].bBlockingHit == false)
+	{
+		return;
+	}
+
+	const int32 HitIndex = *Index;
+	ResolveHit(HitIndex, TraceDatum.OutHits[0]);
+	RemoveProjectile(HitIndex);
+}
+
+void UProjectileSubsystem::ResolveHit(int32 Index, const FHitResult& HitResult)
+{
+	//Client Projectile is Cosmetic, Server Send Impact by ImpactEventSubsystem
+	if (GetWorld()->GetNetMode() == NM_Client)
+	{
+		return;
+	}
+
+	ABaseWeapon* Weapon = Weapons[Index];
+	if (IsValid(Weapon) == false)
+	{
+		return;
+	}
+
+	AActor* HitTargetObj = HitResult.GetActor();
+
+	//Hit Proxy Instance, Promote to Weapon Actor and Push it
+	if (UWeaponProxySubsystem* ProxySubsystem = GetWorld()->GetSubsystem<UWeaponProxySubsystem>())
+	{
+		if (ABaseWeapon* HitProxyWeapon = ProxySubsystem->PromoteHitInstance(HitResult.GetComponent(), HitResult.Item))
+		{
+			HitProxyWeapon->StaticMesh->AddImpulse(Velocities[Index].GetSafeNormal() * ProxySubsystem->GetHitImpulse(), NAME_None, true);
+			HitTargetObj = HitProxyWeapon;
+		}
+	}
+
+	Weapon->QueueImpactEvent(HitResult.ImpactPoint, Velocities[Index].Rotation());
+
+	if (HitTargetObj != nullptr)
+	{
+		const APawn* InstigatorPawn = Cast<APawn>(Instigators[Index]);
+		AController* InstigatorController = InstigatorPawn != nullptr ? InstigatorPawn->GetController() : nullptr;
+
+		//Region Multiplier When Target Hitbox is Active
+		float Damage = Damages[Index];
+		float DamageMultiplier = 1.0f;
+		EHitboxRegion HitRegion = EHitboxRegion::None;
+		if (const AFHProjectCharacter* HitCharacter = Cast<AFHProjectCharacter>(HitTargetObj))
+		{
+			if (const UHitboxComponent* Hitbox = HitCharacter->GetHitboxComponent())
+			{
+				DamageMultiplier = Hitbox->ResolveDamageMultiplier(HitResult.ImpactPoint, Velocities[Index].GetSafeNormal(), HitRegion);
+				Damage *= DamageMultiplier;
+			}
+		}
+
+		if (UCombatEventSubsystem* EventSubsystem = GetWorld()->GetSubsystem<UCombatEventSubsystem>())
+		{
+			EventSubsystem->Publish(ECombatEventType::Hit, Instigators[Index], HitTargetObj, HitResult.ImpactPoint, DamageMultiplier, static_cast<int32>(HitRegion));
+			EventSubsystem->Publish(ECombatEventType::Damage, Instigators[Index], HitTargetObj, HitResult.ImpactPoint, Damage, static_cast<int32>(HitRegion));
+		}
+
+		//Flight Time is Attack to Hit Stage
+		if (ULatencyTraceSubsystem* LatencySubsystem = GetWorld()->GetSubsystem<ULatencyTraceSubsystem>())
+		{
+			LatencySubsystem->StampHitResolve(Instigators[Index]);
+			LatencySubsystem->StampDamage(Instigators[Index]);
+		}
+
+		UE_LOG(LogClass, Warning, TEXT("ResolveHit::Hit Actor :: %s"), *HitTargetObj->GetName());
+		UGameplayStatics::ApplyDamage(HitTargetObj, Damage, InstigatorController, Weapon, UDamageType::StaticClass());
+	}
+
+	Weapon->OnAttackTraceResult(true);
+}
+
+bool UProjectileSubsystem::AcquireVisual(UStaticMesh* Mesh, int32& OutPoolIndex, int32& OutInstanceIndex)
+{
+	OutPoolIndex = INDEX_NONE;
+	OutInstanceIndex = INDEX_NONE;
+
+	//Dedicated Server don't Draw Projectile
+	if (Mesh == nullptr || GetWorld()->GetNetMode() == NM_DedicatedServer)
+	{
+		return false;
+	}
+
+	OutPoolIndex = VisualPools.IndexOfByPredicate([Mesh](const FProjectileVisualPool& Pool) { return Pool.Mesh == Mesh; });
+	if (OutPoolIndex == INDEX_NONE)
+	{
+		//One Host Actor for every Pool, not Replicated
+		if (VisualHostActor == nullptr)
+		{
+			FActorSpawnParameters SpawnParameters;
+			SpawnParameters.ObjectFlags |= RF_Transient;
+			VisualHostActor = GetWorld()->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParameters);
+
+			USceneComponent* RootComponent = NewObject<USceneComponent>(VisualHostActor, TEXT("ProjectileRoot"));
+			VisualHostActor->SetRootComponent(RootComponent);
+			RootComponent->RegisterComponent();
+		}
+
+		//Visual Only, Sweep is Collision
+		UInstancedStaticMeshComponent* Component = NewObject<UInstancedStaticMeshComponent>(VisualHostActor);
+		Component->SetStaticMesh(Mesh);
+		Component->SetMobility(EComponentMobility::Movable);
+		Component->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		Component->SetGenerateOverlapEvents(false);
+		Component->SetCastShadow(false);
+		Component->SetupAttachment(VisualHostActor->GetRootComponent());
+		Component->RegisterComponent();
+
+		FProjectileVisualPool& Pool = VisualPools.AddDefaulted_GetRef();
+		Pool.Mesh = Mesh;
+		Pool.Component = Component;
+
+		OutPoolIndex = VisualPools.Num() - 1;
+	}
+
+	FProjectileVisualPool& Pool = VisualPools[OutPoolIndex];
+	if (Pool.FreeInstances.Num() > 0)
+	{
+		OutInstanceIndex = Pool.FreeInstances.Pop(false);
+	}
+	else
+	{
+		//Zero Scale until First Visual Update
+		OutInstanceIndex = Pool.Component->AddInstance(FTransform(FQuat::Identity, FVector::ZeroVector, FVector::ZeroVector), true);
+	}
+
+	return true;
+}
+
+void UProjectileSubsystem::ReleaseVisual(int32 PoolIndex, int32 InstanceIndex)
+{
+	if (VisualPools.IsValidIndex(PoolIndex) == false || InstanceIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	//Keep Instance, Hide by Zero Scale and Reuse
+	FProjectileVisualPool& Pool = VisualPools[PoolIndex];
+	Pool.Component->UpdateInstanceTransform(InstanceIndex, FTransform(FQuat::Identity, FVector::ZeroVector, FVector::ZeroVector), true, true, true);
+	Pool.FreeInstances.Add(InstanceIndex);
+}
+
+void UProjectileSubsystem::UpdateVisuals(float InterpolationAlpha)
+{
+	if (VisualPools.Num() == 0)
+	{
+		return;
+	}
+
+	for (int32 Index = 0; Index < ProjectileIds.Num(); ++Index)
+	{
+		if (VisualPoolIndices[Index] == INDEX_NONE)
+		{
+			continue;
+		}
+
+		//Interpolate between Last and Next Fixed Step
+		const FVector VisualLocation = FMath::Lerp(PreviousPositions[Index], Positions[Index], InterpolationAlpha);
+		const FTransform VisualTransform(Velocities[Index].Rotation(), VisualLocation);
+
+		VisualPools[VisualPoolIndices[Index]].Component->UpdateInstanceTransform(VisualInstanceIndices[Index], VisualTransform, true, false, true);
+	}
+
+	//Render State Updated Once per Pool
+	for (FProjectileVisualPool& Pool : VisualPools)
+	{
+		Pool.Component->MarkRenderStateDirty();
+	}
+}
@@ -0,0 +1,180 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "RpcRateLimitSubsystem.h"
+#include "Engine/NetConnection.h"
+#include "Engine/ChildConnection.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+
+//Console Command, Run on Server
+static FAutoConsoleCommandWithWorld DumpRpcRejectionsCommand(
+	TEXT("Weapon.DumpRpcRejections"),
+	TEXT("Print Rejected Server RPC Count per RPC and Connection"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (World == nullptr)
+		{
+			return;
+		}
+
+		if (URpcRateLimitSubsystem* RateLimitSubsystem = World->GetSubsystem<URpcRateLimitSubsystem>())
+		{
+			RateLimitSubsystem->DumpRejections();
+		}
+	}));
+
+
+URpcRateLimitSubsystem::URpcRateLimitSubsystem()
+{
+	//Default Value, Override in DefaultGame.ini
+	DefaultRule.RpcName = NAME_None;
+	DefaultRule.TokensPerSecond = 30.0f;
+	DefaultRule.BurstSize = 30.0f;
+
+	PruneInterval = 10.0f;
+	LastPruneTime = 0.0;
+}
+
+bool URpcRateLimitSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void URpcRateLimitSubsystem::Deinitialize()
+{
+	Connections.Reset();
+	RpcRejections.Reset();
+
+	Super::Deinitialize();
+}
+
+bool URpcRateLimitSubsystem::ConsumeToken(const AActor* Caller, FName RpcName, bool bRecordRejection)
+{
+	FConnectionRpcState* State = FindOrAddConnectionState(Caller);
+	if (State == nullptr)
+	{
+		return true;
+	}
+
+	const FRpcRateLimitRule& Rule = FindRule(RpcName);
+	const double CurrentTime = GetWorld()->GetRealTimeSeconds();
+
+	//New Bucket Start Full
+	FRpcTokenBucket* Bucket = State->Buckets.Find(RpcName);
+	if (Bucket == nullptr)
+	{
+		Bucket = &State->Buckets.Add(RpcName);
+		Bucket->Tokens = Rule.BurstSize;
+		Bucket->LastRefillTime = CurrentTime;
+	}
+
+	//Refill by Elapsed Time
+	const float ElapsedTime = static_cast<float>(CurrentTime - Bucket->LastRefillTime);
+	Bucket->Tokens = FMath::Min(Bucket->Tokens + ElapsedTime * Rule.TokensPerSecond, Rule.BurstSize);
+	Bucket->LastRefillTime = CurrentTime;
+
+	if (Bucket->Tokens < 1.0f)
+	{
+		if (bRecordRejection == true)
+		{
+			State->Rejections.RateLimited += 1;
+			RpcRejections.FindOrAdd(RpcName).RateLimited += 1;
+		}
+		return false;
+	}
+
+	Bucket->Tokens -= 1.0f;
+	return true;
+}
+
+void URpcRateLimitSubsystem::RecordInvalidCall(const AActor* Caller, FName RpcName)
+{
+	UE_LOG(LogClass, Warning, TEXT("RecordInvalidCall::%s from %s"), *RpcName.ToString(), Caller != nullptr ? *Caller->GetName() : TEXT("None"));
+
+	RpcRejections.FindOrAdd(RpcName).Invalid += 1;
+
+	if (FConnectionRpcState* State = FindOrAddConnectionState(Caller))
+	{
+		State->Rejections.Invalid += 1;
+	}
+}
+
+void URpcRateLimitSubsystem::DumpRejections() const
+{
+	UE_LOG(LogClass, Warning, TEXT("DumpRejections - Start"));
+
+	for (const TPair<FName, FRpcRejectionCount>& Pair : RpcRejections)
+	{
+		UE_LOG(LogClass, Warning, TEXT("DumpRejections::%s RateLimited :: %d, Invalid :: %d"), *Pair.Key.ToString(), Pair.Value.RateLimited, Pair.Value.Invalid);
+	}
+
+	for (const FConnectionRpcState& State : Connections)
+	{
+		const UNetConnection* Connection = State.Connection.Get();
+		if (Connection == nullptr)
+		{
+			continue;
+		}
+
+		UE_LOG(LogClass, Warning, TEXT("DumpRejections::Connection %s RateLimited :: %d, Invalid :: %d"), *Connection->LowLevelGetRemoteAddress(true), State.Rejections.RateLimited, State.Rejections.Invalid);
+	}
+
+	UE_LOG(LogClass, Warning, TEXT("DumpRejections - End"));
+}
+
+const FRpcRateLimitRule& URpcRateLimitSubsystem::FindRule(FName RpcName) const
+{
+	for (const FRpcRateLimitRule& Rule : RateLimitRules)
+	{
+		if (Rule.RpcName == RpcName)
+		{
+			return Rule;
+		}
+	}
+
+	return DefaultRule;
+}
+
+URpcRateLimitSubsystem::FConnectionRpcState* URpcRateLimitSubsystem::FindOrAddConnectionState(const AActor* Caller)
+{
+	//Local Call has no Connection
+	UNetConnection* Connection = Caller != nullptr ? Caller->GetNetConnection() : nullptr;
+	if (Connection == nullptr)
+	{
+		return nullptr;
+	}
+
+	//Split Screen Player share Parent Connection
+	if (UChildConnection* ChildConnection = Cast<UChildConnection>(Connection))
+	{
+		Connection = ChildConnection->Parent;
+	}
+
+	PruneConnections();
+
+	for (FConnectionRpcState& State : Connections)
+	{
+		if (State.Connection.Get() == Connection)
+		{
+			return &State;
+		}
+	}
+
+	FConnectionRpcState& NewState = Connections.AddDefaulted_GetRef();
+	NewState.Connection = Connection;
+	return &NewState;
+}
+
+void URpcRateLimitSubsystem::PruneConnections()
+{
+	const double CurrentTime = GetWorld()->GetRealTimeSeconds();
+	if (CurrentTime - LastPruneTime < PruneInterval)
+	{
+		return;
+	}
+
+	LastPruneTime = CurrentTime;
+	Connections.RemoveAllSwap([](const FConnectionRpcState& State) { return State.Connection.IsValid() == false; });
+}
@@ -0,0 +1,385 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "WeaponNetTestSession.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
+
+#include "FHCharacter.h"
+#include "FHProjectCharacter.h"
+#include "AIBrainSubsystem.h"
+#include "BaseWeapon.h"
+#include "CombatEventSubsystem.h"
+#include "LatencyTraceSubsystem.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "Misc/App.h"
+
+/**
+ * NPC Frame Budget Test
+ * Dedicated Server in PIE Spawn N Armed NPCs around Player, NPCs See, Chase and Attack Player
+ * Brain Think Cost per Frame, Think Lag and Frame Time are Measured after every NPC is Armed and Registered
+ * Behavior is Checked Too, Engaged (Chase or Attack) Brains, Attack Inputs and Server Hits on Player
+ * Frame Time is Whole Editor Process (Server and Client Worlds), Upper Bound of Server Frame
+ * Config in [Weapon.AIBudgetTest] of DefaultGame.ini
+ */
+namespace AIBudgetTest
+{
+	static const TCHAR* ConfigSection = TEXT("Weapon.AIBudgetTest");
+
+	static FString FormatHistogram(const FLatencyHistogram& Histogram)
+	{
+		return FString::Printf(TEXT("Count %6lld, Mean %6.3fms, p50 %6.3fms, p95 %6.3fms, p99 %6.3fms, Max %6.3fms"),
+			Histogram.GetCount(),
+			Histogram.GetMean() * 1000.0,
+			Histogram.GetPercentile(50.0) * 1000.0,
+			Histogram.GetPercentile(95.0) * 1000.0,
+			Histogram.GetPercentile(99.0) * 1000.0,
+			Histogram.GetMax() * 1000.0);
+	}
+}
+
+using namespace AIBudgetTest;
+
+//Server Spawn NPCs in Grid in front of Player, Wait until every NPC has Brain and Weapon
+class FSpawnBudgetNPCsCommand : public IAutomationLatentCommand
+{
+public:
+	FSpawnBudgetNPCsCommand(FAutomationTestBase* InTest, const FString& InNPCClassPath, const FString& InWeaponClassPath, int32 InNumNPCs, float InSpacing, double InTimeout)
+		: Test(InTest)
+		, NPCClassPath(InNPCClassPath)
+		, WeaponClassPath(InWeaponClassPath)
+		, NumNPCs(InNumNPCs)
+		, Spacing(InSpacing)
+		, Timeout(InTimeout)
+		, bIsSpawned(false)
+	{
+	}
+
+	virtual bool Update() override;
+
+private:
+	bool SpawnNPCs(UWorld* ServerWorld);
+
+private:
+	FAutomationTestBase* Test;
+
+	FString NPCClassPath;
+
+	FString WeaponClassPath;
+
+	int32 NumNPCs;
+
+	float Spacing;
+
+	double Timeout;
+
+	bool bIsSpawned;
+};
+
+bool FSpawnBudgetNPCsCommand::Update()
+{
+	UWorld* ServerWorld = WeaponNetTest::GetServerWorld();
+	if (ServerWorld == nullptr || GetCurrentRunTime() > Timeout)
+	{
+		Test->AddError(TEXT("NPCs not Ready, Server World Missing or Timeout"));
+		return true;
+	}
+
+	if (bIsSpawned == false)
+	{
+		if (SpawnNPCs(ServerWorld) == false)
+		{
+			return true;
+		}
+
+		bIsSpawned = true;
+	}
+
+	const UAIBrainSubsystem* BrainSubsystem = ServerWorld->GetSubsystem<UAIBrainSubsystem>();
+	if (BrainSubsystem == nullptr || BrainSubsystem->GetBrainCount() < NumNPCs)
+	{
+		return false;
+	}
+
+	for (TActorIterator<AFHCharacter> It(ServerWorld); It; ++It)
+	{
+		if (It->GetEquipWeapon() == nullptr)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool FSpawnBudgetNPCsCommand::SpawnNPCs(UWorld* ServerWorld)
+{
+	UClass* NPCClass = LoadClass<AFHCharacter>(nullptr, *NPCClassPath);
+	UClass* WeaponClass = LoadClass<ABaseWeapon>(nullptr, *WeaponClassPath);
+	if (NPCClass == nullptr || WeaponClass == nullptr)
+	{
+		Test->AddError(FString::Printf(TEXT("NPC Class %s or Weapon Class %s not Found"), *NPCClassPath, *WeaponClassPath));
+		return false;
+	}
+
+	//Player is Every NPC's Target, NPCs Stand in Sight Radius
+	const AFHProjectCharacter* Player = nullptr;
+	for (TActorIterator<AFHProjectCharacter> It(ServerWorld); It; ++It)
+	{
+		if (It->IsPlayerControlled() == true)
+		{
+			Player = *It;
+			break;
+		}
+	}
+
+	if (Player == nullptr)
+	{
+		Test->AddError(TEXT("Player Character not Found on Server"));
+		return false;
+	}
+
+	const int32 Columns = FMath::Max(FMath::CeilToInt(FMath::Sqrt(static_cast<float>(NumNPCs))), 1);
+	const FVector Forward = Player->GetActorForwardVector().GetSafeNormal2D();
+	const FVector Right = FVector::CrossProduct(FVector::UpVector, Forward);
+	const FVector GridStart = Player->GetActorLocation() + Forward * Spacing * 2.0f - Right * Spacing * (Columns - 1) * 0.5f;
+
+	//Same Mesh and Anim as Player, Attack Montage need Anim Instance
+	const USkeletalMeshComponent* PlayerMesh = Player->GetMesh();
+
+	for (int32 Index = 0; Index < NumNPCs; ++Index)
+	{
+		const FVector Location = GridStart + Forward * Spacing * (Index / Columns) + Right * Spacing * (Index % Columns);
+		const FTransform Transform((-Forward).Rotation(), Location);
+
+		AFHCharacter* NPC = ServerWorld->SpawnActorDeferred<AFHCharacter>(NPCClass, Transform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn);
+		if (NPC == nullptr)
+		{
+			continue;
+		}
+
+		NPC->DefaultWeaponClass = WeaponClass;
+		if (NPC->GetMesh()->GetSkeletalMeshAsset() == nullptr)
+		{
+			NPC->GetMesh()->SetSkeletalMesh(PlayerMesh->GetSkeletalMeshAsset());
+			NPC->GetMesh()->SetAnimInstanceClass(PlayerMesh->GetAnimClass());
+		}
+
+		NPC->FinishSpawning(Transform);
+	}
+
+	return true;
+}
+
+//Run NPCs for Duration, Check Think Cost, Think Lag and Frame Time against Budget, and NPCs Actually Fight
+class FAIBudgetScenarioCommand : public IAutomationLatentCommand
+{
+public:
+	FAIBudgetScenarioCommand(FAutomationTestBase* InTest, int32 InNumNPCs, float InDuration, float InMaxThinkCostMS, float InMaxThinkLagMS, float InMaxFrameMS, float InMinEngagedRatio, int32 InMinHits)
+		: Test(InTest)
+		, NumNPCs(InNumNPCs)
+		, Duration(InDuration)
+		, MaxThinkCostMS(InMaxThinkCostMS)
+		, MaxThinkLagMS(InMaxThinkLagMS)
+		, MaxFrameMS(InMaxFrameMS)
+		, MinEngagedRatio(InMinEngagedRatio)
+		, MinHits(InMinHits)
+		, bIsStarted(false)
+		, MaxEngagedBrains(0)
+		, HitCount(0)
+	{
+	}
+
+	virtual ~FAIBudgetScenarioCommand()
+	{
+		StopListen();
+	}
+
+	virtual bool Update() override;
+
+private:
+	void OnServerCombatEvent(const FCombatEvent& Event);
+
+	void StopListen();
+
+private:
+	FAutomationTestBase* Test;
+
+	int32 NumNPCs;
+
+	float Duration;
+
+	float MaxThinkCostMS;
+
+	float MaxThinkLagMS;
+
+	float MaxFrameMS;
+
+	//Peak Chase and Attack Brains over NPC Count
+	float MinEngagedRatio;
+
+	//Server Hit Events on Player by NPC
+	int32 MinHits;
+
+	bool bIsStarted;
+
+	int32 MaxEngagedBrains;
+
+	int32 HitCount;
+
+	FLatencyHistogram FrameHistogram;
+
+	TWeakObjectPtr<UCombatEventSubsystem> ServerEventSubsystem;
+
+	FDelegateHandle CombatEventHandle;
+};
+
+void FAIBudgetScenarioCommand::OnServerCombatEvent(const FCombatEvent& Event)
+{
+	const AFHProjectCharacter* Target = Cast<AFHProjectCharacter>(Event.Target.Get());
+	if (Event.Type == ECombatEventType::Hit && Cast<AFHCharacter>(Event.Instigator.Get()) != nullptr && Target != nullptr && Target->IsPlayerControlled() == true)
+	{
+		HitCount += 1;
+	}
+}
+
+void FAIBudgetScenarioCommand::StopListen()
+{
+	if (UCombatEventSubsystem* EventSubsystem = ServerEventSubsystem.Get())
+	{
+		EventSubsystem->RemoveListener(CombatEventHandle);
+	}
+
+	ServerEventSubsystem.Reset();
+	CombatEventHandle.Reset();
+}
+
+bool FAIBudgetScenarioCommand::Update()
+{
+	UWorld* ServerWorld = WeaponNetTest::GetServerWorld();
+	UAIBrainSubsystem* BrainSubsystem = ServerWorld != nullptr ? ServerWorld->GetSubsystem<UAIBrainSubsystem>() : nullptr;
+	if (BrainSubsystem == nullptr)
+	{
+		Test->AddError(TEXT("Server World Missing, Scenario not Run"));
+		return true;
+	}
+
+	//Spawn and First Path Requests are not Steady State
+	if (bIsStarted == false)
+	{
+		BrainSubsystem->ResetStats();
+
+		//Listener Turn Publish On, Hit Events are Counted on Game Thread
+		if (UCombatEventSubsystem* EventSubsystem = ServerWorld->GetSubsystem<UCombatEventSubsystem>())
+		{
+			ServerEventSubsystem = EventSubsystem;
+			CombatEventHandle = EventSubsystem->AddListener(FOnCombatEvent::FDelegate::CreateRaw(this, &FAIBudgetScenarioCommand::OnServerCombatEvent));
+		}
+
+		bIsStarted = true;
+		return false;
+	}
+
+	FrameHistogram.Record(FApp::GetDeltaTime());
+
+	const int32 EngagedBrains = BrainSubsystem->GetBrainCount(EAIBrainState::Chase) + BrainSubsystem->GetBrainCount(EAIBrainState::Attack);
+	MaxEngagedBrains = FMath::Max(MaxEngagedBrains, EngagedBrains);
+
+	if (GetCurrentRunTime() < Duration)
+	{
+		return false;
+	}
+
+	StopListen();
+
+	const FLatencyHistogram& ThinkCost = BrainSubsystem->GetThinkCostHistogram();
+	const FLatencyHistogram& ThinkLag = BrainSubsystem->GetThinkLagHistogram();
+
+	Test->AddInfo(FString::Printf(TEXT("NPCs %d, Brains %d, Budget Exceeded Frames %lld"), NumNPCs, BrainSubsystem->GetBrainCount(), BrainSubsystem->GetBudgetExceededCount()));
+	Test->AddInfo(FString::Printf(TEXT("ThinkCost %s"), *FormatHistogram(ThinkCost)));
+	Test->AddInfo(FString::Printf(TEXT("ThinkLag  %s"), *FormatHistogram(ThinkLag)));
+	Test->AddInfo(FString::Printf(TEXT("Frame     %s"), *FormatHistogram(FrameHistogram)));
+	Test->AddInfo(FString::Printf(TEXT("Peak Engaged Brains %d, Attacks %lld, Hits on Player %d"), MaxEngagedBrains, BrainSubsystem->GetAttackCount(), HitCount));
+
+	if (BrainSubsystem->GetBrainCount() < NumNPCs)
+	{
+		Test->AddError(FString::Printf(TEXT("Brains %d, Expected %d, NPC Died or Unpossessed"), BrainSubsystem->GetBrainCount(), NumNPCs));
+	}
+
+	//Cheap Brain that never See or Fight is not Pass
+	const int32 MinEngagedBrains = FMath::CeilToInt(NumNPCs * MinEngagedRatio);
+	if (MaxEngagedBrains < MinEngagedBrains)
+	{
+		Test->AddError(FString::Printf(TEXT("Peak Engaged Brains %d, Expected at least %d"), MaxEngagedBrains, MinEngagedBrains));
+	}
+
+	if (BrainSubsystem->GetAttackCount() == 0)
+	{
+		Test->AddError(TEXT("No NPC Attacked"));
+	}
+
+	if (HitCount < MinHits)
+	{
+		Test->AddError(FString::Printf(TEXT("Hits on Player %d, Expected at least %d"), HitCount, MinHits));
+	}
+
+	//Budget Check is at Frame Start, Last Think may Run a Little over
+	const double ThinkCostP99 = ThinkCost.GetPercentile(99.0) * 1000.0;
+	if (ThinkCostP99 > MaxThinkCostMS)
+	{
+		Test->AddError(FString::Printf(TEXT("Think Cost p99 %.3fms over %.3fms"), ThinkCostP99, MaxThinkCostMS));
+	}
+
+	//Every Brain still Think Near its Interval, Time Slice is not Starving
+	const double ThinkLagP95 = ThinkLag.GetPercentile(95.0) * 1000.0;
+	if (ThinkLagP95 > MaxThinkLagMS)
+	{
+		Test->AddError(FString::Printf(TEXT("Think Lag p95 %.3fms over %.3fms"), ThinkLagP95, MaxThinkLagMS));
+	}
+
+	const double FrameP95 = FrameHistogram.GetPercentile(95.0) * 1000.0;
+	if (MaxFrameMS > 0.0f && FrameP95 > MaxFrameMS)
+	{
+		Test->AddError(FString::Printf(TEXT("Frame p95 %.3fms over %.3fms"), FrameP95, MaxFrameMS));
+	}
+
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWeaponAIBudgetTest, "Weapon.AI.Budget", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FWeaponAIBudgetTest::RunTest(const FString& Parameters)
+{
+	const FString MapName = WeaponNetTest::GetConfigString(ConfigSection, TEXT("Map"), TEXT("/Game/Level/TestLevel"));
+	const FString NPCClassPath = WeaponNetTest::GetConfigString(ConfigSection, TEXT("NPCClass"), TEXT("/Script/Weapon.FHCharacter"));
+	const FString WeaponClassPath = WeaponNetTest::GetConfigString(ConfigSection, TEXT("WeaponClass"), TEXT("/Weapon/BP_TestWeapon.BP_TestWeapon_C"));
+	const int32 NumNPCs = FMath::Max(WeaponNetTest::GetConfigInt(ConfigSection, TEXT("NumNPCs"), 200), 1);
+	const float Spacing = WeaponNetTest::GetConfigFloat(ConfigSection, TEXT("SpawnSpacing"), 150.0f);
+	const float Duration = FMath::Max(WeaponNetTest::GetConfigFloat(ConfigSection, TEXT("Duration"), 30.0f), 1.0f);
+	const float MaxThinkCostMS = WeaponNetTest::GetConfigFloat(ConfigSection, TEXT("MaxThinkCostMS"), 1.5f);
+	const float MaxThinkLagMS = WeaponNetTest::GetConfigFloat(ConfigSection, TEXT("MaxThinkLagMS"), 100.0f);
+	const float MaxFrameMS = WeaponNetTest::GetConfigFloat(ConfigSection, TEXT("MaxFrameMS"), 0.0f);
+	const float MinEngagedRatio = WeaponNetTest::GetConfigFloat(ConfigSection, TEXT("MinEngagedRatio"), 0.5f);
+	const int32 MinHits = WeaponNetTest::GetConfigInt(ConfigSection, TEXT("MinHits"), 1);
+
+	if (WeaponNetTest::LoadTestMap(MapName) == false)
+	{
+		AddError(FString::Printf(TEXT("Map Load Failed %s"), *MapName));
+		return false;
+	}
+
+	//One Client is Target of every NPC
+	WeaponNetTest::RequestNetPlaySession(1);
+
+	ADD_LATENT_AUTOMATION_COMMAND(FWaitForNetPlaySessionCommand(this, 1, 60.0));
+	ADD_LATENT_AUTOMATION_COMMAND(FSpawnBudgetNPCsCommand(this, NPCClassPath, WeaponClassPath, NumNPCs, Spacing, 30.0));
+	ADD_LATENT_AUTOMATION_COMMAND(FAIBudgetScenarioCommand(this, NumNPCs, Duration, MaxThinkCostMS, MaxThinkLagMS, MaxFrameMS, MinEngagedRatio, MinHits));
+	ADD_LATENT_AUTOMATION_COMMAND(FEndNetPlaySessionCommand());
+
+	return true;
+}
+
+#endif
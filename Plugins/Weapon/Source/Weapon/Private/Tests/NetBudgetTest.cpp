@@ -0,0 +1,684 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "WeaponNetTestSession.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
+
+#include "FHProjectCharacter.h"
+#include "FHInputCommand.h"
+#include "Engine/World.h"
+#include "Engine/NetDriver.h"
+#include "Engine/NetConnection.h"
+#include "Engine/ActorChannel.h"
+#include "Engine/NetworkObjectList.h"
+#include "Engine/NetSerialization.h"
+#include "Net/RepLayout.h"
+#include "UObject/CoreNet.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+/**
+ * Network Bandwidth Budget Test
+ * Dedicated Server and Clients in PIE Run Scripted Combat, Bytes and Count are Recorded per Class and RPC or Property
+ * RPC is Measured in Net Driver Send Hook with Receiving Connection's Package Map, No Hook in Game Code
+ * Property is Measured When Server Actually Replicate Actor, per Connection with its Replication Condition
+ * Fast Array (Inventory) Count Changed and Removed Items by Replication Key
+ * Budget is per Client Connection, Config in [Weapon.NetBudgetTest] of DefaultGame.ini
+ * CSV Breakdown in Saved/Profiling
+ */
+namespace NetBudgetTest
+{
+	static const TCHAR* ConfigSection = TEXT("Weapon.NetBudgetTest");
+
+	//Budget for One RPC or Replicated Property, 0 is No Limit
+	struct FNetBudgetRule
+	{
+		FName Name;
+
+		float MaxBytesPerSecond = 0.0f;
+
+		float MaxCountPerSecond = 0.0f;
+	};
+
+	struct FNetBudgetStat
+	{
+		FName ClassName;
+
+		FName Name;
+
+		bool bIsRpc = false;
+
+		int64 Count = 0;
+
+		int64 Bits = 0;
+	};
+
+	//Last Sent State of One Property to One Connection
+	struct FPropertyShadow
+	{
+		TArray<uint8> Bytes;
+
+		//Fast Array, Item Replication Key by Replication Id
+		int32 ArrayReplicationKey = INDEX_NONE;
+
+		TMap<int32, int32> ItemKeys;
+	};
+
+	//+BudgetRules=(Name="Req_InputCommand",MaxBytesPerSecond=200.0,MaxCountPerSecond=30.0)
+	static void LoadBudgetRules(TArray<FNetBudgetRule>& OutRules)
+	{
+		TArray<FString> Lines;
+		GConfig->GetArray(ConfigSection, TEXT("BudgetRules"), Lines, GGameIni);
+
+		for (const FString& Line : Lines)
+		{
+			FString Name;
+			if (FParse::Value(*Line, TEXT("Name="), Name) == false)
+			{
+				continue;
+			}
+
+			FNetBudgetRule& Rule = OutRules.AddDefaulted_GetRef();
+			Rule.Name = FName(*Name);
+			FParse::Value(*Line, TEXT("MaxBytesPerSecond="), Rule.MaxBytesPerSecond);
+			FParse::Value(*Line, TEXT("MaxCountPerSecond="), Rule.MaxCountPerSecond);
+		}
+	}
+
+	static bool ShouldReplicateToConnection(ELifetimeCondition Condition, bool bIsOwner, bool bIsInitial)
+	{
+		switch (Condition)
+		{
+		case COND_InitialOnly:
+			return bIsInitial;
+		case COND_OwnerOnly:
+		case COND_AutonomousOnly:
+		case COND_ReplayOrOwner:
+			return bIsOwner;
+		case COND_InitialOrOwner:
+			return bIsInitial == true || bIsOwner == true;
+		case COND_SkipOwner:
+		case COND_SimulatedOnly:
+		case COND_SimulatedOnlyNoReplay:
+		case COND_SimulatedOrPhysics:
+		case COND_SimulatedOrPhysicsNoReplay:
+		case COND_SkipReplay:
+			return bIsOwner == false;
+		case COND_ReplayOnly:
+		case COND_Never:
+			return false;
+		default:
+			return true;
+		}
+	}
+}
+
+using namespace NetBudgetTest;
+
+
+/**
+ * Record Sends of every PIE Net Driver While Alive
+ * Server and Clients are in this Process, One Recorder See every Send
+ */
+class FNetBudgetRecorder
+{
+public:
+	void Start();
+
+	void Stop();
+
+	//Server, Count Properties of Actors Replicated Since Last Sample
+	void SampleProperties();
+
+	//Write CSV, Add Error to Test for every Exceeded Budget
+	void Report(FAutomationTestBase* Test, float Seconds, int32 NumClients, const TArray<FNetBudgetRule>& Rules) const;
+
+private:
+	void OnSendRpc(AActor* Actor, UFunction* Function, void* Parameters, FOutParmRec* OutParms, FFrame* Stack, UObject* SubObject, bool& bBlockSendRPC);
+
+	void SampleActorProperties(AActor* Actor, UNetConnection* Connection, bool bIsOwner);
+
+	//Serialize Property like Replication, Return Bits
+	int64 SerializePropertyBits(const FProperty* Property, const void* Data, UPackageMap* PackageMap, TArray<uint8>& OutBytes) const;
+
+	//Fast Array Delta, Changed and Removed Items Since Shadow
+	int64 SerializeFastArrayBits(const FStructProperty* Property, const void* Data, UPackageMap* PackageMap, FPropertyShadow& Shadow) const;
+
+	const TMap<uint16, ELifetimeCondition>& GetConditions(const UClass* ActorClass);
+
+	FNetBudgetStat& FindOrAddStat(FName ClassName, FName Name, bool bIsRpc);
+
+private:
+	TArray<TWeakObjectPtr<UNetDriver>> BoundNetDrivers;
+
+	TMap<FString, FNetBudgetStat> Stats;
+
+	//Connection and Actor, Property Name
+	TMap<TTuple<FObjectKey, FObjectKey>, TMap<FName, FPropertyShadow>> Shadows;
+
+	//Actor's Last Replicate Time at Last Sample
+	TMap<FObjectKey, double> LastReplicateTimes;
+
+	TMap<const UClass*, TMap<uint16, ELifetimeCondition>> ClassConditions;
+};
+
+void FNetBudgetRecorder::Start()
+{
+	//Send Hook of Net Driver, Not Game Code, Server and every Client
+	UWorld* ServerWorld = WeaponNetTest::GetServerWorld();
+	TArray<UWorld*> Worlds;
+	WeaponNetTest::GetClientWorlds(Worlds);
+	Worlds.Add(ServerWorld);
+
+	for (UWorld* World : Worlds)
+	{
+		UNetDriver* NetDriver = World != nullptr ? World->GetNetDriver() : nullptr;
+		if (NetDriver == nullptr)
+		{
+			continue;
+		}
+
+		NetDriver->SendRPCDel.BindRaw(this, &FNetBudgetRecorder::OnSendRpc);
+		BoundNetDrivers.Add(NetDriver);
+	}
+}
+
+void FNetBudgetRecorder::Stop()
+{
+	for (const TWeakObjectPtr<UNetDriver>& NetDriver : BoundNetDrivers)
+	{
+		if (NetDriver.IsValid() == true)
+		{
+			NetDriver->SendRPCDel.Unbind();
+		}
+	}
+
+	BoundNetDrivers.Reset();
+}
+
+void FNetBudgetRecorder::OnSendRpc(AActor* Actor, UFunction* Function, void* Parameters, FOutParmRec* OutParms, FFrame* Stack, UObject* SubObject, bool& bBlockSendRPC)
+{
+	UNetDriver* NetDriver = Actor != nullptr ? Actor->GetNetDriver() : nullptr;
+	if (NetDriver == nullptr || Function == nullptr)
+	{
+		return;
+	}
+
+	//Client Send to Server, Server Send to Owner or every Client with Channel
+	TArray<UNetConnection*> Receivers;
+	if (NetDriver->ServerConnection != nullptr)
+	{
+		Receivers.Add(NetDriver->ServerConnection);
+	}
+	else if (Function->HasAnyFunctionFlags(FUNC_NetMulticast) == true)
+	{
+		for (UNetConnection* ClientConnection : NetDriver->ClientConnections)
+		{
+			if (ClientConnection != nullptr && ClientConnection->FindActorChannelRef(Actor) != nullptr)
+			{
+				Receivers.Add(ClientConnection);
+			}
+		}
+	}
+	else if (UNetConnection* OwnerConnection = Actor->GetNetConnection())
+	{
+		Receivers.Add(OwnerConnection);
+	}
+
+	TSharedPtr<FRepLayout> RepLayout = NetDriver->GetFunctionRepLayout(Function);
+	FNetBudgetStat& Stat = FindOrAddStat(Actor->GetClass()->GetFName(), Function->GetFName(), true);
+
+	for (UNetConnection* Connection : Receivers)
+	{
+		//Payload Written same as Engine Send, Object Reference Size Depend on Connection
+		int64 Bits = Function->ParmsSize * 8;
+		UActorChannel* Channel = Connection->FindActorChannelRef(Actor);
+		if (Channel != nullptr && RepLayout.IsValid() == true)
+		{
+			FNetBitWriter Writer(Connection->PackageMap, 0);
+			RepLayout->SendPropertiesForRPC(Function, Channel, Writer, Parameters);
+			Bits = Writer.GetNumBits();
+		}
+
+		Stat.Count += 1;
+		Stat.Bits += Bits;
+	}
+}
+
+void FNetBudgetRecorder::SampleProperties()
+{
+	UWorld* ServerWorld = WeaponNetTest::GetServerWorld();
+	UNetDriver* NetDriver = ServerWorld != nullptr ? ServerWorld->GetNetDriver() : nullptr;
+	if (NetDriver == nullptr)
+	{
+		return;
+	}
+
+	for (const TSharedPtr<FNetworkObjectInfo>& ObjectInfo : NetDriver->GetNetworkObjectList().GetActiveObjects())
+	{
+		AActor* Actor = ObjectInfo.IsValid() == true ? ObjectInfo->Actor : nullptr;
+		if (IsValid(Actor) == false)
+		{
+			continue;
+		}
+
+		//Only Actor Replicated Since Last Sample, Net Update Frequency and Dormancy Decide this
+		double& LastReplicateTime = LastReplicateTimes.FindOrAdd(FObjectKey(Actor), -1.0);
+		if (ObjectInfo->LastNetReplicateTime <= LastReplicateTime)
+		{
+			continue;
+		}
+
+		LastReplicateTime = ObjectInfo->LastNetReplicateTime;
+
+		UNetConnection* OwnerConnection = Actor->GetNetConnection();
+		for (UNetConnection* Connection : NetDriver->ClientConnections)
+		{
+			if (Connection != nullptr && Connection->FindActorChannelRef(Actor) != nullptr)
+			{
+				SampleActorProperties(Actor, Connection, Connection == OwnerConnection);
+			}
+		}
+	}
+}
+
+void FNetBudgetRecorder::SampleActorProperties(AActor* Actor, UNetConnection* Connection, bool bIsOwner)
+{
+	TMap<FName, FPropertyShadow>& ActorShadows = Shadows.FindOrAdd(MakeTuple(FObjectKey(Connection), FObjectKey(Actor)));
+	const TMap<uint16, ELifetimeCondition>& Conditions = GetConditions(Actor->GetClass());
+	const FName ClassName = Actor->GetClass()->GetFName();
+
+	//First Sample of Connection is Initial Bunch
+	const bool bIsInitial = ActorShadows.Num() == 0;
+
+	TArray<uint8> Bytes;
+
+	for (TFieldIterator<FProperty> It(Actor->GetClass()); It; ++It)
+	{
+		const FProperty* Property = *It;
+		if (Property->HasAnyPropertyFlags(CPF_Net) == false)
+		{
+			continue;
+		}
+
+		const ELifetimeCondition* Condition = Conditions.Find(Property->RepIndex);
+		if (ShouldReplicateToConnection(Condition != nullptr ? *Condition : COND_None, bIsOwner, bIsInitial) == false)
+		{
+			continue;
+		}
+
+		FPropertyShadow& Shadow = ActorShadows.FindOrAdd(Property->GetFName());
+
+		int64 Bits = 0;
+		const FStructProperty* StructProperty = CastField<FStructProperty>(Property);
+		if (StructProperty != nullptr && StructProperty->Struct->IsChildOf(FFastArraySerializer::StaticStruct()) == true)
+		{
+			Bits = SerializeFastArrayBits(StructProperty, Property->ContainerPtrToValuePtr<void>(Actor), Connection->PackageMap, Shadow);
+		}
+		else
+		{
+			Bytes.Reset();
+			for (int32 ArrayIndex = 0; ArrayIndex < Property->ArrayDim; ++ArrayIndex)
+			{
+				Bits += SerializePropertyBits(Property, Property->ContainerPtrToValuePtr<void>(Actor, ArrayIndex), Connection->PackageMap, Bytes);
+			}
+
+			//Only Changed Value is Replicated
+			if (Shadow.Bytes == Bytes)
+			{
+				continue;
+			}
+
+			Shadow.Bytes = Bytes;
+		}
+
+		if (Bits == 0)
+		{
+			continue;
+		}
+
+		FNetBudgetStat& Stat = FindOrAddStat(ClassName, Property->GetFName(), false);
+		Stat.Count += 1;
+		Stat.Bits += Bits;
+	}
+}
+
+int64 FNetBudgetRecorder::SerializePropertyBits(const FProperty* Property, const void* Data, UPackageMap* PackageMap, TArray<uint8>& OutBytes) const
+{
+	//Dynamic Array, Element Count then every Element
+	if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+	{
+		FScriptArrayHelper ArrayHelper(ArrayProperty, Data);
+		const int32 Num = ArrayHelper.Num();
+		OutBytes.Append(reinterpret_cast<const uint8*>(&Num), sizeof(Num));
+
+		int64 Bits = 16;
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			Bits += SerializePropertyBits(ArrayProperty->Inner, ArrayHelper.GetRawPtr(Index), PackageMap, OutBytes);
+		}
+
+		return Bits;
+	}
+
+	//Struct without NetSerialize Replicate Member by Member
+	const FStructProperty* StructProperty = CastField<FStructProperty>(Property);
+	if (StructProperty != nullptr && (StructProperty->Struct->StructFlags & STRUCT_NetSerializeNative) == 0)
+	{
+		int64 Bits = 0;
+		for (TFieldIterator<FProperty> It(StructProperty->Struct); It; ++It)
+		{
+			if (It->HasAnyPropertyFlags(CPF_RepSkip) == true)
+			{
+				continue;
+			}
+
+			for (int32 ArrayIndex = 0; ArrayIndex < It->ArrayDim; ++ArrayIndex)
+			{
+				Bits += SerializePropertyBits(*It, It->ContainerPtrToValuePtr<void>(Data, ArrayIndex), PackageMap, OutBytes);
+			}
+		}
+
+		return Bits;
+	}
+
+	FNetBitWriter Writer(PackageMap, 0);
+	Property->NetSerializeItem(Writer, PackageMap, const_cast<void*>(Data));
+	OutBytes.Append(*Writer.GetBuffer());
+
+	return Writer.GetNumBits();
+}
+
+int64 FNetBudgetRecorder::SerializeFastArrayBits(const FStructProperty* Property, const void* Data, UPackageMap* PackageMap, FPropertyShadow& Shadow) const
+{
+	//Array Key Change When any Item Marked Dirty or Removed
+	const FFastArraySerializer* Serializer = static_cast<const FFastArraySerializer*>(Data);
+	if (Serializer->ArrayReplicationKey == Shadow.ArrayReplicationKey)
+	{
+		return 0;
+	}
+
+	Shadow.ArrayReplicationKey = Serializer->ArrayReplicationKey;
+
+	//Array Key, Base Key, Removed Count and Changed Count
+	int64 Bits = 32 * 4;
+	TSet<int32> LiveIds;
+	TArray<uint8> UnusedBytes;
+
+	for (TFieldIterator<FArrayProperty> It(Property->Struct); It; ++It)
+	{
+		const FStructProperty* ItemProperty = CastField<FStructProperty>(It->Inner);
+		if (ItemProperty == nullptr || ItemProperty->Struct->IsChildOf(FFastArraySerializerItem::StaticStruct()) == false)
+		{
+			continue;
+		}
+
+		FScriptArrayHelper ArrayHelper(*It, It->ContainerPtrToValuePtr<void>(Data));
+		for (int32 Index = 0; Index < ArrayHelper.Num(); ++Index)
+		{
+			const uint8* ItemData = ArrayHelper.GetRawPtr(Index);
+			const FFastArraySerializerItem* Item = reinterpret_cast<const FFastArraySerializerItem*>(ItemData);
+			LiveIds.Add(Item->ReplicationID);
+
+			const int32* LastKey = Shadow.ItemKeys.Find(Item->ReplicationID);
+			if (LastKey != nullptr && *LastKey == Item->ReplicationKey)
+			{
+				continue;
+			}
+
+			Shadow.ItemKeys.Add(Item->ReplicationID, Item->ReplicationKey);
+
+			//Item Id, then Item Members
+			UnusedBytes.Reset();
+			Bits += 32 + SerializePropertyBits(ItemProperty, ItemData, PackageMap, UnusedBytes);
+		}
+	}
+
+	//Removed Item Send its Id
+	for (TMap<int32, int32>::TIterator It = Shadow.ItemKeys.CreateIterator(); It; ++It)
+	{
+		if (LiveIds.Contains(It.Key()) == false)
+		{
+			Bits += 32;
+			It.RemoveCurrent();
+		}
+	}
+
+	return Bits;
+}
+
+const TMap<uint16, ELifetimeCondition>& FNetBudgetRecorder::GetConditions(const UClass* ActorClass)
+{
+	TMap<uint16, ELifetimeCondition>* Conditions = ClassConditions.Find(ActorClass);
+	if (Conditions != nullptr)
+	{
+		return *Conditions;
+	}
+
+	Conditions = &ClassConditions.Add(ActorClass);
+
+	TArray<FLifetimeProperty> LifetimeProps;
+	ActorClass->GetDefaultObject<AActor>()->GetLifetimeReplicatedProps(LifetimeProps);
+	for (const FLifetimeProperty& LifetimeProp : LifetimeProps)
+	{
+		Conditions->Add(LifetimeProp.RepIndex, LifetimeProp.Condition);
+	}
+
+	return *Conditions;
+}
+
+FNetBudgetStat& FNetBudgetRecorder::FindOrAddStat(FName ClassName, FName Name, bool bIsRpc)
+{
+	const FString Key = ClassName.ToString() + TEXT(".") + Name.ToString();
+
+	FNetBudgetStat* Stat = Stats.Find(Key);
+	if (Stat == nullptr)
+	{
+		Stat = &Stats.Add(Key);
+		Stat->ClassName = ClassName;
+		Stat->Name = Name;
+		Stat->bIsRpc = bIsRpc;
+	}
+
+	return *Stat;
+}
+
+void FNetBudgetRecorder::Report(FAutomationTestBase* Test, float Seconds, int32 NumClients, const TArray<FNetBudgetRule>& Rules) const
+{
+	Seconds = FMath::Max(Seconds, UE_KINDA_SMALL_NUMBER);
+	const float ConnectionCount = static_cast<float>(FMath::Max(NumClients, 1));
+
+	//Biggest First
+	TArray<FNetBudgetStat> SortedStats;
+	Stats.GenerateValueArray(SortedStats);
+	SortedStats.Sort([](const FNetBudgetStat& A, const FNetBudgetStat& B) { return A.Bits > B.Bits; });
+
+	FString Csv = TEXT("Class,Name,Kind,Count,Bytes,CountPerSecondPerConnection,BytesPerSecondPerConnection,MaxCountPerSecond,MaxBytesPerSecond,Result\n");
+
+	for (const FNetBudgetStat& Stat : SortedStats)
+	{
+		const float Bytes = Stat.Bits / 8.0f;
+		const float CountPerSecond = Stat.Count / Seconds / ConnectionCount;
+		const float BytesPerSecond = Bytes / Seconds / ConnectionCount;
+
+		const FNetBudgetRule* Rule = Rules.FindByPredicate([&Stat](const FNetBudgetRule& Candidate) { return Candidate.Name == Stat.Name; });
+		const float MaxCountPerSecond = Rule != nullptr ? Rule->MaxCountPerSecond : 0.0f;
+		const float MaxBytesPerSecond = Rule != nullptr ? Rule->MaxBytesPerSecond : 0.0f;
+
+		const bool bIsExceeded = (MaxCountPerSecond > 0.0f && CountPerSecond > MaxCountPerSecond) || (MaxBytesPerSecond > 0.0f && BytesPerSecond > MaxBytesPerSecond);
+		if (bIsExceeded == true)
+		{
+			Test->AddError(FString::Printf(TEXT("Budget Exceeded %s.%s :: %.1f Count/s (Max %.1f), %.1f Bytes/s (Max %.1f)"), *Stat.ClassName.ToString(), *Stat.Name.ToString(), CountPerSecond, MaxCountPerSecond, BytesPerSecond, MaxBytesPerSecond));
+		}
+
+		Csv += FString::Printf(TEXT("%s,%s,%s,%lld,%.0f,%.2f,%.2f,%.2f,%.2f,%s\n"),
+			*Stat.ClassName.ToString(),
+			*Stat.Name.ToString(),
+			Stat.bIsRpc == true ? TEXT("RPC") : TEXT("Property"),
+			Stat.Count,
+			Bytes,
+			CountPerSecond,
+			BytesPerSecond,
+			MaxCountPerSecond,
+			MaxBytesPerSecond,
+			bIsExceeded == true ? TEXT("Exceeded") : TEXT("Ok"));
+	}
+
+	const FString CsvPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Profiling"), FString::Printf(TEXT("NetBudget_%s.csv"), *FDateTime::Now().ToString()));
+	FFileHelper::SaveStringToFile(Csv, *CsvPath);
+
+	Test->AddInfo(FString::Printf(TEXT("Net Budget CSV :: %s"), *CsvPath));
+}
+
+
+//Drive every Client's Character by Scripted Input, Record until Duration, then Report
+class FNetBudgetScenarioCommand : public IAutomationLatentCommand
+{
+public:
+	FNetBudgetScenarioCommand(FAutomationTestBase* InTest, int32 InNumClients, float InDuration, float InStepInterval)
+		: Test(InTest)
+		, NumClients(InNumClients)
+		, Duration(InDuration)
+		, StepInterval(InStepInterval)
+		, NextStepTime(0.0)
+		, ScenarioStep(0)
+		, bIsStarted(false)
+	{
+		LoadBudgetRules(Rules);
+	}
+
+	virtual ~FNetBudgetScenarioCommand()
+	{
+		Recorder.Stop();
+	}
+
+	virtual bool Update() override;
+
+private:
+	void TickScenario();
+
+private:
+	FAutomationTestBase* Test;
+
+	int32 NumClients;
+
+	float Duration;
+
+	float StepInterval;
+
+	double NextStepTime;
+
+	int32 ScenarioStep;
+
+	bool bIsStarted;
+
+	TArray<FNetBudgetRule> Rules;
+
+	FNetBudgetRecorder Recorder;
+};
+
+bool FNetBudgetScenarioCommand::Update()
+{
+	if (WeaponNetTest::GetServerWorld() == nullptr)
+	{
+		Test->AddError(TEXT("Server World Missing, Scenario not Run"));
+		return true;
+	}
+
+	if (bIsStarted == false)
+	{
+		Recorder.Start();
+		bIsStarted = true;
+	}
+
+	TickScenario();
+	Recorder.SampleProperties();
+
+	const double RunTime = GetCurrentRunTime();
+	if (RunTime < Duration)
+	{
+		return false;
+	}
+
+	Recorder.Stop();
+	Recorder.Report(Test, static_cast<float>(RunTime), NumClients, Rules);
+	return true;
+}
+
+void FNetBudgetScenarioCommand::TickScenario()
+{
+	//Same Input Loop every Run, Result is Comparable between Runs
+	static const TPair<uint8, bool> ScenarioSteps[] =
+	{
+		{ FHInputButton::Sprint, true },
+		{ FHInputButton::LeftClick, true },
+		{ FHInputButton::LeftClick, false },
+		{ FHInputButton::LeftClick, true },
+		{ FHInputButton::LeftClick, false },
+		{ FHInputButton::RightClick, true },
+		{ FHInputButton::RightClick, false },
+		{ FHInputButton::Sprint, false },
+	};
+
+	const bool bShouldStep = GetCurrentRunTime() >= NextStepTime;
+	const TPair<uint8, bool>& Step = ScenarioSteps[ScenarioStep % UE_ARRAY_COUNT(ScenarioSteps)];
+	if (bShouldStep == true)
+	{
+		NextStepTime = GetCurrentRunTime() + StepInterval;
+		ScenarioStep += 1;
+	}
+
+	TArray<UWorld*> ClientWorlds;
+	WeaponNetTest::GetClientWorlds(ClientWorlds);
+
+	for (UWorld* ClientWorld : ClientWorlds)
+	{
+		AFHProjectCharacter* Character = WeaponNetTest::GetLocalCharacter(ClientWorld);
+		if (Character == nullptr)
+		{
+			continue;
+		}
+
+		//Move toward Other Player, Keep Characters Relevant and Moving
+		if (const AFHProjectCharacter* Target = WeaponNetTest::FindNearestCharacter(Character))
+		{
+			Character->AddMovementInput((Target->GetActorLocation() - Character->GetActorLocation()).GetSafeNormal2D(), 1.0f);
+		}
+
+		if (bShouldStep == true)
+		{
+			Character->SimulateInputButton(Step.Key, Step.Value);
+		}
+	}
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWeaponNetBudgetTest, "Weapon.Network.Budget", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FWeaponNetBudgetTest::RunTest(const FString& Parameters)
+{
+	const FString MapName = WeaponNetTest::GetConfigString(ConfigSection, TEXT("Map"), TEXT("/Game/Level/TestLevel"));
+	const FString WeaponClassPath = WeaponNetTest::GetConfigString(ConfigSection, TEXT("WeaponClass"), TEXT("/Weapon/BP_TestWeapon.BP_TestWeapon_C"));
+	const int32 NumClients = FMath::Max(WeaponNetTest::GetConfigInt(ConfigSection, TEXT("NumClients"), 2), 1);
+	const float Duration = FMath::Max(WeaponNetTest::GetConfigFloat(ConfigSection, TEXT("Duration"), 30.0f), 1.0f);
+	const float StepInterval = WeaponNetTest::GetConfigFloat(ConfigSection, TEXT("ScenarioStepInterval"), 0.5f);
+
+	if (WeaponNetTest::LoadTestMap(MapName) == false)
+	{
+		AddError(FString::Printf(TEXT("Map Load Failed %s"), *MapName));
+		return false;
+	}
+
+	WeaponNetTest::RequestNetPlaySession(NumClients);
+
+	ADD_LATENT_AUTOMATION_COMMAND(FWaitForNetPlaySessionCommand(this, NumClients, 60.0));
+	ADD_LATENT_AUTOMATION_COMMAND(FArmNetPlayersCommand(this, WeaponClassPath, 10.0));
+	ADD_LATENT_AUTOMATION_COMMAND(FNetBudgetScenarioCommand(this, NumClients, Duration, StepInterval));
+	ADD_LATENT_AUTOMATION_COMMAND(FEndNetPlaySessionCommand());
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,725 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "WeaponNetTestSession.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
+
+#include "FHProjectCharacter.h"
+#include "FHInputCommand.h"
+#include "BaseWeapon.h"
+#include "CombatWorldSubsystem.h"
+#include "CombatEventSubsystem.h"
+#include "Engine/World.h"
+#include "Engine/NetDriver.h"
+#include "Engine/NetConnection.h"
+#include "Engine/PackageMapClient.h"
+#include "GameFramework/Controller.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+/**
+ * Network Condition Test, One Test per Packet Simulation Profile
+ * Dedicated Server and Clients in PIE, Same Profile Applied to every Net Driver
+ * Client Attack is Predicted in Test by Same Query as Server, Damage Request is not Changed
+ * Server Hit Event Confirm Prediction, Server Move Correction is Counted at its Send
+ * Profiles in [Weapon.NetConditionTest] of DefaultGame.ini, CSV in Saved/Profiling
+ * Packet Simulation need Non Shipping Build
+ */
+namespace NetConditionTest
+{
+	static const TCHAR* ConfigSection = TEXT("Weapon.NetConditionTest");
+
+	//One Network Condition, Engine Packet Simulation Setting
+	struct FNetConditionProfile
+	{
+		FString Name;
+
+		//One Way Lag, Millisecond
+		int32 PktLag = 0;
+
+		//Jitter, Lag is PktLag +- this
+		int32 PktLagVariance = 0;
+
+		//Percent 0 ~ 100
+		int32 PktLoss = 0;
+
+		int32 PktOrder = 0;
+
+		int32 PktDup = 0;
+
+		//Fail When Confirmed / Predicted is Under this
+		float MinHitAccuracy = 0.0f;
+
+		//Fail When Server Move Correction per Client is Over this, 0 is No Limit
+		float MaxCorrectionsPerSecond = 0.0f;
+	};
+
+	//+Profiles=(Name="Mobile",PktLag=80,PktLagVariance=30,PktLoss=3,PktOrder=1,MinHitAccuracy=0.8)
+	static void LoadProfiles(TArray<FNetConditionProfile>& OutProfiles)
+	{
+		TArray<FString> Lines;
+		GConfig->GetArray(ConfigSection, TEXT("Profiles"), Lines, GGameIni);
+
+		for (const FString& Line : Lines)
+		{
+			FString Name;
+			if (FParse::Value(*Line, TEXT("Name="), Name) == false)
+			{
+				continue;
+			}
+
+			FNetConditionProfile& Profile = OutProfiles.AddDefaulted_GetRef();
+			Profile.Name = Name;
+			FParse::Value(*Line, TEXT("PktLag="), Profile.PktLag);
+			FParse::Value(*Line, TEXT("PktLagVariance="), Profile.PktLagVariance);
+			FParse::Value(*Line, TEXT("PktLoss="), Profile.PktLoss);
+			FParse::Value(*Line, TEXT("PktOrder="), Profile.PktOrder);
+			FParse::Value(*Line, TEXT("PktDup="), Profile.PktDup);
+			FParse::Value(*Line, TEXT("MinHitAccuracy="), Profile.MinHitAccuracy);
+			FParse::Value(*Line, TEXT("MaxCorrectionsPerSecond="), Profile.MaxCorrectionsPerSecond);
+		}
+	}
+
+	//Server Counterpart of Client Actor, Net GUID is Same on both Side
+	static AActor* FindServerActor(AActor* ClientActor)
+	{
+		UWorld* ServerWorld = WeaponNetTest::GetServerWorld();
+		UNetDriver* ServerNetDriver = ServerWorld != nullptr ? ServerWorld->GetNetDriver() : nullptr;
+		UNetDriver* ClientNetDriver = ClientActor != nullptr ? ClientActor->GetNetDriver() : nullptr;
+		if (ServerNetDriver == nullptr || ClientNetDriver == nullptr || ServerNetDriver->GuidCache.IsValid() == false || ClientNetDriver->GuidCache.IsValid() == false)
+		{
+			return nullptr;
+		}
+
+		const FNetworkGUID NetGUID = ClientNetDriver->GuidCache->GetNetGUID(ClientActor);
+		return NetGUID.IsValid() == true ? Cast<AActor>(ServerNetDriver->GuidCache->GetObjectFromNetGUID(NetGUID, false)) : nullptr;
+	}
+
+	//Client Local Result of Damage Request, Same Query as Server without Damage
+	static bool PredictAttackHit(ABaseWeapon* Weapon, const FVector& StartLocation, const FVector& EndLocation)
+	{
+		UWorld* World = Weapon->GetWorld();
+		ACharacter* OwnerCharacter = Weapon->GetOwnerCharacter();
+
+		//Character Broadphase, Same as Server Resolve
+		const UCombatWorldSubsystem* CombatSubsystem = World->GetSubsystem<UCombatWorldSubsystem>();
+		const AFHProjectCharacter* OwnerProjectCharacter = Cast<AFHProjectCharacter>(OwnerCharacter);
+		if (CombatSubsystem != nullptr && CombatSubsystem->UseCapsuleBroadphase() == true && OwnerProjectCharacter != nullptr)
+		{
+			TArray<FCapsuleBroadphaseHit> CapsuleHits;
+			CombatSubsystem->QueryCapsules(StartLocation, EndLocation, Weapon->GetTraceSphereRadius(), CapsuleHits);
+
+			return CapsuleHits.ContainsByPredicate([OwnerProjectCharacter](const FCapsuleBroadphaseHit& Hit) { return Hit.Index != OwnerProjectCharacter->GetCombatantIndex(); });
+		}
+
+		FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(PredictAttackHit), Weapon->IsTraceComplex());
+		QueryParams.AddIgnoredActor(Weapon);
+		QueryParams.AddIgnoredActor(OwnerCharacter);
+
+		return World->SweepTestByObjectType(StartLocation, EndLocation, FQuat::Identity, ABaseWeapon::GetAttackObjectQueryParams(), FCollisionShape::MakeSphere(Weapon->GetTraceSphereRadius()), QueryParams);
+	}
+}
+
+using namespace NetConditionTest;
+
+
+//Predict Client Attack, Match Server Hit, Count Server Move Correction
+class FNetConditionRecorder
+{
+public:
+	explicit FNetConditionRecorder(float InConfirmWindow)
+		: ConfirmWindow(InConfirmWindow)
+	{
+	}
+
+	void Start();
+
+	void Stop();
+
+	//Prediction not Confirmed in Window is Resolved as Server Miss
+	void ExpirePredictions(double ServerTime, bool bExpireAll);
+
+	struct FResult
+	{
+		int32 PredictedAttacks = 0;
+
+		int32 PredictedHits = 0;
+
+		int32 ConfirmedHits = 0;
+
+		//Predicted Hit Confirmed by Server
+		int32 AgreedHits = 0;
+
+		//Server Result Differ from Client Prediction
+		int32 HitCorrections = 0;
+
+		//Server Hit without Pending Prediction (Baked Window, NPC)
+		int32 UnmatchedHits = 0;
+
+		int32 MoveCorrections = 0;
+
+		float GetHitAccuracy() const { return PredictedHits > 0 ? static_cast<float>(AgreedHits) / PredictedHits : 1.0f; };
+	};
+
+	const FResult& GetResult() const { return Result; };
+
+private:
+	void OnSendRpc(AActor* Actor, UFunction* Function, void* Parameters, FOutParmRec* OutParms, FFrame* Stack, UObject* SubObject, bool& bBlockSendRPC);
+
+	void OnServerCombatEvent(const FCombatEvent& Event);
+
+	void ResolvePrediction(bool bPredictedHit, bool bConfirmedHit);
+
+private:
+	struct FPendingAttack
+	{
+		bool bPredictedHit = false;
+
+		double SendServerTime = 0.0;
+	};
+
+	float ConfirmWindow;
+
+	FResult Result;
+
+	//Server Attacker Character, Damage Request in Send Order
+	TMap<FObjectKey, TArray<FPendingAttack>> PendingAttacks;
+
+	//Server Attacker, Time of Last Matched Hit, Multi Target Attack Publish Hit per Target at Same Time
+	TMap<FObjectKey, double> LastHitTimes;
+
+	//Server Character, Last Counted Correction Time Stamp
+	TMap<FObjectKey, float> LastCorrectionTimeStamps;
+
+	TArray<TWeakObjectPtr<UNetDriver>> BoundNetDrivers;
+
+	TWeakObjectPtr<UCombatEventSubsystem> ServerEventSubsystem;
+
+	FDelegateHandle CombatEventHandle;
+};
+
+void FNetConditionRecorder::Start()
+{
+	UWorld* ServerWorld = WeaponNetTest::GetServerWorld();
+	TArray<UWorld*> Worlds;
+	WeaponNetTest::GetClientWorlds(Worlds);
+	Worlds.Add(ServerWorld);
+
+	for (UWorld* World : Worlds)
+	{
+		UNetDriver* NetDriver = World != nullptr ? World->GetNetDriver() : nullptr;
+		if (NetDriver == nullptr)
+		{
+			continue;
+		}
+
+		NetDriver->SendRPCDel.BindRaw(this, &FNetConditionRecorder::OnSendRpc);
+		BoundNetDrivers.Add(NetDriver);
+	}
+
+	//Listener Make Server Publish Hit Event While Test Run
+	UCombatEventSubsystem* EventSubsystem = ServerWorld != nullptr ? ServerWorld->GetSubsystem<UCombatEventSubsystem>() : nullptr;
+	if (EventSubsystem != nullptr)
+	{
+		CombatEventHandle = EventSubsystem->AddListener(FOnCombatEvent::FDelegate::CreateRaw(this, &FNetConditionRecorder::OnServerCombatEvent));
+		ServerEventSubsystem = EventSubsystem;
+	}
+}
+
+void FNetConditionRecorder::Stop()
+{
+	for (const TWeakObjectPtr<UNetDriver>& NetDriver : BoundNetDrivers)
+	{
+		if (NetDriver.IsValid() == true)
+		{
+			NetDriver->SendRPCDel.Unbind();
+		}
+	}
+
+	BoundNetDrivers.Reset();
+
+	if (ServerEventSubsystem.IsValid() == true)
+	{
+		ServerEventSubsystem->RemoveListener(CombatEventHandle);
+	}
+
+	ServerEventSubsystem.Reset();
+	CombatEventHandle.Reset();
+}
+
+void FNetConditionRecorder::OnSendRpc(AActor* Actor, UFunction* Function, void* Parameters, FOutParmRec* OutParms, FFrame* Stack, UObject* SubObject, bool& bBlockSendRPC)
+{
+	UNetDriver* NetDriver = Actor != nullptr ? Actor->GetNetDriver() : nullptr;
+	if (NetDriver == nullptr || Function == nullptr)
+	{
+		return;
+	}
+
+	//Server Move Response, Pending Adjustment is Cleared after this Send
+	if (NetDriver->ServerConnection == nullptr)
+	{
+		const ACharacter* Character = Cast<ACharacter>(Actor);
+		if (Character == nullptr || Function->HasAnyFunctionFlags(FUNC_NetClient) == false || Character->GetCharacterMovement() == nullptr)
+		{
+			return;
+		}
+
+		const FNetworkPredictionData_Server_Character* ServerData = Character->GetCharacterMovement()->HasPredictionData_Server() == true ? Character->GetCharacterMovement()->GetPredictionData_Server_Character() : nullptr;
+		if (ServerData == nullptr || ServerData->PendingAdjustment.TimeStamp <= 0.0f || ServerData->PendingAdjustment.bAckGoodMove == true)
+		{
+			return;
+		}
+
+		//One Adjustment can be Sent by more than One Rpc
+		float& LastTimeStamp = LastCorrectionTimeStamps.FindOrAdd(FObjectKey(Character), -1.0f);
+		if (LastTimeStamp != ServerData->PendingAdjustment.TimeStamp)
+		{
+			LastTimeStamp = ServerData->PendingAdjustment.TimeStamp;
+			Result.MoveCorrections += 1;
+		}
+
+		return;
+	}
+
+	//Client Damage Request
+	ABaseWeapon* Weapon = Cast<ABaseWeapon>(Actor);
+	if (Weapon == nullptr || Function->GetFName() != GET_FUNCTION_NAME_CHECKED(ABaseWeapon, Req_ApplyDamageToTargetActor))
+	{
+		return;
+	}
+
+	const FStructProperty* StartProperty = FindFProperty<FStructProperty>(Function, TEXT("StartLocation"));
+	const FStructProperty* EndProperty = FindFProperty<FStructProperty>(Function, TEXT("EndLocation"));
+	AActor* ServerAttacker = FindServerActor(Weapon->GetOwnerCharacter());
+	UWorld* ServerWorld = WeaponNetTest::GetServerWorld();
+	if (StartProperty == nullptr || EndProperty == nullptr || ServerAttacker == nullptr || ServerWorld == nullptr)
+	{
+		return;
+	}
+
+	const FVector& StartLocation = *StartProperty->ContainerPtrToValuePtr<FVector>(Parameters);
+	const FVector& EndLocation = *EndProperty->ContainerPtrToValuePtr<FVector>(Parameters);
+
+	FPendingAttack& PendingAttack = PendingAttacks.FindOrAdd(FObjectKey(ServerAttacker)).AddDefaulted_GetRef();
+	PendingAttack.bPredictedHit = PredictAttackHit(Weapon, StartLocation, EndLocation);
+	PendingAttack.SendServerTime = ServerWorld->GetTimeSeconds();
+
+	Result.PredictedAttacks += 1;
+	Result.PredictedHits += PendingAttack.bPredictedHit == true ? 1 : 0;
+}
+
+void FNetConditionRecorder::OnServerCombatEvent(const FCombatEvent& Event)
+{
+	if (Event.Type != ECombatEventType::Hit || Event.Instigator.IsValid() == false)
+	{
+		return;
+	}
+
+	//Multi Target Attack, Only First Hit of Attack Confirm it
+	const FObjectKey AttackerKey(Event.Instigator.Get());
+	double* LastHitTime = LastHitTimes.Find(AttackerKey);
+	if (LastHitTime != nullptr && *LastHitTime == Event.Time)
+	{
+		return;
+	}
+
+	LastHitTimes.Add(AttackerKey, Event.Time);
+
+	//Reliable Request is Resolved in Send Order, Older Expired Request was Server Miss
+	ExpirePredictions(Event.Time, false);
+
+	TArray<FPendingAttack>* AttackerPendings = PendingAttacks.Find(AttackerKey);
+	if (AttackerPendings == nullptr || AttackerPendings->Num() == 0)
+	{
+		Result.UnmatchedHits += 1;
+		return;
+	}
+
+	const FPendingAttack PendingAttack = (*AttackerPendings)[0];
+	AttackerPendings->RemoveAt(0);
+
+	ResolvePrediction(PendingAttack.bPredictedHit, true);
+}
+
+void FNetConditionRecorder::ExpirePredictions(double ServerTime, bool bExpireAll)
+{
+	for (TPair<FObjectKey, TArray<FPendingAttack>>& Pair : PendingAttacks)
+	{
+		TArray<FPendingAttack>& AttackerPendings = Pair.Value;
+		while (AttackerPendings.Num() > 0 && (bExpireAll == true || ServerTime - AttackerPendings[0].SendServerTime > ConfirmWindow))
+		{
+			ResolvePrediction(AttackerPendings[0].bPredictedHit, false);
+			AttackerPendings.RemoveAt(0);
+		}
+	}
+}
+
+void FNetConditionRecorder::ResolvePrediction(bool bPredictedHit, bool bConfirmedHit)
+{
+	Result.ConfirmedHits += bConfirmedHit == true ? 1 : 0;
+	Result.AgreedHits += (bPredictedHit == true && bConfirmedHit == true) ? 1 : 0;
+	Result.HitCorrections += bPredictedHit != bConfirmedHit ? 1 : 0;
+}
+
+
+//Engage Nearest Character under Profile, Check Result at End
+class FNetConditionScenarioCommand : public IAutomationLatentCommand
+{
+public:
+	FNetConditionScenarioCommand(FAutomationTestBase* InTest, const FNetConditionProfile& InProfile, int32 InNumClients, float InDuration)
+		: Test(InTest)
+		, Profile(InProfile)
+		, NumClients(InNumClients)
+		, Duration(InDuration)
+		//Request Reach Server in One Way Lag, Resend of Lost Packet Take about One Round Trip More
+		, Recorder((InProfile.PktLag + InProfile.PktLagVariance) * 3 * 0.001f + 0.25f)
+		, bIsStarted(false)
+		, bIsAttackHeld(false)
+		, LastRunTime(0.0)
+		, AttackElapsedTime(0.0f)
+		, StartOutBytes(0)
+		, StartInBytes(0)
+		, StartOutPacketsLost(0)
+	{
+		AttackInterval = WeaponNetTest::GetConfigFloat(ConfigSection, TEXT("AttackInterval"), 0.5f);
+		EngageDistance = WeaponNetTest::GetConfigFloat(ConfigSection, TEXT("EngageDistance"), 150.0f);
+		ScenarioPhaseTime = WeaponNetTest::GetConfigFloat(ConfigSection, TEXT("ScenarioPhaseTime"), 1.5f);
+	}
+
+	virtual ~FNetConditionScenarioCommand()
+	{
+		Recorder.Stop();
+	}
+
+	virtual bool Update() override;
+
+private:
+	//Every Net Driver of Session, Server and Clients
+	void GetNetDrivers(TArray<UNetDriver*>& OutNetDrivers) const;
+
+	void ApplyProfile(const FNetConditionProfile& NewProfile) const;
+
+	//Strafe Phase Make Moving Target, Attack Phase Engage
+	void TickScenario(float DeltaTime, float ElapsedTime);
+
+	//Server Side Sum of every Client Connection
+	void GetConnectionTotals(int64& OutBytesSent, int64& OutBytesReceived, int64& OutPacketsLost) const;
+
+	void Report(float Seconds);
+
+private:
+	FAutomationTestBase* Test;
+
+	FNetConditionProfile Profile;
+
+	int32 NumClients;
+
+	float Duration;
+
+	float AttackInterval;
+
+	float EngageDistance;
+
+	float ScenarioPhaseTime;
+
+	FNetConditionRecorder Recorder;
+
+	bool bIsStarted;
+
+	bool bIsAttackHeld;
+
+	double LastRunTime;
+
+	float AttackElapsedTime;
+
+	int64 StartOutBytes;
+
+	int64 StartInBytes;
+
+	int64 StartOutPacketsLost;
+};
+
+bool FNetConditionScenarioCommand::Update()
+{
+	UWorld* ServerWorld = WeaponNetTest::GetServerWorld();
+	if (ServerWorld == nullptr)
+	{
+		Test->AddError(TEXT("Server World Missing, Scenario not Run"));
+		return true;
+	}
+
+	if (bIsStarted == false)
+	{
+#if !DO_ENABLE_NET_TEST
+		Test->AddWarning(TEXT("Packet Simulation is not Enabled in this Build, Profile Run without Lag"));
+#endif
+		ApplyProfile(Profile);
+		GetConnectionTotals(StartOutBytes, StartInBytes, StartOutPacketsLost);
+		Recorder.Start();
+		bIsStarted = true;
+	}
+
+	const double RunTime = GetCurrentRunTime();
+	const float DeltaTime = static_cast<float>(RunTime - LastRunTime);
+	LastRunTime = RunTime;
+
+	TickScenario(DeltaTime, static_cast<float>(RunTime));
+	Recorder.ExpirePredictions(ServerWorld->GetTimeSeconds(), false);
+
+	if (RunTime < Duration)
+	{
+		return false;
+	}
+
+	//Release Held Attack, Restore No Simulation
+	if (bIsAttackHeld == true)
+	{
+		TickScenario(0.0f, static_cast<float>(RunTime));
+	}
+
+	Recorder.Stop();
+	Recorder.ExpirePredictions(ServerWorld->GetTimeSeconds(), true);
+	ApplyProfile(FNetConditionProfile());
+
+	Report(static_cast<float>(RunTime));
+	return true;
+}
+
+void FNetConditionScenarioCommand::GetNetDrivers(TArray<UNetDriver*>& OutNetDrivers) const
+{
+	TArray<UWorld*> Worlds;
+	WeaponNetTest::GetClientWorlds(Worlds);
+	Worlds.Add(WeaponNetTest::GetServerWorld());
+
+	for (UWorld* World : Worlds)
+	{
+		if (UNetDriver* NetDriver = World != nullptr ? World->GetNetDriver() : nullptr)
+		{
+			OutNetDrivers.Add(NetDriver);
+		}
+	}
+}
+
+void FNetConditionScenarioCommand::ApplyProfile(const FNetConditionProfile& NewProfile) const
+{
+#if DO_ENABLE_NET_TEST
+	//Outgoing Packet of each Driver, Both Direction Get Same Condition
+	FPacketSimulationSettings Settings;
+	Settings.PktLag = NewProfile.PktLag;
+	Settings.PktLagVariance = NewProfile.PktLagVariance;
+	Settings.PktLoss = NewProfile.PktLoss;
+	Settings.PktOrder = NewProfile.PktOrder;
+	Settings.PktDup = NewProfile.PktDup;
+
+	TArray<UNetDriver*> NetDrivers;
+	GetNetDrivers(NetDrivers);
+	for (UNetDriver* NetDriver : NetDrivers)
+	{
+		NetDriver->SetPacketSimulationSettings(Settings);
+	}
+#endif
+}
+
+void FNetConditionScenarioCommand::TickScenario(float DeltaTime, float ElapsedTime)
+{
+	AttackElapsedTime += DeltaTime;
+
+	//Release Last Attack Next Tick, Click is One Press and Release
+	const bool bShouldRelease = bIsAttackHeld == true;
+	bIsAttackHeld = false;
+
+	const bool bIsAttackPhase = FMath::Fmod(ElapsedTime, ScenarioPhaseTime * 2.0f) >= ScenarioPhaseTime;
+	const bool bShouldAttack = DeltaTime > 0.0f && bIsAttackPhase == true && AttackElapsedTime >= AttackInterval;
+	if (bShouldAttack == true)
+	{
+		AttackElapsedTime = 0.0f;
+	}
+
+	TArray<UWorld*> ClientWorlds;
+	WeaponNetTest::GetClientWorlds(ClientWorlds);
+
+	for (UWorld* ClientWorld : ClientWorlds)
+	{
+		AFHProjectCharacter* Character = WeaponNetTest::GetLocalCharacter(ClientWorld);
+		if (Character == nullptr)
+		{
+			continue;
+		}
+
+		if (bShouldRelease == true)
+		{
+			Character->SimulateInputButton(FHInputButton::LeftClick, false);
+		}
+
+		const AFHProjectCharacter* Target = WeaponNetTest::FindNearestCharacter(Character);
+		if (Target == nullptr || DeltaTime <= 0.0f)
+		{
+			continue;
+		}
+
+		const FVector ToTarget = (Target->GetActorLocation() - Character->GetActorLocation()).GetSafeNormal2D();
+		const float Distance = FVector::Dist2D(Target->GetActorLocation(), Character->GetActorLocation());
+
+		//Aim at Target, Range Weapon use Control Rotation
+		if (AController* Controller = Character->GetController())
+		{
+			Controller->SetControlRotation(ToTarget.Rotation());
+		}
+
+		if (Distance > EngageDistance)
+		{
+			Character->AddMovementInput(ToTarget, 1.0f);
+			continue;
+		}
+
+		if (bIsAttackPhase == false)
+		{
+			//Circle around Target
+			Character->AddMovementInput(FVector::CrossProduct(ToTarget, FVector::UpVector), 1.0f);
+			continue;
+		}
+
+		//Slow Step toward Target, Orient to Movement Face it
+		Character->AddMovementInput(ToTarget, 0.1f);
+
+		if (bShouldAttack == true)
+		{
+			Character->SimulateInputButton(FHInputButton::LeftClick, true);
+			bIsAttackHeld = true;
+		}
+	}
+}
+
+void FNetConditionScenarioCommand::GetConnectionTotals(int64& OutBytesSent, int64& OutBytesReceived, int64& OutPacketsLost) const
+{
+	OutBytesSent = 0;
+	OutBytesReceived = 0;
+	OutPacketsLost = 0;
+
+	UWorld* ServerWorld = WeaponNetTest::GetServerWorld();
+	const UNetDriver* NetDriver = ServerWorld != nullptr ? ServerWorld->GetNetDriver() : nullptr;
+	if (NetDriver == nullptr)
+	{
+		return;
+	}
+
+	for (const UNetConnection* Connection : NetDriver->ClientConnections)
+	{
+		OutBytesSent += Connection->OutTotalBytes;
+		OutBytesReceived += Connection->InTotalBytes;
+		OutPacketsLost += Connection->OutTotalPacketsLost;
+	}
+}
+
+void FNetConditionScenarioCommand::Report(float Seconds)
+{
+	Seconds = FMath::Max(Seconds, UE_KINDA_SMALL_NUMBER);
+	const float ClientCount = static_cast<float>(FMath::Max(NumClients, 1));
+
+	int64 OutBytes = 0;
+	int64 InBytes = 0;
+	int64 OutPacketsLost = 0;
+	GetConnectionTotals(OutBytes, InBytes, OutPacketsLost);
+	OutBytes -= StartOutBytes;
+	InBytes -= StartInBytes;
+	OutPacketsLost -= StartOutPacketsLost;
+
+	const FNetConditionRecorder::FResult& Result = Recorder.GetResult();
+	const float CorrectionsPerSecond = Result.MoveCorrections / Seconds / ClientCount;
+
+	if (Result.PredictedAttacks == 0)
+	{
+		Test->AddError(TEXT("No Damage Request Sent, Characters not Engaged"));
+	}
+
+	bool bIsFailed = false;
+	if (Result.PredictedHits > 0 && Result.GetHitAccuracy() < Profile.MinHitAccuracy)
+	{
+		Test->AddError(FString::Printf(TEXT("%s :: Hit Accuracy %.3f (Min %.3f)"), *Profile.Name, Result.GetHitAccuracy(), Profile.MinHitAccuracy));
+		bIsFailed = true;
+	}
+
+	if (Profile.MaxCorrectionsPerSecond > 0.0f && CorrectionsPerSecond > Profile.MaxCorrectionsPerSecond)
+	{
+		Test->AddError(FString::Printf(TEXT("%s :: Move Corrections %.2f/s per Client (Max %.2f)"), *Profile.Name, CorrectionsPerSecond, Profile.MaxCorrectionsPerSecond));
+		bIsFailed = true;
+	}
+
+	FString Csv = TEXT("Profile,Seconds,PredictedAttacks,PredictedHits,ConfirmedHits,AgreedHits,HitAccuracy,MinHitAccuracy,HitCorrections,UnmatchedHits,MoveCorrections,MoveCorrectionsPerSecond,ServerOutBytesPerSecond,ServerInBytesPerSecond,ServerOutPacketsLost,Result\n");
+	Csv += FString::Printf(TEXT("%s,%.1f,%d,%d,%d,%d,%.3f,%.3f,%d,%d,%d,%.2f,%.1f,%.1f,%lld,%s\n"),
+		*Profile.Name,
+		Seconds,
+		Result.PredictedAttacks,
+		Result.PredictedHits,
+		Result.ConfirmedHits,
+		Result.AgreedHits,
+		Result.GetHitAccuracy(),
+		Profile.MinHitAccuracy,
+		Result.HitCorrections,
+		Result.UnmatchedHits,
+		Result.MoveCorrections,
+		CorrectionsPerSecond,
+		OutBytes / Seconds,
+		InBytes / Seconds,
+		OutPacketsLost,
+		bIsFailed == true ? TEXT("Failed") : TEXT("Ok"));
+
+	const FString CsvPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Profiling"), FString::Printf(TEXT("NetCondition_%s_%s.csv"), *Profile.Name, *FDateTime::Now().ToString()));
+	FFileHelper::SaveStringToFile(Csv, *CsvPath);
+
+	Test->AddInfo(FString::Printf(TEXT("%s :: Accuracy %.3f, Move Corrections %d, Out %.1f Bytes/s, In %.1f Bytes/s, Lost %lld, CSV %s"),
+		*Profile.Name, Result.GetHitAccuracy(), Result.MoveCorrections, OutBytes / Seconds, InBytes / Seconds, OutPacketsLost, *CsvPath));
+}
+
+
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FWeaponNetConditionTest, "Weapon.Network.Conditions", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+void FWeaponNetConditionTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+	TArray<FNetConditionProfile> Profiles;
+	LoadProfiles(Profiles);
+
+	for (const FNetConditionProfile& Profile : Profiles)
+	{
+		OutBeautifiedNames.Add(Profile.Name);
+		OutTestCommands.Add(Profile.Name);
+	}
+}
+
+bool FWeaponNetConditionTest::RunTest(const FString& Parameters)
+{
+	TArray<FNetConditionProfile> Profiles;
+	LoadProfiles(Profiles);
+
+	const FNetConditionProfile* Profile = Profiles.FindByPredicate([&Parameters](const FNetConditionProfile& Candidate) { return Candidate.Name == Parameters; });
+	if (Profile == nullptr)
+	{
+		AddError(FString::Printf(TEXT("Profile not Found %s"), *Parameters));
+		return false;
+	}
+
+	const FString MapName = WeaponNetTest::GetConfigString(ConfigSection, TEXT("Map"), TEXT("/Game/Level/TestLevel"));
+	const FString WeaponClassPath = WeaponNetTest::GetConfigString(ConfigSection, TEXT("WeaponClass"), TEXT("/Weapon/BP_TestWeapon.BP_TestWeapon_C"));
+	const int32 NumClients = FMath::Max(WeaponNetTest::GetConfigInt(ConfigSection, TEXT("NumClients"), 2), 2);
+	const float Duration = FMath::Max(WeaponNetTest::GetConfigFloat(ConfigSection, TEXT("Duration"), 30.0f), 1.0f);
+
+	if (WeaponNetTest::LoadTestMap(MapName) == false)
+	{
+		AddError(FString::Printf(TEXT("Map Load Failed %s"), *MapName));
+		return false;
+	}
+
+	WeaponNetTest::RequestNetPlaySession(NumClients);
+
+	ADD_LATENT_AUTOMATION_COMMAND(FWaitForNetPlaySessionCommand(this, NumClients, 60.0));
+	ADD_LATENT_AUTOMATION_COMMAND(FArmNetPlayersCommand(this, WeaponClassPath, 10.0));
+	ADD_LATENT_AUTOMATION_COMMAND(FNetConditionScenarioCommand(this, *Profile, NumClients, Duration));
+	ADD_LATENT_AUTOMATION_COMMAND(FEndNetPlaySessionCommand());
+
+	return true;
+}
+
+#endif
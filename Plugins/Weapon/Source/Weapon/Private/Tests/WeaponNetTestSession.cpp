@@ -0,0 +1,245 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "WeaponNetTestSession.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
+
+#include "FHProjectCharacter.h"
+#include "BaseWeapon.h"
+#include "WeaponInterface.h"
+#include "Editor.h"
+#include "FileHelpers.h"
+#include "Settings/LevelEditorPlaySettings.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/PlayerController.h"
+#include "Misc/ConfigCacheIni.h"
+
+
+bool WeaponNetTest::LoadTestMap(const FString& MapName)
+{
+	if (GEditor == nullptr || GEditor->PlayWorld != nullptr)
+	{
+		return false;
+	}
+
+	return FEditorFileUtils::LoadMap(MapName, false, false);
+}
+
+void WeaponNetTest::RequestNetPlaySession(int32 NumClients)
+{
+	//Dedicated Server, Client Only Windows, Every Instance in this Process
+	ULevelEditorPlaySettings* PlaySettings = NewObject<ULevelEditorPlaySettings>();
+	PlaySettings->SetPlayNetMode(EPlayNetMode::PIE_Client);
+	PlaySettings->SetPlayNumberOfClients(NumClients);
+	PlaySettings->bLaunchSeparateServer = true;
+	PlaySettings->SetRunUnderOneProcess(true);
+
+	FRequestPlaySessionParams Params;
+	Params.WorldType = EPlaySessionWorldType::PlayInEditor;
+	Params.SessionDestination = EPlaySessionDestinationType::InProcess;
+	Params.EditorPlaySettings = PlaySettings;
+
+	GEditor->RequestPlaySession(Params);
+}
+
+UWorld* WeaponNetTest::GetServerWorld()
+{
+	if (GEditor == nullptr)
+	{
+		return nullptr;
+	}
+
+	for (const FWorldContext& Context : GEditor->GetWorldContexts())
+	{
+		UWorld* World = Context.World();
+		if (Context.WorldType == EWorldType::PIE && World != nullptr && World->GetNetMode() == NM_DedicatedServer)
+		{
+			return World;
+		}
+	}
+
+	return nullptr;
+}
+
+void WeaponNetTest::GetClientWorlds(TArray<UWorld*>& OutWorlds)
+{
+	OutWorlds.Reset();
+
+	if (GEditor == nullptr)
+	{
+		return;
+	}
+
+	for (const FWorldContext& Context : GEditor->GetWorldContexts())
+	{
+		UWorld* World = Context.World();
+		if (Context.WorldType == EWorldType::PIE && World != nullptr && World->GetNetMode() == NM_Client)
+		{
+			OutWorlds.Add(World);
+		}
+	}
+}
+
+AFHProjectCharacter* WeaponNetTest::GetLocalCharacter(UWorld* ClientWorld)
+{
+	const APlayerController* PlayerController = ClientWorld != nullptr ? ClientWorld->GetFirstPlayerController() : nullptr;
+	return PlayerController != nullptr ? Cast<AFHProjectCharacter>(PlayerController->GetPawn()) : nullptr;
+}
+
+AFHProjectCharacter* WeaponNetTest::FindNearestCharacter(const AFHProjectCharacter* Character)
+{
+	AFHProjectCharacter* NearestCharacter = nullptr;
+	float NearestDistanceSquared = TNumericLimits<float>::Max();
+
+	for (TActorIterator<AFHProjectCharacter> It(Character->GetWorld()); It; ++It)
+	{
+		if (*It == Character)
+		{
+			continue;
+		}
+
+		const float DistanceSquared = FVector::DistSquared(It->GetActorLocation(), Character->GetActorLocation());
+		if (DistanceSquared < NearestDistanceSquared)
+		{
+			NearestDistanceSquared = DistanceSquared;
+			NearestCharacter = *It;
+		}
+	}
+
+	return NearestCharacter;
+}
+
+FString WeaponNetTest::GetConfigString(const TCHAR* Section, const TCHAR* Key, const FString& DefaultValue)
+{
+	FString Value;
+	return GConfig->GetString(Section, Key, Value, GGameIni) == true ? Value : DefaultValue;
+}
+
+int32 WeaponNetTest::GetConfigInt(const TCHAR* Section, const TCHAR* Key, int32 DefaultValue)
+{
+	int32 Value = 0;
+	return GConfig->GetInt(Section, Key, Value, GGameIni) == true ? Value : DefaultValue;
+}
+
+float WeaponNetTest::GetConfigFloat(const TCHAR* Section, const TCHAR* Key, float DefaultValue)
+{
+	float Value = 0.0f;
+	return GConfig->GetFloat(Section, Key, Value, GGameIni) == true ? Value : DefaultValue;
+}
+
+
+bool FWaitForNetPlaySessionCommand::Update()
+{
+	if (GetCurrentRunTime() > Timeout)
+	{
+		Test->AddError(FString::Printf(TEXT("Net Play Session not Ready in %.0f Seconds"), Timeout));
+		return true;
+	}
+
+	UWorld* ServerWorld = WeaponNetTest::GetServerWorld();
+	if (ServerWorld == nullptr)
+	{
+		return false;
+	}
+
+	TArray<UWorld*> ClientWorlds;
+	WeaponNetTest::GetClientWorlds(ClientWorlds);
+	if (ClientWorlds.Num() < NumClients)
+	{
+		return false;
+	}
+
+	for (UWorld* ClientWorld : ClientWorlds)
+	{
+		if (WeaponNetTest::GetLocalCharacter(ClientWorld) == nullptr)
+		{
+			return false;
+		}
+	}
+
+	//Server Possessed every Client's Character
+	int32 PlayerCharacterCount = 0;
+	for (TActorIterator<AFHProjectCharacter> It(ServerWorld); It; ++It)
+	{
+		PlayerCharacterCount += It->IsPlayerControlled() == true ? 1 : 0;
+	}
+
+	return PlayerCharacterCount >= NumClients;
+}
+
+bool FArmNetPlayersCommand::Update()
+{
+	UWorld* ServerWorld = WeaponNetTest::GetServerWorld();
+	if (ServerWorld == nullptr || GetCurrentRunTime() > Timeout)
+	{
+		Test->AddError(TEXT("Players not Armed, Server World Missing or Timeout"));
+		return true;
+	}
+
+	if (bIsArmed == false)
+	{
+		UClass* WeaponClass = LoadClass<ABaseWeapon>(nullptr, *WeaponClassPath);
+		if (WeaponClass == nullptr)
+		{
+			Test->AddError(FString::Printf(TEXT("Weapon Class not Found %s"), *WeaponClassPath));
+			return true;
+		}
+
+		//Same Pick Up Event as Overlap, Server Only
+		for (TActorIterator<AFHProjectCharacter> It(ServerWorld); It; ++It)
+		{
+			AFHProjectCharacter* Character = *It;
+			if (Character->IsPlayerControlled() == false || Character->GetEquipWeapon() != nullptr)
+			{
+				continue;
+			}
+
+			FActorSpawnParameters SpawnParameters;
+			SpawnParameters.Owner = Character->GetController();
+			SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+			ABaseWeapon* Weapon = ServerWorld->SpawnActor<ABaseWeapon>(WeaponClass, Character->GetActorTransform(), SpawnParameters);
+			if (Weapon != nullptr)
+			{
+				IWeaponInterface::Execute_Event_GetItem(Character, EItemType::TestWeapon, Weapon);
+			}
+		}
+
+		bIsArmed = true;
+	}
+
+	//Client Attack Input need Equip Weapon
+	TArray<UWorld*> ClientWorlds;
+	WeaponNetTest::GetClientWorlds(ClientWorlds);
+	for (UWorld* ClientWorld : ClientWorlds)
+	{
+		AFHProjectCharacter* LocalCharacter = WeaponNetTest::GetLocalCharacter(ClientWorld);
+		if (LocalCharacter == nullptr || LocalCharacter->GetEquipWeapon() == nullptr)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool FEndNetPlaySessionCommand::Update()
+{
+	if (GEditor == nullptr)
+	{
+		return true;
+	}
+
+	//Request until Play World is Destroyed, Ended at Next Editor Tick
+	if (GEditor->PlayWorld != nullptr)
+	{
+		GEditor->RequestEndPlayMap();
+		return false;
+	}
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,92 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
+
+class UWorld;
+class AFHProjectCharacter;
+
+/**
+ * PIE Session for Network Automation Tests
+ * Separate Dedicated Server and Clients Run Under One Editor Process
+ * Test Read Server and Client Worlds Directly, No Message between Machines
+ */
+namespace WeaponNetTest
+{
+	//Load Map in Editor, PIE Start from this Map
+	bool LoadTestMap(const FString& MapName);
+
+	//Request PIE, Started Next Editor Tick
+	void RequestNetPlaySession(int32 NumClients);
+
+	UWorld* GetServerWorld();
+
+	void GetClientWorlds(TArray<UWorld*>& OutWorlds);
+
+	//Client World's Locally Controlled Player Character
+	AFHProjectCharacter* GetLocalCharacter(UWorld* ClientWorld);
+
+	//Nearest Other Character in Same World
+	AFHProjectCharacter* FindNearestCharacter(const AFHProjectCharacter* Character);
+
+	//Config Value of Test Section in DefaultGame.ini
+	FString GetConfigString(const TCHAR* Section, const TCHAR* Key, const FString& DefaultValue);
+
+	int32 GetConfigInt(const TCHAR* Section, const TCHAR* Key, int32 DefaultValue);
+
+	float GetConfigFloat(const TCHAR* Section, const TCHAR* Key, float DefaultValue);
+}
+
+//Wait until Server has every Client's Character and every Client has Local Character
+class FWaitForNetPlaySessionCommand : public IAutomationLatentCommand
+{
+public:
+	FWaitForNetPlaySessionCommand(FAutomationTestBase* InTest, int32 InNumClients, double InTimeout)
+		: Test(InTest)
+		, NumClients(InNumClients)
+		, Timeout(InTimeout)
+	{
+	}
+
+	virtual bool Update() override;
+
+private:
+	FAutomationTestBase* Test;
+
+	int32 NumClients;
+
+	double Timeout;
+};
+
+//Server Give Weapon to every Player Character, Wait until Clients Equip it
+class FArmNetPlayersCommand : public IAutomationLatentCommand
+{
+public:
+	FArmNetPlayersCommand(FAutomationTestBase* InTest, const FString& InWeaponClassPath, double InTimeout)
+		: Test(InTest)
+		, WeaponClassPath(InWeaponClassPath)
+		, Timeout(InTimeout)
+		, bIsArmed(false)
+	{
+	}
+
+	virtual bool Update() override;
+
+private:
+	FAutomationTestBase* Test;
+
+	FString WeaponClassPath;
+
+	double Timeout;
+
+	bool bIsArmed;
+};
+
+//End PIE, Wait until Play World is Gone
+DEFINE_LATENT_AUTOMATION_COMMAND(FEndNetPlaySessionCommand);
+
+#endif
@@ -0,0 +1,101 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "WeaponInventory.h"
+#include "BaseWeapon.h"
+#include "FHProjectCharacter.h"
+
+
+void FWeaponInventorySlot::PreReplicatedRemove(const FWeaponInventoryArray& InArraySerializer)
+{
+	//Slot is Still in Array, Refresh without this Weapon
+	if (InArraySerializer.OwnerCharacter != nullptr)
+	{
+		InArraySerializer.OwnerCharacter->RefreshEquipWeapon(Weapon);
+	}
+}
+
+void FWeaponInventorySlot::PostReplicatedAdd(const FWeaponInventoryArray& InArraySerializer)
+{
+	//Slot is Replicated State, Attach Here not by Multicast
+	//Multicast at Spawn or Possess Arrive before Client has Character
+	if (InArraySerializer.OwnerCharacter != nullptr)
+	{
+		InArraySerializer.OwnerCharacter->AttachInventoryWeapon(Weapon);
+	}
+}
+
+void FWeaponInventorySlot::PostReplicatedChange(const FWeaponInventoryArray& InArraySerializer)
+{
+	//Weapon Actor Replicated after Slot, Pointer is Mapped Now
+	if (InArraySerializer.OwnerCharacter != nullptr)
+	{
+		InArraySerializer.OwnerCharacter->AttachInventoryWeapon(Weapon);
+	}
+}
+
+ABaseWeapon* FWeaponInventoryArray::GetWeapon(int32 SlotIndex) const
+{
+	for (const FWeaponInventorySlot& Slot : Slots)
+	{
+		if (Slot.SlotIndex == SlotIndex)
+		{
+			return Slot.Weapon;
+		}
+	}
+
+	return nullptr;
+}
+
+int32 FWeaponInventoryArray::FindSlotIndex(const ABaseWeapon* Weapon) const
+{
+	for (const FWeaponInventorySlot& Slot : Slots)
+	{
+		if (Weapon != nullptr && Slot.Weapon == Weapon)
+		{
+			return Slot.SlotIndex;
+		}
+	}
+
+	return INDEX_NONE;
+}
+
+int32 FWeaponInventoryArray::FindFreeSlot() const
+{
+	for (int32 SlotIndex = 0; SlotIndex < MaxSlotCount; ++SlotIndex)
+	{
+		if (GetWeapon(SlotIndex) == nullptr)
+		{
+			return SlotIndex;
+		}
+	}
+
+	return INDEX_NONE;
+}
+
+void FWeaponInventoryArray::AddWeapon(int32 SlotIndex, ABaseWeapon* Weapon)
+{
+	if (SlotIndex < 0 || SlotIndex >= MaxSlotCount || GetWeapon(SlotIndex) != nullptr)
+	{
+		return;
+	}
+
+	FWeaponInventorySlot& Slot = Slots.AddDefaulted_GetRef();
+	Slot.SlotIndex = SlotIndex;
+	Slot.Weapon = Weapon;
+
+	MarkItemDirty(Slot);
+}
+
+void FWeaponInventoryArray::RemoveWeapon(int32 SlotIndex)
+{
+	const int32 RemoveIndex = Slots.IndexOfByPredicate([SlotIndex](const FWeaponInventorySlot& Slot) { return Slot.SlotIndex == SlotIndex; });
+	if (RemoveIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	Slots.RemoveAt(RemoveIndex);
+
+	MarkArrayDirty();
+}
@@ -0,0 +1,211 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "WeaponProxySubsystem.h"
+#include "BaseWeapon.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/SceneComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+
+
+UWeaponProxySubsystem::UWeaponProxySubsystem()
+{
+	//Default Value, Override in DefaultGame.ini
+	PickupRadius = 200.0f;
+	HitImpulse = 300.0f;
+
+	ProxyHostActor = nullptr;
+}
+
+bool UWeaponProxySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UWeaponProxySubsystem::Deinitialize()
+{
+	Batches.Reset();
+	ProxyHostActor = nullptr;
+
+	Super::Deinitialize();
+}
+
+void UWeaponProxySubsystem::AddProxy(ABaseWeapon* Weapon)
+{
+	if (IsValid(Weapon) == false || Weapon->StaticMesh->GetStaticMesh() == nullptr)
+	{
+		return;
+	}
+
+	FWeaponProxyBatch& Batch = FindOrAddBatch(Weapon);
+	if (Batch.Weapons.Contains(Weapon) == true)
+	{
+		return;
+	}
+
+	Batch.Component->AddInstance(Weapon->StaticMesh->GetComponentTransform(), true);
+	Batch.Weapons.Add(Weapon);
+}
+
+void UWeaponProxySubsystem::RemoveProxy(ABaseWeapon* Weapon)
+{
+	for (FWeaponProxyBatch& Batch : Batches)
+	{
+		const int32 InstanceIndex = Batch.Weapons.IndexOfByKey(Weapon);
+		if (InstanceIndex == INDEX_NONE)
+		{
+			continue;
+		}
+
+		//Instance Index Shift after Remove, Weapons Array Shift Same
+		Batch.Component->RemoveInstance(InstanceIndex);
+		Batch.Weapons.RemoveAt(InstanceIndex);
+		return;
+	}
+}
+
+ABaseWeapon* UWeaponProxySubsystem::FindNearestProxy(const FVector& Location, float Radius) const
+{
+	ABaseWeapon* NearestWeapon = nullptr;
+	double NearestDistanceSquared = FMath::Square(Radius);
+
+	for (const FWeaponProxyBatch& Batch : Batches)
+	{
+		//Instance Bounds Query, not every Instance
+		for (const int32 InstanceIndex : Batch.Component->GetInstancesOverlappingSphere(Location, Radius))
+		{
+			FTransform InstanceTransform;
+			if (Batch.Weapons.IsValidIndex(InstanceIndex) == false || Batch.Component->GetInstanceTransform(InstanceIndex, InstanceTransform, true) == false)
+			{
+				continue;
+			}
+
+			const double DistanceSquared = FVector::DistSquared(InstanceTransform.GetLocation(), Location);
+			if (DistanceSquared <= NearestDistanceSquared)
+			{
+				NearestDistanceSquared = DistanceSquared;
+				NearestWeapon = Batch.Weapons[InstanceIndex];
+			}
+		}
+	}
+
+	return NearestWeapon;
+}
+
+ABaseWeapon* UWeaponProxySubsystem::FindHitProxy(const UPrimitiveComponent* HitComponent, int32 InstanceIndex) const
+{
+	const FWeaponProxyBatch* Batch = FindBatch(HitComponent);
+	if (Batch == nullptr || Batch->Weapons.IsValidIndex(InstanceIndex) == false)
+	{
+		return nullptr;
+	}
+
+	ABaseWeapon* Weapon = Batch->Weapons[InstanceIndex];
+	return IsValid(Weapon) == true ? Weapon : nullptr;
+}
+
+ABaseWeapon* UWeaponProxySubsystem::PromoteHitInstance(const UPrimitiveComponent* HitComponent, int32 InstanceIndex)
+{
+	ABaseWeapon* Weapon = FindHitProxy(HitComponent, InstanceIndex);
+	if (Weapon == nullptr)
+	{
+		return nullptr;
+	}
+
+	//Weapon Remove own Instance
+	Weapon->SetProxied(false);
+
+	return Weapon;
+}
+
+int32 UWeaponProxySubsystem::GetProxyCount() const
+{
+	int32 ProxyCount = 0;
+	for (const FWeaponProxyBatch& Batch : Batches)
+	{
+		ProxyCount += Batch.Weapons.Num();
+	}
+
+	return ProxyCount;
+}
+
+FWeaponProxyBatch& UWeaponProxySubsystem::FindOrAddBatch(ABaseWeapon* Weapon)
+{
+	UStaticMesh* Mesh = Weapon->StaticMesh->GetStaticMesh();
+
+	for (FWeaponProxyBatch& Batch : Batches)
+	{
+		if (Batch.Mesh == Mesh)
+		{
+			return Batch;
+		}
+	}
+
+	//One Host Actor for every Batch, not Replicated
+	if (ProxyHostActor == nullptr)
+	{
+		FActorSpawnParameters SpawnParameters;
+		SpawnParameters.ObjectFlags |= RF_Transient;
+		ProxyHostActor = GetWorld()->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParameters);
+
+		USceneComponent* RootComponent = NewObject<USceneComponent>(ProxyHostActor, TEXT("ProxyRoot"));
+		ProxyHostActor->SetRootComponent(RootComponent);
+		RootComponent->RegisterComponent();
+	}
+
+	UInstancedStaticMeshComponent* Component = NewObject<UInstancedStaticMeshComponent>(ProxyHostActor);
+	Component->SetStaticMesh(Mesh);
+	//Runtime Component, Instance Added and Removed During Play, Static is for Level Baked Component
+	Component->SetMobility(EComponentMobility::Movable);
+
+	//First Weapon's Material is used for every Instance
+	for (int32 MaterialIndex = 0; MaterialIndex < Weapon->StaticMesh->GetNumMaterials(); ++MaterialIndex)
+	{
+		Component->SetMaterial(MaterialIndex, Weapon->StaticMesh->GetMaterial(MaterialIndex));
+	}
+
+	//Query Only, Trace can Hit and Character can Overlap, No Physics Simulation
+	Component->SetCollisionProfileName(Weapon->StaticMesh->GetCollisionProfileName());
+	Component->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+	Component->SetGenerateOverlapEvents(true);
+	Component->SetupAttachment(ProxyHostActor->GetRootComponent());
+	Component->RegisterComponent();
+
+	if (GetWorld()->GetNetMode() != NM_Client)
+	{
+		Component->OnComponentBeginOverlap.AddDynamic(this, &UWeaponProxySubsystem::ProxyBeginOverlap);
+	}
+
+	FWeaponProxyBatch& Batch = Batches.AddDefaulted_GetRef();
+	Batch.Mesh = Mesh;
+	Batch.Component = Component;
+
+	return Batch;
+}
+
+const FWeaponProxyBatch* UWeaponProxySubsystem::FindBatch(const UPrimitiveComponent* Component) const
+{
+	if (Component == nullptr)
+	{
+		return nullptr;
+	}
+
+	return Batches.FindByPredicate([Component](const FWeaponProxyBatch& Batch) { return Batch.Component == Component; });
+}
+
+void UWeaponProxySubsystem::ProxyBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+{
+	//Weapon Actor Overlap Character after Promote, Weapon's MeshBeginOverlap Pick Up
+	APawn* Pawn = Cast<APawn>(OtherActor);
+	if (Pawn == nullptr)
+	{
+		return;
+	}
+
+	ABaseWeapon* Weapon = FindNearestProxy(Pawn->GetActorLocation(), PickupRadius);
+	if (Weapon != nullptr)
+	{
+		Weapon->SetProxied(false);
+	}
+}
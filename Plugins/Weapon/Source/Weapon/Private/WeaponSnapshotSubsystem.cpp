@@ -0,0 +1,625 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "WeaponSnapshotSubsystem.h"
+#include "BaseWeapon.h"
+#include "FHProjectCharacter.h"
+#include "Async/Async.h"
+#include "Async/MappedFileHandle.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/PlayerState.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Serialization/BufferReader.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "TimerManager.h"
+
+
+//Console Command
+static FAutoConsoleCommandWithWorld SnapshotSaveCommand(
+	TEXT("Weapon.Snapshot.Save"),
+	TEXT("Save every Weapon and Character Loadout to Snapshot File"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (UWeaponSnapshotSubsystem* SnapshotSubsystem = World != nullptr ? World->GetSubsystem<UWeaponSnapshotSubsystem>() : nullptr)
+		{
+			SnapshotSubsystem->SaveSnapshot();
+		}
+	}));
+
+static FAutoConsoleCommandWithWorld SnapshotLoadCommand(
+	TEXT("Weapon.Snapshot.Load"),
+	TEXT("Restore every Weapon and Character Loadout from Snapshot File"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (UWeaponSnapshotSubsystem* SnapshotSubsystem = World != nullptr ? World->GetSubsystem<UWeaponSnapshotSubsystem>() : nullptr)
+		{
+			SnapshotSubsystem->LoadSnapshot();
+		}
+	}));
+
+
+//----------[ Format ]----------
+//Header : Magic, Version, Save Time, Map Name
+//Class Table : Class Path, Weapon Record Point by uint16 Index
+//Loadout Table : Loadout Key, Active Slot
+//Weapon Record : Fixed Fields, LeftClickCount Packed
+//Change of any Field must Increase Version, Old Snapshot is Rejected
+namespace WeaponSnapshot
+{
+	static constexpr uint32 Magic = 0x53574846;	//FHWS
+	static constexpr uint16 Version = 1;
+}
+
+FArchive& operator<<(FArchive& Ar, FWeaponSnapshotRecord& Record)
+{
+	Ar << Record.ClassIndex;
+	Ar << Record.bIsProxied;
+	Ar << Record.SlotIndex;
+	Ar << Record.LoadoutIndex;
+
+	uint32 PackedCount = static_cast<uint32>(FMath::Max(Record.LeftClickCount, 0));
+	Ar.SerializeIntPacked(PackedCount);
+	Record.LeftClickCount = static_cast<int32>(PackedCount);
+
+	Ar << Record.Location;
+	Ar << Record.Rotation;
+
+	return Ar;
+}
+
+FArchive& operator<<(FArchive& Ar, FWeaponSnapshotLoadout& Loadout)
+{
+	Ar << Loadout.Key;
+	Ar << Loadout.ActiveSlotIndex;
+
+	return Ar;
+}
+
+
+//----------[ Subsystem ]----------
+UWeaponSnapshotSubsystem::UWeaponSnapshotSubsystem()
+{
+	//Default Value, Override in DefaultGame.ini
+	AutoSaveInterval = 10.0f;
+	bRestoreOnBeginPlay = false;
+	bDestroyUnlistedWeapons = false;
+	SnapshotFileName = TEXT("WeaponSnapshot.bin");
+}
+
+bool UWeaponSnapshotSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UWeaponSnapshotSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	//Server only, Client Receive Restored Weapons by Replication
+	if (InWorld.GetNetMode() == NM_Client)
+	{
+		return;
+	}
+
+	//Restore is Opt In, Config or -WeaponSnapshotRestore of Server Command Line
+	//Otherwise Fresh Match would Load Old Match's Weapons
+	if (bRestoreOnBeginPlay == true || FParse::Param(FCommandLine::Get(), TEXT("WeaponSnapshotRestore")) == true)
+	{
+		//Next Tick, Placed Weapons and Characters have Begun Play
+		InWorld.GetTimerManager().SetTimerForNextTick(FTimerDelegate::CreateWeakLambda(this, [this]()
+		{
+			LoadSnapshot();
+		}));
+	}
+
+	if (AutoSaveInterval > 0.0f)
+	{
+		InWorld.GetTimerManager().SetTimer(AutoSaveTimerHandle, FTimerDelegate::CreateUObject(this, &UWeaponSnapshotSubsystem::AutoSave), AutoSaveInterval, true);
+	}
+}
+
+void UWeaponSnapshotSubsystem::Deinitialize()
+{
+	GetWorld()->GetTimerManager().ClearTimer(AutoSaveTimerHandle);
+
+	//Don't Leave Half Written Temp File
+	if (SaveTask.IsValid() == true)
+	{
+		SaveTask.Wait();
+	}
+
+	PendingLoadouts.Reset();
+
+	Super::Deinitialize();
+}
+
+void UWeaponSnapshotSubsystem::AutoSave()
+{
+	SaveSnapshot();
+}
+
+FString UWeaponSnapshotSubsystem::GetSnapshotPath() const
+{
+	//Servers on Same Machine Share Saved Folder, File Name has Session Id
+	//-WeaponSnapshotId=Name of Command Line, Listen Port if not Set
+	FString SessionId;
+	if (FParse::Value(FCommandLine::Get(), TEXT("WeaponSnapshotId="), SessionId) == false || SessionId.IsEmpty() == true)
+	{
+		SessionId = FString::Printf(TEXT("Port%d"), GetWorld()->URL.Port);
+	}
+
+	const FString FileName = FString::Printf(TEXT("%s_%s.%s"), *FPaths::GetBaseFilename(SnapshotFileName), *FPaths::MakeValidFileName(SessionId), *FPaths::GetExtension(SnapshotFileName));
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Snapshots"), FileName);
+}
+
+FString UWeaponSnapshotSubsystem::GetLoadoutKey(const AFHProjectCharacter* Character)
+{
+	if (const APlayerState* PlayerState = Character->GetPlayerState())
+	{
+		//Unique Id Survive Reconnect, Name is Fallback for Null Online Subsystem
+		const FUniqueNetIdRepl& UniqueId = PlayerState->GetUniqueId();
+		return FString(TEXT("Player:")) + (UniqueId.IsValid() == true ? UniqueId.ToString() : PlayerState->GetPlayerName());
+	}
+
+	//Placed Character has Same Name after Map Reload
+	if (Character->IsNetStartupActor() == true)
+	{
+		return FString(TEXT("Actor:")) + Character->GetFName().ToString();
+	}
+
+	return FString();
+}
+
+bool UWeaponSnapshotSubsystem::SaveSnapshot()
+{
+	UWorld* World = GetWorld();
+	if (World->GetNetMode() == NM_Client)
+	{
+		return false;
+	}
+
+	if (SaveTask.IsValid() == true && SaveTask.IsReady() == false)
+	{
+		UE_LOG(LogClass, Warning, TEXT("WeaponSnapshot::SaveSnapshot :: Previous Write is Running"));
+		return false;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	TArray<FString> ClassPaths;
+	TMap<UClass*, int32> ClassIndices;
+	TArray<FWeaponSnapshotLoadout> Loadouts;
+	TMap<AFHProjectCharacter*, int32> LoadoutIndices;
+	TArray<FWeaponSnapshotRecord> Records;
+
+	for (TActorIterator<ABaseWeapon> It(World); It; ++It)
+	{
+		ABaseWeapon* Weapon = *It;
+		if (IsValid(Weapon) == false || Weapon->IsActorBeingDestroyed() == true)
+		{
+			continue;
+		}
+
+		//NPC Loadout is Default Weapon, Given Again When NPC is Possessed
+		AFHProjectCharacter* OwnerCharacter = Cast<AFHProjectCharacter>(Weapon->GetOwnerCharacter());
+		if (OwnerCharacter != nullptr && OwnerCharacter->IsPlayerControlled() == false)
+		{
+			continue;
+		}
+
+		UClass* WeaponClass = Weapon->GetClass();
+		int32 ClassIndex = INDEX_NONE;
+		if (const int32* FoundClassIndex = ClassIndices.Find(WeaponClass))
+		{
+			ClassIndex = *FoundClassIndex;
+		}
+		else
+		{
+			ClassIndex = ClassPaths.Add(FSoftClassPath(WeaponClass).ToString());
+			ClassIndices.Add(WeaponClass, ClassIndex);
+		}
+
+		FWeaponSnapshotRecord& Record = Records.AddDefaulted_GetRef();
+		Record.ClassIndex = static_cast<uint16>(ClassIndex);
+		Record.LeftClickCount = Weapon->GetLeftClickCount();
+		Record.Location = FVector3f(Weapon->GetActorLocation());
+		Record.Rotation = FQuat4f(Weapon->GetActorQuat());
+
+		const int32 SlotIndex = OwnerCharacter != nullptr ? OwnerCharacter->GetInventory().FindSlotIndex(Weapon) : INDEX_NONE;
+		const FString LoadoutKey = SlotIndex != INDEX_NONE ? GetLoadoutKey(OwnerCharacter) : FString();
+
+		if (LoadoutKey.IsEmpty() == true)
+		{
+			Record.bIsProxied = Weapon->IsProxied() == true ? 1 : 0;
+			continue;
+		}
+
+		//Held Weapon Actor is Hidden where Picked up, Drop at Owner if Owner never Return
+		Record.Location = FVector3f(OwnerCharacter->GetActorLocation());
+		Record.Rotation = FQuat4f::Identity;
+		Record.SlotIndex = static_cast<uint8>(SlotIndex);
+
+		if (const int32* FoundLoadoutIndex = LoadoutIndices.Find(OwnerCharacter))
+		{
+			Record.LoadoutIndex = static_cast<int16>(*FoundLoadoutIndex);
+		}
+		else
+		{
+			FWeaponSnapshotLoadout Loadout;
+			Loadout.Key = LoadoutKey;
+			Loadout.ActiveSlotIndex = static_cast<int8>(OwnerCharacter->GetActiveSlotIndex());
+
+			const int32 LoadoutIndex = Loadouts.Add(MoveTemp(Loadout));
+			LoadoutIndices.Add(OwnerCharacter, LoadoutIndex);
+			Record.LoadoutIndex = static_cast<int16>(LoadoutIndex);
+		}
+	}
+
+	//About 40 Bytes per Weapon, Hundreds of Weapons are a Few KB
+	TArray<uint8> Bytes;
+	Bytes.Reserve(256 + Records.Num() * 40);
+	FMemoryWriter Writer(Bytes, true);
+
+	uint32 Magic = WeaponSnapshot::Magic;
+	uint16 Version = WeaponSnapshot::Version;
+	int64 SaveTime = FDateTime::UtcNow().ToUnixTimestamp();
+	FString MapName = UWorld::RemovePIEPrefix(World->GetMapName());
+	Writer << Magic;
+	Writer << Version;
+	Writer << SaveTime;
+	Writer << MapName;
+
+	int32 NumClasses = ClassPaths.Num();
+	Writer << NumClasses;
+	for (FString& ClassPath : ClassPaths)
+	{
+		Writer << ClassPath;
+	}
+
+	int32 NumLoadouts = Loadouts.Num();
+	Writer << NumLoadouts;
+	for (FWeaponSnapshotLoadout& Loadout : Loadouts)
+	{
+		Writer << Loadout;
+	}
+
+	int32 NumRecords = Records.Num();
+	Writer << NumRecords;
+	for (FWeaponSnapshotRecord& Record : Records)
+	{
+		Writer << Record;
+	}
+
+	const double GatherTime = FPlatformTime::Seconds() - StartTime;
+
+	//File Write on Background, Game Thread only Gather
+	SaveTask = Async(EAsyncExecution::ThreadPool, [Bytes = MoveTemp(Bytes), Path = GetSnapshotPath()]()
+	{
+		//Write Temp then Move, Crash While Writing never Break Last Snapshot
+		const FString TempPath = Path + TEXT(".tmp");
+		if (FFileHelper::SaveArrayToFile(Bytes, *TempPath) == false || IFileManager::Get().Move(*Path, *TempPath, true, true) == false)
+		{
+			UE_LOG(LogClass, Warning, TEXT("WeaponSnapshot::SaveSnapshot :: Write Failed %s"), *Path);
+			return false;
+		}
+
+		return true;
+	});
+
+	UE_LOG(LogClass, Log, TEXT("WeaponSnapshot::SaveSnapshot :: %d Weapons, %d Loadouts, %.2f ms"), NumRecords, NumLoadouts, GatherTime * 1000.0);
+
+	return true;
+}
+
+bool UWeaponSnapshotSubsystem::LoadSnapshot()
+{
+	if (GetWorld()->GetNetMode() == NM_Client)
+	{
+		return false;
+	}
+
+	//Read Latest Snapshot, not File Being Replaced
+	if (SaveTask.IsValid() == true)
+	{
+		SaveTask.Wait();
+	}
+
+	const FString Path = GetSnapshotPath();
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	if (PlatformFile.FileExists(*Path) == false)
+	{
+		UE_LOG(LogClass, Log, TEXT("WeaponSnapshot::LoadSnapshot :: No Snapshot %s"), *Path);
+		return false;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	bool bRestored = false;
+
+	//Read Mapped Pages Directly, No Copy of File
+	TUniquePtr<IMappedFileHandle> MappedFile(PlatformFile.OpenMapped(*Path));
+	TUniquePtr<IMappedFileRegion> MappedRegion(MappedFile.IsValid() == true ? MappedFile->MapRegion() : nullptr);
+	if (MappedRegion.IsValid() == true)
+	{
+		FBufferReader Reader(const_cast<uint8*>(MappedRegion->GetMappedPtr()), MappedRegion->GetMappedSize(), false, true);
+		bRestored = RestoreSnapshot(Reader);
+	}
+	else
+	{
+		//Platform without Mapped File
+		TArray<uint8> Bytes;
+		if (FFileHelper::LoadFileToArray(Bytes, *Path) == true)
+		{
+			FMemoryReader Reader(Bytes, true);
+			bRestored = RestoreSnapshot(Reader);
+		}
+	}
+
+	//Region before Handle
+	MappedRegion.Reset();
+	MappedFile.Reset();
+
+	UE_LOG(LogClass, Log, TEXT("WeaponSnapshot::LoadSnapshot :: %s, %.2f ms"), bRestored == true ? TEXT("Restored") : TEXT("Failed"), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+	return bRestored;
+}
+
+bool UWeaponSnapshotSubsystem::RestoreSnapshot(FArchive& Ar)
+{
+	UWorld* World = GetWorld();
+
+	//----------[ Read ]----------
+	//Read Everything before Touching World, Broken File Change Nothing
+	uint32 Magic = 0;
+	uint16 Version = 0;
+	Ar << Magic;
+	Ar << Version;
+	if (Ar.IsError() == true || Magic != WeaponSnapshot::Magic)
+	{
+		UE_LOG(LogClass, Warning, TEXT("WeaponSnapshot::RestoreSnapshot :: Not Snapshot File"));
+		return false;
+	}
+
+	if (Version != WeaponSnapshot::Version)
+	{
+		UE_LOG(LogClass, Warning, TEXT("WeaponSnapshot::RestoreSnapshot :: Version %d, Expected %d"), Version, WeaponSnapshot::Version);
+		return false;
+	}
+
+	int64 SaveTime = 0;
+	FString MapName;
+	Ar << SaveTime;
+	Ar << MapName;
+	if (MapName != UWorld::RemovePIEPrefix(World->GetMapName()))
+	{
+		UE_LOG(LogClass, Warning, TEXT("WeaponSnapshot::RestoreSnapshot :: Snapshot of Other Map %s"), *MapName);
+		return false;
+	}
+
+	//Every Entry is at least One Byte, Count over File Size is Broken
+	const int64 MaxCount = Ar.TotalSize();
+
+	int32 NumClasses = 0;
+	Ar << NumClasses;
+	if (NumClasses < 0 || NumClasses > MaxCount || NumClasses > MAX_uint16)
+	{
+		UE_LOG(LogClass, Warning, TEXT("WeaponSnapshot::RestoreSnapshot :: Invalid Class Count %d"), NumClasses);
+		return false;
+	}
+
+	//Resolve Class Once, not per Weapon
+	TArray<UClass*> Classes;
+	Classes.Reserve(NumClasses);
+	for (int32 ClassIndex = 0; ClassIndex < NumClasses && Ar.IsError() == false; ++ClassIndex)
+	{
+		FString ClassPath;
+		Ar << ClassPath;
+
+		UClass* WeaponClass = FSoftClassPath(ClassPath).TryLoadClass<ABaseWeapon>();
+		if (WeaponClass == nullptr)
+		{
+			UE_LOG(LogClass, Warning, TEXT("WeaponSnapshot::RestoreSnapshot :: Class not Found %s"), *ClassPath);
+		}
+
+		Classes.Add(WeaponClass);
+	}
+
+	int32 NumLoadouts = 0;
+	Ar << NumLoadouts;
+	if (NumLoadouts < 0 || NumLoadouts > MaxCount || NumLoadouts > MAX_int16)
+	{
+		UE_LOG(LogClass, Warning, TEXT("WeaponSnapshot::RestoreSnapshot :: Invalid Loadout Count %d"), NumLoadouts);
+		return false;
+	}
+
+	TArray<FWeaponSnapshotLoadout> Loadouts;
+	Loadouts.SetNum(NumLoadouts);
+	for (FWeaponSnapshotLoadout& Loadout : Loadouts)
+	{
+		Ar << Loadout;
+	}
+
+	int32 NumRecords = 0;
+	Ar << NumRecords;
+	if (NumRecords < 0 || NumRecords > MaxCount)
+	{
+		UE_LOG(LogClass, Warning, TEXT("WeaponSnapshot::RestoreSnapshot :: Invalid Weapon Count %d"), NumRecords);
+		return false;
+	}
+
+	TArray<FWeaponSnapshotRecord> Records;
+	Records.SetNum(NumRecords);
+	for (FWeaponSnapshotRecord& Record : Records)
+	{
+		Ar << Record;
+	}
+
+	if (Ar.IsError() == true)
+	{
+		UE_LOG(LogClass, Warning, TEXT("WeaponSnapshot::RestoreSnapshot :: Truncated File"));
+		return false;
+	}
+
+	//----------[ Pool ]----------
+	//Unowned World Weapon is Reused, Placed Weapons of Reloaded Map Cost No Spawn
+	TMap<UClass*, TArray<ABaseWeapon*>> Pool;
+	for (TActorIterator<ABaseWeapon> It(World); It; ++It)
+	{
+		if (It->GetOwnerCharacter() == nullptr && It->IsActorBeingDestroyed() == false)
+		{
+			Pool.FindOrAdd(It->GetClass()).Add(*It);
+		}
+	}
+
+	TArray<FPendingWeaponLoadout> RestoredLoadouts;
+	RestoredLoadouts.SetNum(NumLoadouts);
+	for (int32 LoadoutIndex = 0; LoadoutIndex < NumLoadouts; ++LoadoutIndex)
+	{
+		RestoredLoadouts[LoadoutIndex].ActiveSlotIndex = Loadouts[LoadoutIndex].ActiveSlotIndex;
+	}
+
+	//----------[ Spawn ]----------
+	int32 NumPooled = 0;
+	int32 NumSpawned = 0;
+	for (const FWeaponSnapshotRecord& Record : Records)
+	{
+		UClass* WeaponClass = Classes.IsValidIndex(Record.ClassIndex) == true ? Classes[Record.ClassIndex] : nullptr;
+		if (WeaponClass == nullptr)
+		{
+			continue;
+		}
+
+		const FTransform Transform(FQuat(Record.Rotation), FVector(Record.Location));
+
+		ABaseWeapon* Weapon = nullptr;
+		TArray<ABaseWeapon*>* PooledWeapons = Pool.Find(WeaponClass);
+		if (PooledWeapons != nullptr && PooledWeapons->Num() > 0)
+		{
+			Weapon = PooledWeapons->Pop(false);
+
+			//Leave Instance First, Instance Stay at Old Transform
+			Weapon->SetProxied(false);
+			Weapon->SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+			++NumPooled;
+		}
+		else
+		{
+			//Deferred, Construction Script Run Once at Final Transform
+			Weapon = World->SpawnActorDeferred<ABaseWeapon>(WeaponClass, Transform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+			if (Weapon == nullptr)
+			{
+				continue;
+			}
+
+			Weapon->FinishSpawning(Transform);
+			++NumSpawned;
+		}
+
+		if (RestoredLoadouts.IsValidIndex(Record.LoadoutIndex) == true)
+		{
+			FPendingWeaponLoadout& Loadout = RestoredLoadouts[Record.LoadoutIndex];
+			Loadout.SlotWeapons.Emplace(Record.SlotIndex, Weapon);
+			Loadout.LeftClickCounts.Emplace(Weapon, Record.LeftClickCount);
+			continue;
+		}
+
+		Weapon->RestoreLeftClickCount(Record.LeftClickCount);
+
+		//Resting Weapon Skip Physics Settle, Instance Now
+		if (Record.bIsProxied != 0)
+		{
+			Weapon->SetProxied(true);
+		}
+	}
+
+	//Snapshot is Whole World State, Weapon not in Snapshot was Picked up or Destroyed
+	int32 NumDestroyed = 0;
+	if (bDestroyUnlistedWeapons == true)
+	{
+		for (TPair<UClass*, TArray<ABaseWeapon*>>& PooledWeapons : Pool)
+		{
+			for (ABaseWeapon* Weapon : PooledWeapons.Value)
+			{
+				Weapon->Destroy();
+				++NumDestroyed;
+			}
+		}
+	}
+
+	//----------[ Loadout ]----------
+	TMap<FString, AFHProjectCharacter*> Characters;
+	for (TActorIterator<AFHProjectCharacter> It(World); It; ++It)
+	{
+		const FString LoadoutKey = GetLoadoutKey(*It);
+		if (LoadoutKey.IsEmpty() == false)
+		{
+			Characters.Add(LoadoutKey, *It);
+		}
+	}
+
+	PendingLoadouts.Reset();
+	for (int32 LoadoutIndex = 0; LoadoutIndex < NumLoadouts; ++LoadoutIndex)
+	{
+		if (AFHProjectCharacter* const* Character = Characters.Find(Loadouts[LoadoutIndex].Key))
+		{
+			ApplyLoadout(*Character, RestoredLoadouts[LoadoutIndex]);
+		}
+		else
+		{
+			//Player not Joined yet, Weapons Wait in World at Owner Location
+			PendingLoadouts.Add(Loadouts[LoadoutIndex].Key, MoveTemp(RestoredLoadouts[LoadoutIndex]));
+		}
+	}
+
+	UE_LOG(LogClass, Log, TEXT("WeaponSnapshot::RestoreSnapshot :: %d Weapons (%d Pooled, %d Spawned, %d Destroyed), %d Loadouts (%d Pending)"), NumRecords, NumPooled, NumSpawned, NumDestroyed, NumLoadouts, PendingLoadouts.Num());
+
+	return true;
+}
+
+void UWeaponSnapshotSubsystem::ApplyPendingLoadout(AFHProjectCharacter* Character)
+{
+	if (Character == nullptr || PendingLoadouts.Num() == 0)
+	{
+		return;
+	}
+
+	FPendingWeaponLoadout Loadout;
+	if (PendingLoadouts.RemoveAndCopyValue(GetLoadoutKey(Character), Loadout) == true)
+	{
+		ApplyLoadout(Character, Loadout);
+	}
+}
+
+void UWeaponSnapshotSubsystem::ApplyLoadout(AFHProjectCharacter* Character, const FPendingWeaponLoadout& Loadout)
+{
+	for (const TPair<int32, TWeakObjectPtr<ABaseWeapon>>& SlotWeapon : Loadout.SlotWeapons)
+	{
+		//Picked up by Other Player While Waiting
+		ABaseWeapon* Weapon = SlotWeapon.Value.Get();
+		if (Weapon == nullptr || Weapon->GetOwnerCharacter() != nullptr)
+		{
+			continue;
+		}
+
+		Character->RestoreInventorySlot(SlotWeapon.Key, Weapon);
+	}
+
+	Character->RestoreActiveSlot(Loadout.ActiveSlotIndex);
+
+	//After Active Slot, Active Weapon's Count is Combo Count
+	for (const TPair<TWeakObjectPtr<ABaseWeapon>, int32>& LeftClickCount : Loadout.LeftClickCounts)
+	{
+		ABaseWeapon* Weapon = LeftClickCount.Key.Get();
+		if (Weapon != nullptr && Weapon->GetOwnerCharacter() == Character)
+		{
+			Weapon->RestoreLeftClickCount(LeftClickCount.Value);
+		}
+	}
+}
@@ -0,0 +1,205 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+#include "LatencyTraceSubsystem.h"
+#include "AIBrainSubsystem.generated.h"
+
+class AFHAIController;
+class AFHCharacter;
+class AFHProjectCharacter;
+
+UENUM(BlueprintType)
+enum class EAIBrainState : uint8
+{
+	//No Visible Target
+	Idle UMETA(DisplayName = "Idle"),
+	//Move to Target until in Attack Range
+	Chase UMETA(DisplayName = "Chase"),
+	//In Range, Attack by Input Command
+	Attack UMETA(DisplayName = "Attack"),
+};
+
+//One NPC Decision State
+struct FAIBrain
+{
+	//Stable Id, Async Trace Find Brain by this, Index Change by Remove Swap
+	uint32 BrainId = 0;
+
+	TWeakObjectPtr<AFHAIController> Controller;
+
+	TWeakObjectPtr<AFHCharacter> Character;
+
+	EAIBrainState State = EAIBrainState::Idle;
+
+	//Last Seen Target, Forgotten after Lose Sight Time
+	TWeakObjectPtr<AFHProjectCharacter> Target;
+
+	//Goal of Current Move Request, Move is Sent Again When Target Change
+	TWeakObjectPtr<AFHProjectCharacter> ChaseTarget;
+
+	double LastSeenTime = -UE_BIG_NUMBER;
+
+	//Line of Sight Trace Waiting or in Flight, One per Brain
+	TWeakObjectPtr<AFHProjectCharacter> PendingCandidate;
+
+	bool bIsTracePending = false;
+
+	//Index in Distance Sorted Candidates of Next Trace, Step When Blocked, Reset When Seen
+	int32 CandidateCursor = 0;
+
+	double NextThinkTime = 0.0;
+
+	double NextAttackTime = 0.0;
+};
+
+/**
+ * Server NPC Brains, One Tick for every FHAIController
+ * Think is Time Sliced, Round Robin under Frame Budget, Overdue Brain Wait Next Frame
+ * Perception Candidate by Combat Capsule Broadphase, Line of Sight is Batched Async Trace
+ * One Trace per Think, Candidates Tried Nearest First until One is Visible
+ * Trace Result Arrive Next Frame, Brain never Wait Physics in Think
+ * Attack is Input Command, Same Combo and Weapon Interface as Player
+ *
+ * Console : Weapon.AI.Report, Weapon.AI.Reset
+ * Automation : Weapon.AI.Budget, N Armed NPCs against Think Budget and Frame Time
+ */
+UCLASS(config = Game)
+class WEAPON_API UAIBrainSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UAIBrainSubsystem();
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+public:
+	//Server, Controller Register When Possess, Unregister When UnPossess
+	void RegisterBrain(AFHAIController* Controller, AFHCharacter* Character);
+
+	void UnregisterBrain(AFHAIController* Controller);
+
+	int32 GetBrainCount() const { return Brains.Num(); };
+
+	//Brains in State Now
+	int32 GetBrainCount(EAIBrainState State) const;
+
+	//Log Think Cost per Frame, Think and Trace Count, Think Lag
+	void Report() const;
+
+	void ResetStats();
+
+	const FLatencyHistogram& GetThinkCostHistogram() const { return ThinkCostHistogram; };
+
+	const FLatencyHistogram& GetThinkLagHistogram() const { return ThinkLagHistogram; };
+
+	int64 GetBudgetExceededCount() const { return BudgetExceededCount; };
+
+	int64 GetAttackCount() const { return AttackCount; };
+
+protected:
+	//Run Due Brains until Budget is Used
+	void TickThinks(double CurrentTime);
+
+	void Think(FAIBrain& Brain, double CurrentTime);
+
+	//Pick Hostile in Sight Radius by Distance, Queue Line of Sight Trace
+	//Blocked Candidate is Skipped Next Think, Farther Visible Hostile is Found
+	void UpdatePerception(FAIBrain& Brain, AFHCharacter* Character);
+
+	//Server, Press Attack Button When Combo Allow
+	void TryAttack(FAIBrain& Brain, AFHCharacter* Character, double CurrentTime);
+
+	//Send Queued Line of Sight Traces, Max per Frame
+	void FlushPerceptionTraces();
+
+	void OnPerceptionTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
+
+	bool IsHostile(const AFHCharacter* Character, const AFHProjectCharacter* Other) const;
+
+	//Range Weapon use its Attack Range, Melee use Config
+	float GetAttackRange(AFHCharacter* Character) const;
+
+	int32 FindBrainIndex(uint32 BrainId) const;
+
+	int32 FindBrainIndex(const AFHAIController* Controller) const;
+
+protected:
+	TArray<FAIBrain> Brains;
+
+	//Brain Id Waiting Line of Sight Trace, First In First Out
+	TArray<uint32> PerceptionQueue;
+
+	FTraceDelegate PerceptionTraceDelegate;
+
+	uint32 NextBrainId;
+
+	//Round Robin Start, Next Frame Continue from Here
+	int32 NextBrainIndex;
+
+	//----------[ Stats ]----------
+	FLatencyHistogram ThinkCostHistogram;
+
+	//Think Start - Due Time, Starved Brain Show Here
+	FLatencyHistogram ThinkLagHistogram;
+
+	int64 ThinkCount;
+
+	int64 TraceCount;
+
+	//Attack Input Sent to Character
+	int64 AttackCount;
+
+	//Frame Stopped by Budget with Due Brain Left
+	int64 BudgetExceededCount;
+
+	//----------[ Config ]----------
+	//Think Budget per Frame, Millisecond
+	UPROPERTY(Config)
+	float MaxThinkMSPerFrame;
+
+	//Min Second between Thinks of One Brain
+	UPROPERTY(Config)
+	float ThinkInterval;
+
+	UPROPERTY(Config)
+	int32 MaxTracesPerFrame;
+
+	UPROPERTY(Config)
+	float SightRadius;
+
+	//Target is Forgotten When not Seen this Long
+	UPROPERTY(Config)
+	float LoseSightTime;
+
+	UPROPERTY(Config)
+	float MeleeAttackRange;
+
+	//Second between Attack Inputs, Combo Buffer Handle Early Input
+	UPROPERTY(Config)
+	float AttackInterval;
+
+	//Right Click When Left Click Count Reach this
+	UPROPERTY(Config)
+	int32 FinisherComboCount;
+
+	//Move on Nav Mesh, Direct Move if Path Fail
+	UPROPERTY(Config)
+	bool bUsePathfinding;
+
+	//NPC Attack other NPC, Otherwise Player only
+	UPROPERTY(Config)
+	bool bTargetOtherNPCs;
+};
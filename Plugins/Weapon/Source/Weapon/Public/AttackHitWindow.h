@@ -0,0 +1,71 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AttackHitWindow.generated.h"
+
+class UAnimMontage;
+class USkeletalMesh;
+class UStaticMesh;
+
+/**
+ * One ApplyDamage notify window baked out of an attack montage.
+ * Socket paths are stored in Character Mesh Component space, so the server only needs the mesh component transform.
+ */
+USTRUCT()
+struct WEAPON_API FBakedAttackWindow
+{
+	GENERATED_BODY()
+
+	//Montage Time When Notify Begin
+	UPROPERTY(VisibleAnywhere, Category = "Hit Window")
+	float StartTime = 0.0f;
+
+	//Montage Time When Notify End
+	UPROPERTY(VisibleAnywhere, Category = "Hit Window")
+	float EndTime = 0.0f;
+
+	//Time between two Samples
+	UPROPERTY(VisibleAnywhere, Category = "Hit Window")
+	float SampleInterval = 0.0f;
+
+	//Attack_Start Socket Path, Mesh Component Space
+	UPROPERTY(VisibleAnywhere, Category = "Hit Window")
+	TArray<FVector3f> StartSocketPath;
+
+	//Attack_End Socket Path, Mesh Component Space
+	UPROPERTY(VisibleAnywhere, Category = "Hit Window")
+	TArray<FVector3f> EndSocketPath;
+
+public:
+	//Return Interpolated Socket Location at MontageTime, Mesh Component Space
+	void Sample(float MontageTime, FVector& OutStartLocation, FVector& OutEndLocation) const;
+};
+
+/**
+ * All Hit Windows of one Attack Montage
+ */
+USTRUCT()
+struct WEAPON_API FBakedAttackCurve
+{
+	GENERATED_BODY()
+
+	//Baked Montage, Check this When Montage Changed
+	UPROPERTY(VisibleAnywhere, Category = "Hit Window")
+	UAnimMontage* Montage = nullptr;
+
+	//Sorted by StartTime
+	UPROPERTY(VisibleAnywhere, Category = "Hit Window")
+	TArray<FBakedAttackWindow> Windows;
+
+public:
+	//Return true When Curve is Baked from TargetMontage
+	bool IsValidFor(const UAnimMontage* TargetMontage) const;
+
+#if WITH_EDITOR
+	//Bake Notify Windows and Socket Paths from Montage
+	//CharacterSocketName is the Socket on Character Mesh where Weapon Attached
+	bool Bake(UAnimMontage* TargetMontage, const USkeletalMesh* CharacterMesh, FName CharacterSocketName, const UStaticMesh* WeaponMesh, FName StartSocketName, FName EndSocketName, float SampleRate);
+#endif
+};
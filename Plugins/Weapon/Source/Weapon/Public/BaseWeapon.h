@@ -4,11 +4,31 @@
 
 #include "CoreMinimal.h"
 #include "WeaponInterface.h"
+#include "AttackHitWindow.h"
+#include "ProjectileSubsystem.h"
+#include "CombatWorldSubsystem.h"
 #include "GameFramework/Actor.h"
 #include "BaseWeapon.generated.h"
 
 
 enum class EItemType : uint8;
+class USkeletalMesh;
+
+//Attack Hit Shape, Multi Hit Shape Resolve every Target by One Query
+UENUM(BlueprintType)
+enum class EAttackShape : uint8
+{
+	//First Blocking Hit Only
+	Single UMETA(DisplayName = "Single"),
+	//Horizontal Arc around Owner
+	Arc UMETA(DisplayName = "Arc"),
+	//Cone along Owner's Aim
+	Cone UMETA(DisplayName = "Cone"),
+	//Sphere Swept along Attack Segment
+	CapsuleSweep UMETA(DisplayName = "CapsuleSweep"),
+	//Line Pass through every Target
+	PiercingLine UMETA(DisplayName = "PiercingLine"),
+};
 
 UCLASS()
 class WEAPON_API ABaseWeapon : public AActor, public IWeaponInterface
@@ -23,9 +43,11 @@ protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
-public:	
-	// Called every frame
-	virtual void Tick(float DeltaTime) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+public:
+	// Held Weapon is not Moved with Character, Relevant When Owner Character is Relevant
+	virtual bool IsNetRelevantFor(const AActor* RealViewer, const AActor* ViewTarget, const FVector& SrcLocation) const override;
 
 public:
 	UFUNCTION()
@@ -80,9 +102,13 @@ protected:
 
 	//----------[ Value ]----------
 	//Add Count When Completed Left Click Attack, Reset Count When Right Click Attack
-	UPROPERTY(Replicated)
+	//Every Machine Count by Multicast Attack, Server Correct Owner Only
+	UPROPERTY(ReplicatedUsing = OnRep_LeftClickCount)
 	int32 LeftClickCount;
 
+	//Right Click Damage by LeftClickCount, Updated When Count or Damage Changed
+	float CachedRightClickDamage;
+
 	//Attack Effect Scale Value
 	FVector AttackEffectScale;
 
@@ -142,6 +168,110 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Range Weapon Setting")
 	float AttackRange;
 
+	//Launch Projectile instead of Line Trace, Throwing Weapon use this
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Range Weapon Setting")
+	bool bUseProjectile;
+
+	//Projectile Visual, Weapon's StaticMesh if nullptr
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Range Weapon Setting")
+	UStaticMesh* ProjectileMesh;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Range Weapon Setting")
+	float ProjectileSpeed;
+
+	//World Gravity Scale
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Range Weapon Setting")
+	float ProjectileGravityScale;
+
+	//Linear Drag, Velocity Lost per Second
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Range Weapon Setting")
+	float ProjectileDrag;
+
+	//Sweep Sphere Radius
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Range Weapon Setting")
+	float ProjectileRadius;
+
+
+	//----------[ Multi Hit ]----------
+	//Left Click Attack Shape
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Multi Hit Setting")
+	EAttackShape AttackShape;
+
+	//Right Click Attack Shape
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Multi Hit Setting")
+	EAttackShape SpecialAttackShape;
+
+	//Arc and Cone Radius from Owner
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Multi Hit Setting")
+	float AreaAttackRadius;
+
+	//Arc and Cone Half Angle, Degree
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Multi Hit Setting")
+	float AreaAttackHalfAngle;
+
+	//Max Damaged Targets in One Attack
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Multi Hit Setting")
+	int32 MaxTargets;
+
+	//Damage Scale Lost per Target, Nearest Target get Full Damage
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Multi Hit Setting")
+	float MultiHitFalloff;
+
+	//Falloff can't Reduce Damage Scale under this
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Multi Hit Setting")
+	float MinMultiHitDamageScale;
+
+
+	//----------[ Baked Hit Window ]----------
+	//Hit Windows Baked from AttackMontage, Server use this instead of Anim Notify
+	UPROPERTY(VisibleAnywhere, Category = "Baked Hit Window")
+	FBakedAttackCurve BakedAttackCurve;
+
+	//Hit Windows Baked from SpecialAttackMontage
+	UPROPERTY(VisibleAnywhere, Category = "Baked Hit Window")
+	FBakedAttackCurve BakedSpecialAttackCurve;
+
+	//Socket Path Sample Rate When Bake
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Baked Hit Window")
+	float BakedHitSampleRate;
+
+#if WITH_EDITORONLY_DATA
+	//Character Mesh used for Bake, Need Weapon Socket
+	UPROPERTY(EditDefaultsOnly, Category = "Baked Hit Window")
+	USkeletalMesh* BakeCharacterMesh;
+
+	//Character Mesh's Weapon Socket Name used for Bake
+	UPROPERTY(EditDefaultsOnly, Category = "Baked Hit Window")
+	FName BakeCharacterSocketName;
+#endif
+
+	//Current Evaluating Baked Curve, Server Only
+	const FBakedAttackCurve* ActiveBakedCurve;
+
+	//Next Window Index to Evaluate
+	int32 BakedWindowIndex;
+
+	//Set When Current Window Opened
+	bool bBakedWindowOpened;
+
+	//Set When Current Window Hit Anything
+	bool bActiveBakedWindowHit;
+
+	//Simulated Montage Time, Advanced by Fixed Step not by Animation Tick
+	float BakedWindowTime;
+
+
+	//----------[ Proxy ]----------
+	//Resting Dropped Weapon is Drawn by WeaponProxySubsystem Instance
+	UPROPERTY(ReplicatedUsing = OnRep_IsProxied)
+	bool bIsProxied;
+
+	//Set When Local Proxy State Applied, Actor Hidden and Instance Added
+	bool bProxyApplied;
+
+	//Collision Before Attach, Restored When Dropped or Promoted from Proxy
+	TEnumAsByte<ECollisionEnabled::Type> DroppedCollisionEnabled;
+
 
 public:
 	//Return OwnerCharacter
@@ -152,17 +282,32 @@ public:
 	//Return LeftClickCount
 	int32 GetLeftClickCount() { return LeftClickCount; };
 
-	//Add LeftClickCount
-	void AddLeftClickCount() { LeftClickCount += 1; };
+	//Add LeftClickCount, CombatWorldSubsystem has Combo Count
+	void AddLeftClickCount();
 
-	//Initialize LeftClickCount
-	//void InitializeLeftClickCount() { LeftClickCount = 0; };
+	//Server, Owner Client Get Reset by Replication
+	void ResetLeftClickCount();
 
-	UFUNCTION(Server, Reliable)
-	void Req_InitializeLeftClickCount();
+	//Server, Weapon Snapshot Restore, Held Active Weapon also Set Combo Count
+	void RestoreLeftClickCount(int32 NewCount);
 
-	UFUNCTION(NetMulticast, Reliable)
-	void Res_InitializeLeftClickCount();
+	UFUNCTION()
+	void OnRep_LeftClickCount();
+
+	//Start Attack Now, Skip Combo Buffer
+	//CombatWorldSubsystem Call this When Buffered Attack Cancel Window Open
+	void StartComboAttack(EAttackPhase NewPhase);
+
+protected:
+	//Add Combo Count, Play Montage and Start Baked Hit Window
+	void StartLeftClickAttack();
+
+	void StartRightClickAttack();
+
+	//Server, Latency Trace Stage of Owner's Click
+	void StampAttackStart();
+
+public:
 
 
 	//Return IsLeftClick Value
@@ -176,10 +321,10 @@ public:
 	int32 GetClickAttackDamage() { return ClickAttackDamage; };
 	
 	//Set Click Attack Damage
-	void SetClickAttackDamage(int32 NewClickAttackDamage) { ClickAttackDamage = NewClickAttackDamage; };
+	void SetClickAttackDamage(int32 NewClickAttackDamage) { ClickAttackDamage = NewClickAttackDamage; UpdateRightClickDamage(); };
 
 	//Set Max Right Click Damage
-	void SetMaxRightClickDamage(float NewMaxRightClickDamage) { MaxRightClickDamage = NewMaxRightClickDamage; };
+	void SetMaxRightClickDamage(float NewMaxRightClickDamage) { MaxRightClickDamage = NewMaxRightClickDamage; UpdateRightClickDamage(); };
 
 	//Return MaxRightClickDamage
 	float GetMaxRightClickDamage() { return MaxRightClickDamage; };
@@ -190,24 +335,140 @@ public:
 	void SetAttackEffectScale(float NewScaleValue) { AttackEffectScale = { NewScaleValue, NewScaleValue, NewScaleValue }; };
 
 
+	//----------[ Inventory ]----------
+	//Attack Socket Source, Owner Character's Equip Weapon Mesh While Held, Otherwise StaticMesh
+	UStaticMeshComponent* GetAttackMeshComponent() const;
+
+
+	//----------[ Proxy ]----------
+	//Server, Demote to Instance or Promote to Actor
+	void SetProxied(bool bNewProxied);
+
+	bool IsProxied() const { return bIsProxied; };
+
+	UFUNCTION()
+	void OnRep_IsProxied();
+
+	//Server, Physics Body Sleep, Demote if not Owned
+	UFUNCTION()
+	void MeshSleep(UPrimitiveComponent* SleepingComponent, FName BoneName);
+
+protected:
+	//Hide Actor and Add Instance, or Remove Instance and Restore Actor
+	void ApplyProxyState();
+
 public:
-	//Return Calculated Right Click Damage
-	float GetCalculatedRightClickDamage();
+	//Return Cached Right Click Damage
+	float GetCalculatedRightClickDamage() const { return CachedRightClickDamage; };
+
+	//Damage of Current Click, Server Use its Own Combo State, not Client Value
+	float GetCurrentAttackDamage() const { return bIsLeftClick == true ? static_cast<float>(ClickAttackDamage) : CachedRightClickDamage; };
+
+	//Calculate Right Click Damage by LeftClickCount
+	void UpdateRightClickDamage();
 
 	//Play AnimMontage, Target is Weapon's OwnerCharacter
 	void PlayAttackAnimMontage(UAnimMontage* TargetAttackMontage);
 
+	//Return false When OwnerCharacter is not Significant, Skip Emitter and Sound
+	bool ShouldSpawnCosmetics() const;
+
+	//Server, Launch Projectile and Send Launch Params
 	void RangeAttack();
 
+	//Client Simulate Projectile from Server Launch Params
+	UFUNCTION(NetMulticast, Unreliable)
+	void Res_LaunchProjectile(const FProjectileLaunchParams& LaunchParams);
+
+	//----------[ Projectile ]----------
+	UStaticMesh* GetProjectileMesh() const;
+
+	float GetProjectileGravityScale() const { return ProjectileGravityScale; };
+
+	float GetProjectileDrag() const { return ProjectileDrag; };
+
+	float GetProjectileRadius() const { return ProjectileRadius; };
+
+	float GetTraceSphereRadius() const { return TraceSphereRadius; };
+
+	bool IsTraceComplex() const { return bTraceComplex; };
+
 	void CloseAttack();
 
 	//Apply Damage to Actor Class
-	UFUNCTION(Server, Reliable)
-	void Req_ApplyDamageToTargetActor(FVector StartLocation, FVector EndLocation, float Damage);
+	//Validate Reject Impossible Value Only (NaN), Invalid Call Disconnect Client
+	//Stale Segment is Clamped or Ignored in Implementation
+	//Damage is not Sent, Server Calculate it from its Own LeftClickCount
+	UFUNCTION(Server, Reliable, WithValidation)
+	void Req_ApplyDamageToTargetActor(FVector StartLocation, FVector EndLocation);
+
+	//Trace and Apply Damage, Server Only
+	//Return true When Trace hit Anything
+	bool ApplyDamageToTargetActor(const FVector& StartLocation, const FVector& EndLocation, float Damage);
+
+	//Resolve Multi Hit Shape by One Query, Damage every Target Once
+	//Return true When any Target Damaged
+	bool ApplyMultiHitDamage(EAttackShape Shape, const FVector& StartLocation, const FVector& EndLocation, float Damage);
+
+	//Resolve Character Target by CombatWorldSubsystem Capsule Broadphase
+	//Physics is WorldStatic Occluder Query, Proxied Weapon Query Only When Proxy Instance is in Range
+	bool ApplyBroadphaseDamage(EAttackShape Shape, const FVector& StartLocation, const FVector& EndLocation, float Damage);
+
+	//Apply Damage with Falloff by Target Order, Nearest Target First
+	void ApplyDamageToHitTargets(const TArray<AActor*>& HitTargets, const TArray<FVector>& HitLocations, const FVector& Origin, const FVector& Direction, float Damage);
+
+	//Return Damage Target of Hit, Proxied Weapon Instance Return its Weapon
+	AActor* GetHitTarget(const FHitResult& HitResult) const;
+
+	//Multi Hit Target Filter, Pawn and Proxied Weapon Only
+	//Wall, Floor and Prop in Query Result are not Target
+	static bool IsDamageableTarget(const AActor* HitTargetObj);
+
+	//Apply Damage to Target, Promote and Push Proxied Weapon
+	//Character Damage is Scaled by Hit Region When its Hitbox is Active
+	void ApplyDamageToHitTarget(AActor* HitTargetObj, const FVector& HitLocation, const FVector& HitDirection, float Damage);
+
+	//Object Types every Attack Query use
+	static FCollisionObjectQueryParams GetAttackObjectQueryParams();
+
+	//Return Baked Curve for Target Montage, nullptr if not Baked
+	const FBakedAttackCurve* GetBakedAttackCurve(const UAnimMontage* TargetMontage) const;
+
+	//Return true When Server can Evaluate Hit without Anim Notify
+	bool HasBakedHitWindow(const UAnimMontage* TargetMontage) const { return bIsRangeWeapon == false && GetBakedAttackCurve(TargetMontage) != nullptr; };
+
+	//Start Evaluate Baked Hit Window, Server Only
+	void StartBakedHitWindow(const UAnimMontage* TargetMontage);
+
+	//Stop Evaluate Baked Hit Window, Reset LeftClickCount if Window Missed
+	void StopBakedHitWindow();
+
+	//Reset LeftClickCount When Attack Missed or Right Click Attack Hit
+	void OnAttackTraceResult(bool bIsHit);
+
+	//Return true While Server Evaluate Baked Hit Window
+	bool IsEvaluatingBakedHitWindow() const { return ActiveBakedCurve != nullptr; };
+
+	//CombatWorldSubsystem Call this every Fixed Step, Sample Baked Socket Path and Trace
+	void TickBakedHitWindow(float DeltaTime);
+
+#if WITH_EDITOR
+	//Bake AttackMontage and SpecialAttackMontage Hit Windows
+	UFUNCTION(CallInEditor, Category = "Baked Hit Window")
+	void BakeAttackHitWindows();
+
+	//Bake Curves without Modify, PreSave use this When Cooking
+	void BakeAttackCurves();
+
+	virtual void PreSave(FObjectPreSaveContext ObjectSaveContext) override;
+#endif
+
+	//Queue Impact Event, Server Only
+	void QueueImpactEvent(const FVector& TargetLocation, const FRotator& TargetRotation);
 
-	//Spawn Emitter At Location
-	UFUNCTION(NetMulticast, Reliable)
-	void Res_SpawnEmitterAtTargetLocation(FVector TargetLocation, FRotator TargetRotation);
+	//Spawn Emitter At Location, Local Only
+	//Server Send Impact by ImpactEventSubsystem, Client Call this When Receive
+	void SpawnImpactEffect(const FVector& TargetLocation, const FRotator& TargetRotation);
 
 
 
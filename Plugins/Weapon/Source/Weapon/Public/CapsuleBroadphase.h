@@ -0,0 +1,53 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+//One Capsule Hit by Broadphase Query
+struct FCapsuleBroadphaseHit
+{
+	//Capsule Index, Same as Combatant Index
+	int32 Index = INDEX_NONE;
+
+	//0 ~ 1 along Query Segment
+	float Time = 0.0f;
+
+	//Point on Capsule Surface Nearest to Query Segment
+	FVector Location = FVector::ZeroVector;
+};
+
+/**
+ * Upright Character Capsules, Packed Structure of Arrays
+ * Query Test Swept Sphere against 4 Capsules at once by Segment to Segment Distance
+ * Array is Padded to Multiple of 4, Padding Lane is Masked
+ */
+struct WEAPON_API FCapsuleBroadphase
+{
+public:
+	//Resize for Capsule Count, Every Capsule must be Set after this
+	void Reset(int32 NewCount);
+
+	//Capsule Axis is World Z
+	void SetCapsule(int32 Index, const FVector& Center, float HalfHeight, float Radius);
+
+	//Swept Sphere against every Capsule, Start == End is Sphere Overlap
+	//Hits are Sorted by Time
+	void Query(const FVector& Start, const FVector& End, float QueryRadius, TArray<FCapsuleBroadphaseHit>& OutHits) const;
+
+	int32 Num() const { return Count; };
+
+private:
+	int32 Count = 0;
+
+	//Capsule Axis Segment, (X, Y, ZMin) to (X, Y, ZMin + Length)
+	TArray<float> AxisX;
+
+	TArray<float> AxisY;
+
+	TArray<float> AxisZMin;
+
+	TArray<float> AxisLength;
+
+	TArray<float> Radii;
+};
@@ -0,0 +1,138 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Components/SkinnedMeshComponent.h"
+#include "CharacterSignificanceSubsystem.generated.h"
+
+class AFHProjectCharacter;
+
+UENUM(BlueprintType)
+enum class ESignificanceTier : uint8
+{
+	High UMETA(DisplayName = "High"),
+	Medium UMETA(DisplayName = "Medium"),
+	Low UMETA(DisplayName = "Low"),
+	Culled UMETA(DisplayName = "Culled"),
+};
+
+/**
+ * Client Side Significance for Characters
+ * Score by Distance, Visibility and Combat, then Set Animation Update Rate, Tick Interval and Cosmetic by Tier
+ * Animation Cost is Bounded by Character Count per Tier, not Measured Frame Time
+ * Tune Tier Count and Tick Interval with stat anim for Target Hardware
+ */
+UCLASS(config = Game)
+class WEAPON_API UCharacterSignificanceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UCharacterSignificanceSubsystem();
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+public:
+	//Character Register When BeginPlay, Unregister When EndPlay
+	void RegisterCharacter(AFHProjectCharacter* Character);
+
+	void UnregisterCharacter(AFHProjectCharacter* Character);
+
+	//Return Character's Tier, High if not Registered
+	ESignificanceTier GetTier(const AActor* Character) const;
+
+	//Return true When Character can Spawn Emitter, Sound
+	bool ShouldSpawnCosmetics(const AActor* Character) const;
+
+protected:
+	struct FCharacterSignificance
+	{
+		TWeakObjectPtr<AFHProjectCharacter> Character;
+
+		float Score = 0.0f;
+
+		ESignificanceTier Tier = ESignificanceTier::High;
+
+		//Applied Tier, Skip Apply When Tier not Changed
+		ESignificanceTier AppliedTier = ESignificanceTier::High;
+
+		//Mesh Setting When Registered, Restore When High Tier
+		EVisibilityBasedAnimTickOption DefaultAnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
+
+		//Leader Mesh When Animation Sharing
+		TWeakObjectPtr<USkinnedMeshComponent> LeaderPoseComponent;
+	};
+
+	//Calculate Score and Tier for every Character
+	void UpdateSignificance();
+
+	//Return Score, Bigger is more Significant
+	float CalculateScore(const AFHProjectCharacter* Character, const FVector& ViewLocation, float& OutDistance) const;
+
+	//Set Mesh Update Rate, Mesh Tick Interval and Attachment by Tier
+	void ApplyTier(FCharacterSignificance& Significance);
+
+	//Low Tier Characters follow one Leader Mesh per Skeletal Mesh Asset
+	void UpdateAnimationSharing();
+
+	int32 FindIndex(const AActor* Character) const;
+
+protected:
+	TArray<FCharacterSignificance> Characters;
+
+	//Time after Last Update
+	float UpdateElapsedTime;
+
+	//----------[ Config ]----------
+	//Significance Update Interval, Second
+	UPROPERTY(Config)
+	float UpdateInterval;
+
+	//Distance Limit for each Tier
+	UPROPERTY(Config)
+	float HighDistance;
+
+	UPROPERTY(Config)
+	float MediumDistance;
+
+	UPROPERTY(Config)
+	float CullDistance;
+
+	//Score Scale When Character not Rendered Recently
+	UPROPERTY(Config)
+	float NotRenderedScoreScale;
+
+	//Score Bonus When Character in Combat
+	UPROPERTY(Config)
+	float CombatScoreBonus;
+
+	//Max Character Count in Tier, Lower Score Character over Count use Next Tier
+	//Count Cap, Each Tier's Tick Interval Bound its Animation Cost
+	UPROPERTY(Config)
+	int32 MaxHighTierCount;
+
+	UPROPERTY(Config)
+	int32 MaxMediumTierCount;
+
+	//Skeletal Mesh Tick Interval for each Tier
+	UPROPERTY(Config)
+	float MediumAnimTickInterval;
+
+	UPROPERTY(Config)
+	float LowAnimTickInterval;
+
+	UPROPERTY(Config)
+	float CulledAnimTickInterval;
+
+	//Low Tier Character Copy Pose from other Character, Optional
+	UPROPERTY(Config)
+	bool bEnableAnimationSharing;
+};
@@ -0,0 +1,153 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Containers/Queue.h"
+#include "Tasks/Task.h"
+#include <atomic>
+#include "CombatEventSubsystem.generated.h"
+
+UENUM(BlueprintType)
+enum class ECombatEventType : uint8
+{
+	//Hit Resolved on Target, Value is Region Multiplier, Count is EHitboxRegion
+	Hit UMETA(DisplayName = "Hit"),
+	//Damage Applied, Value is Final Damage, Count is EHitboxRegion
+	Damage UMETA(DisplayName = "Damage"),
+	Equip UMETA(DisplayName = "Equip"),
+	Drop UMETA(DisplayName = "Drop"),
+	//Combo Count Changed, Count is New Combo Count
+	Combo UMETA(DisplayName = "Combo"),
+	Roll UMETA(DisplayName = "Roll"),
+	Count UMETA(Hidden),
+};
+
+/**
+ * One Combat Event, Copied by Value into Queue
+ * Worker Consumer must not Resolve Weak Pointer, Use Object Id
+ */
+struct WEAPON_API FCombatEvent
+{
+	ECombatEventType Type = ECombatEventType::Hit;
+
+	//World Time When Published on Game Thread, Other Thread's Event is Stamped When Drained
+	double Time = -1.0;
+
+	TWeakObjectPtr<AActor> Instigator;
+
+	TWeakObjectPtr<AActor> Target;
+
+	//Object Unique Id, Safe to Read on Worker Thread
+	uint32 InstigatorId = 0;
+
+	uint32 TargetId = 0;
+
+	FVector3f Location = FVector3f::ZeroVector;
+
+	float Value = 0.0f;
+
+	int32 Count = 0;
+};
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnCombatEvent, const FCombatEvent&);
+
+//Worker Consumer Receive One Batch per Drain
+using FCombatEventBatchHandler = TFunction<void(const TArray<FCombatEvent>&)>;
+
+//One Worker Consumer, Batches Run One at a Time in Drain Order
+struct FCombatEventWorkerConsumer
+{
+	//Shared with Running Task, Called by Reference, Captured State Persist between Batches
+	TSharedPtr<FCombatEventBatchHandler, ESPMode::ThreadSafe> Handler;
+
+	//Last Batch Task, Next Batch Wait it
+	UE::Tasks::FTask LastTask;
+};
+
+/**
+ * Combat Event Bus, Weapon and Character Publish, Consumer never Hook Attack Path
+ * Publish is Lock Free Enqueue (Multi Producer), Nothing When No Consumer
+ * Drained at End of World Tick, Game Thread Listener Broadcast There
+ * Worker Consumer Receive Batch on Background Task, Chained per Consumer, never Run Concurrently with Itself
+ *
+ * Console : Weapon.CombatEvents.Report
+ */
+UCLASS(config = Game)
+class WEAPON_API UCombatEventSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UCombatEventSubsystem();
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+public:
+	//Any Thread
+	void Publish(ECombatEventType Type, const AActor* Instigator, const AActor* Target, const FVector& Location = FVector::ZeroVector, float Value = 0.0f, int32 Count = 0);
+
+	bool HasConsumers() const { return bHasConsumers; };
+
+	//Game Thread Listener, Called When Drained
+	FDelegateHandle AddListener(FOnCombatEvent::FDelegate&& Listener);
+
+	void RemoveListener(FDelegateHandle Handle);
+
+	//Worker Consumer, Batch is Shared between Consumers, Don't Touch UObject
+	//Same Consumer Receive Batches in Order, One at a Time
+	int32 AddWorkerConsumer(FCombatEventBatchHandler&& Handler);
+
+	void RemoveWorkerConsumer(int32 ConsumerId);
+
+	//Drain Now, Tick Drain Automatically
+	void DrainEvents();
+
+	//Log Event Count per Type, Counted by Worker Consumer
+	void Report() const;
+
+protected:
+	void UpdateHasConsumers();
+
+	static const TCHAR* GetEventTypeName(ECombatEventType Type);
+
+protected:
+	//Count Events on Worker Thread, Built in Telemetry
+	//Off by Default, Stats Consumer Keep Publish Always On
+	UPROPERTY(Config)
+	bool bEnableEventStats;
+
+	//Drain Tick Stop after this Many Events, Rest Wait Next Frame
+	UPROPERTY(Config)
+	int32 MaxEventsPerDrain;
+
+	TQueue<FCombatEvent, EQueueMode::Mpsc> EventQueue;
+
+	FOnCombatEvent OnCombatEvent;
+
+	TMap<int32, FCombatEventWorkerConsumer> WorkerConsumers;
+
+	int32 NextConsumerId;
+
+	int32 StatsConsumerId;
+
+	//Read on Publish, any Thread
+	std::atomic<bool> bHasConsumers;
+
+	struct FCombatEventStats
+	{
+		std::atomic<int64> Counts[static_cast<int32>(ECombatEventType::Count)] = {};
+	};
+
+	//Written by Worker Consumer, Shared with Task Still Running at Deinitialize
+	TSharedPtr<FCombatEventStats, ESPMode::ThreadSafe> EventStats;
+};
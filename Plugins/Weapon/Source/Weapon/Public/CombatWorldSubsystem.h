@@ -0,0 +1,216 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WeaponInterface.h"
+#include "CapsuleBroadphase.h"
+#include "CombatWorldSubsystem.generated.h"
+
+class AFHProjectCharacter;
+class ABaseWeapon;
+
+UENUM(BlueprintType)
+enum class EAttackPhase : uint8
+{
+	None UMETA(DisplayName = "None"),
+	LeftClick UMETA(DisplayName = "LeftClick"),
+	RightClick UMETA(DisplayName = "RightClick"),
+};
+
+//Derived from Attack Phase Remaining Time
+UENUM(BlueprintType)
+enum class EComboState : uint8
+{
+	//No Attack, Start Attack When no Other Montage Playing
+	Idle UMETA(DisplayName = "Idle"),
+	//Attack Committed, Input is Buffered
+	Attacking UMETA(DisplayName = "Attacking"),
+	//End of Attack, Next Attack Cancel this
+	CancelWindow UMETA(DisplayName = "CancelWindow"),
+};
+
+/**
+ * Per Combatant State, Structure of Arrays
+ * Every Array use same Index, Character keep its Index (CombatantIndex)
+ * Update every Combatant in one Tick, Character and Weapon don't Tick
+ * Combat Logic run in Fixed Step, Same Result on 30Hz Server and 120Hz Client
+ * Projectile Subsystem is Stepped Here
+ */
+UCLASS(config = Game)
+class WEAPON_API UCombatWorldSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UCombatWorldSubsystem();
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+public:
+	//----------[ Combatant ]----------
+	//Character Register When BeginPlay, Unregister When EndPlay
+	void RegisterCombatant(AFHProjectCharacter* Character);
+
+	void UnregisterCombatant(AFHProjectCharacter* Character);
+
+	//Set Equipped Weapon and Archetype, nullptr When Drop
+	void SetEquippedWeapon(AFHProjectCharacter* Character, ABaseWeapon* Weapon);
+
+	int32 GetCombatantCount() const { return Combatants.Num(); };
+
+	AFHProjectCharacter* GetCombatant(int32 Index) const { return Combatants.IsValidIndex(Index) == true ? Combatants[Index] : nullptr; };
+
+
+	//----------[ Broadphase ]----------
+	//Attack Resolve Character by Capsule Broadphase, Physics Scene Check Occluder and Non Character Target
+	bool UseCapsuleBroadphase() const { return bUseCapsuleBroadphase; };
+
+	//Swept Sphere against every Combatant Capsule, Hit Index is Combatant Index
+	void QueryCapsules(const FVector& Start, const FVector& End, float Radius, TArray<FCapsuleBroadphaseHit>& OutHits) const;
+
+
+	//----------[ Combo ]----------
+	int32 GetComboCount(const AFHProjectCharacter* Character) const;
+
+	//Return Added Combo Count
+	int32 AddComboCount(AFHProjectCharacter* Character);
+
+	void ResetComboCount(AFHProjectCharacter* Character);
+
+	//Owner Client Sync Combo Count Replicated from Server
+	void SetComboCount(AFHProjectCharacter* Character, int32 NewCount);
+
+	EComboState GetComboState(const AFHProjectCharacter* Character) const;
+
+	//Return true When Attack can Start Now
+	//Otherwise Attack is Buffered, Started by Fixed Step When Cancel Window Open
+	bool RequestAttack(AFHProjectCharacter* Character, EAttackPhase NewPhase);
+
+
+	//----------[ Attack Phase ]----------
+	//Attack Phase End after Duration
+	void StartAttackPhase(AFHProjectCharacter* Character, EAttackPhase NewPhase, float Duration);
+
+	EAttackPhase GetAttackPhase(const AFHProjectCharacter* Character) const;
+
+
+	//----------[ Cooldown ]----------
+	bool IsOnCooldown(const AFHProjectCharacter* Character) const;
+
+	void StartCooldown(AFHProjectCharacter* Character, float Duration);
+
+
+	//----------[ Fixed Step ]----------
+	float GetFixedDeltaTime() const { return FixedDeltaTime; };
+
+	//Number of Fixed Steps since World Start
+	int64 GetSimulationFrame() const { return SimulationFrame; };
+
+	//Remaining Time / Fixed Delta Time, Visual Interpolate between Last and Next Step
+	float GetInterpolationAlpha() const { return InterpolationAlpha; };
+
+protected:
+	//Return true When Character's Index is Valid
+	bool IsRegistered(const AFHProjectCharacter* Character) const;
+
+	//One Fixed Step of Combat Logic
+	void FixedStep(float StepDeltaTime);
+
+	//Tick Step
+	//Local Character Send One Input Command per Frame
+	void TickInputCommands();
+
+	void TickCooldowns(float DeltaTime);
+
+	void TickAttackPhases(float DeltaTime);
+
+	//Start Buffered Attack When Cancel Window Open, Drop Expired Input
+	void TickAttackBuffers(float DeltaTime);
+
+	EComboState GetComboState(int32 Index) const;
+
+	bool CanStartAttack(int32 Index) const;
+
+	void TickBakedHitWindows(float DeltaTime);
+
+	void TickPlayerRotations();
+
+	//Pack every Combatant Capsule, Once per Frame and When Combatant Changed
+	void UpdateBroadphase();
+
+	//Server Only, Activate Hitbox of Combatant Near Attacking Enemy, Deactivate Others
+	void TickHitboxes();
+
+protected:
+	//----------[ Structure of Arrays ]----------
+	UPROPERTY()
+	TArray<AFHProjectCharacter*> Combatants;
+
+	UPROPERTY()
+	TArray<ABaseWeapon*> EquippedWeapons;
+
+	TArray<EItemType> Archetypes;
+
+	TArray<int32> ComboCounts;
+
+	TArray<EAttackPhase> AttackPhases;
+
+	TArray<float> AttackPhaseRemainingTimes;
+
+	//Cancel Window Open When Remaining Time is Under this
+	TArray<float> CancelWindowTimes;
+
+	//Input Arrived While Attacking
+	TArray<EAttackPhase> BufferedAttacks;
+
+	TArray<float> BufferedAttackRemainingTimes;
+
+	TArray<float> Cooldowns;
+
+	//Combatant Capsules, Same Index as Combatants
+	FCapsuleBroadphase Broadphase;
+
+	UPROPERTY(Config)
+	bool bUseCapsuleBroadphase;
+
+	//Hitbox Active Within this Distance of Attacking Enemy, Range Weapon use its Attack Range
+	UPROPERTY(Config)
+	float HitboxActivationRadius;
+
+
+	//----------[ Combo ]----------
+	//Last Part of Attack, Ratio of Attack Duration
+	UPROPERTY(Config)
+	float CancelWindowRatio;
+
+	//Buffered Input Expire after this
+	UPROPERTY(Config)
+	float InputBufferTime;
+
+
+	//----------[ Fixed Step ]----------
+	//Combat Step Rate, Override in DefaultGame.ini
+	UPROPERTY(Config)
+	float FixedStepRate;
+
+	//Max Steps in One Frame, Drop Remaining Time after this (Hitch)
+	UPROPERTY(Config)
+	int32 MaxStepsPerFrame;
+
+	float FixedDeltaTime;
+
+	//Frame Time not Simulated Yet
+	double Accumulator;
+
+	int64 SimulationFrame;
+
+	float InterpolationAlpha;
+};
@@ -0,0 +1,158 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "HitboxComponent.h"
+#include "DamageNumberSubsystem.generated.h"
+
+class AFHProjectCharacter;
+class SDamageNumberOverlay;
+struct FCombatEvent;
+
+/**
+ * One Server Damage Result for Attacker's Screen, Location and Damage are Quantized
+ */
+USTRUCT()
+struct WEAPON_API FDamageNumber
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FVector Location = FVector::ZeroVector;
+
+	UPROPERTY()
+	float Damage = 0.0f;
+
+	UPROPERTY()
+	EHitboxRegion Region = EHitboxRegion::None;
+
+public:
+	//Location 1cm, Damage Rounded to Integer
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FDamageNumber> : public TStructOpsTypeTraitsBase2<FDamageNumber>
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
+};
+
+//Active Damage Number, Fixed Slot in Ring Buffer
+struct FDamageNumberEntry
+{
+	FVector Location = FVector::ZeroVector;
+
+	float Damage = 0.0f;
+
+	EHitboxRegion Region = EHitboxRegion::None;
+
+	//Dead When Age is over Number Lifetime
+	float Age = TNumericLimits<float>::Max();
+};
+
+/**
+ * Floating Damage Numbers and Hit Marker
+ * Server Collect Damage Events of Combat Event Bus, One Unreliable Batch per Attacker per Frame
+ * Client Write Numbers to Fixed Ring Buffer, Oldest is Overwritten, No Allocation per Hit
+ * One Slate Leaf Widget Draw every Number and Hit Marker, No Widget per Number
+ */
+UCLASS(config = Game)
+class WEAPON_API UDamageNumberSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UDamageNumberSubsystem();
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+public:
+	//Client, Batch Received from Server
+	void AddDamageNumbers(const TArray<FDamageNumber>& Numbers);
+
+	const TArray<FDamageNumberEntry>& GetEntries() const { return Entries; };
+
+	float GetNumberLifetime() const { return NumberLifetime; };
+
+	float GetRiseSpeed() const { return RiseSpeed; };
+
+	int32 GetFontSize() const { return FontSize; };
+
+	const FLinearColor& GetNumberColor(EHitboxRegion Region) const { return Region == EHitboxRegion::Head ? CriticalColor : NormalColor; };
+
+	//0 ~ 1, Hit Marker Opacity
+	float GetHitMarkerAlpha() const { return HitMarkerTime > 0.0f ? FMath::Clamp(HitMarkerRemainingTime / HitMarkerTime, 0.0f, 1.0f) : 0.0f; };
+
+	bool IsHitMarkerCritical() const { return bHitMarkerCritical; };
+
+protected:
+	//Server, Damage Event from Combat Event Bus
+	void OnCombatEvent(const FCombatEvent& Event);
+
+	//Server, Send Pending Batches to Attackers
+	void FlushDamageNumbers();
+
+	void CreateOverlay();
+
+	void RemoveOverlay();
+
+protected:
+	//Ring Buffer Size, Max Numbers on Screen
+	UPROPERTY(Config)
+	int32 MaxActiveNumbers;
+
+	//Max Numbers per Attacker per Frame, Rest of Cleave is Dropped
+	UPROPERTY(Config)
+	int32 MaxNumbersPerBatch;
+
+	UPROPERTY(Config)
+	float NumberLifetime;
+
+	//Screen Unit per Second
+	UPROPERTY(Config)
+	float RiseSpeed;
+
+	UPROPERTY(Config)
+	int32 FontSize;
+
+	UPROPERTY(Config)
+	float HitMarkerTime;
+
+	UPROPERTY(Config)
+	FLinearColor NormalColor;
+
+	//Head Hit
+	UPROPERTY(Config)
+	FLinearColor CriticalColor;
+
+	//Client Ring Buffer, Allocated Once
+	TArray<FDamageNumberEntry> Entries;
+
+	int32 NextEntryIndex;
+
+	float HitMarkerRemainingTime;
+
+	bool bHitMarkerCritical;
+
+	//Server, Numbers of this Frame per Attacker
+	TMap<TWeakObjectPtr<AFHProjectCharacter>, TArray<FDamageNumber>> PendingBatches;
+
+	FDelegateHandle CombatEventHandle;
+
+	TSharedPtr<SDamageNumberOverlay> Overlay;
+};
@@ -0,0 +1,26 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AIController.h"
+#include "FHAIController.generated.h"
+
+/**
+ * Controller of NPC Combatant (FHCharacter)
+ * Only Register Brain, Decision is Time Sliced in AIBrainSubsystem
+ * Control Rotation Follow Focus, Replicated as NPC Aim
+ */
+UCLASS()
+class WEAPON_API AFHAIController : public AAIController
+{
+	GENERATED_BODY()
+
+public:
+	AFHAIController();
+
+protected:
+	virtual void OnPossess(APawn* InPawn) override;
+
+	virtual void OnUnPossess() override;
+};
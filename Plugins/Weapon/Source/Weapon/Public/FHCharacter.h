@@ -3,11 +3,18 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "GameFramework/Character.h"
+#include "FHProjectCharacter.h"
 #include "FHCharacter.generated.h"
 
+class ABaseWeapon;
+
+/**
+ * NPC Combatant, Possessed by FHAIController
+ * Same Inventory, Hitbox and Weapon Interface as Player Character
+ * Brain is Run by AIBrainSubsystem, Attack is Sent as Input Command on Server
+ */
 UCLASS()
-class WEAPON_API AFHCharacter : public ACharacter
+class WEAPON_API AFHCharacter : public AFHProjectCharacter
 {
 	GENERATED_BODY()
 
@@ -19,11 +26,22 @@ protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
-public:	
-	// Called every frame
-	virtual void Tick(float DeltaTime) override;
+	// Give Default Weapon When Controller is Ready
+	virtual void PossessedBy(AController* NewController) override;
 
+public:
 	// Called to bind functionality to input
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
 
+	//Server, Brain Decision Run Same Path as Player Input Command
+	void ProcessAICommand(const FFHInputCommand& Command);
+
+protected:
+	//Server, Spawn Default Weapon and Pick up by Weapon Interface
+	void EquipDefaultWeapon();
+
+public:
+	//Weapon Given When Possessed, None is Unarmed
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI")
+	TSubclassOf<ABaseWeapon> DefaultWeaponClass;
 };
@@ -0,0 +1,23 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DemoNetDriver.h"
+#include "FHDemoNetDriver.generated.h"
+
+/**
+ * Replay Driver of this Project, Set in DefaultEngine.ini NetDriverDefinitions
+ * Cosmetic Multicast is Written as Replay Event, not RPC Bunch
+ * Flush Time is Reported to MatchReplaySubsystem
+ */
+UCLASS(transient, config = Engine)
+class WEAPON_API UFHDemoNetDriver : public UDemoNetDriver
+{
+	GENERATED_BODY()
+
+public:
+	virtual void ProcessRemoteFunction(AActor* Actor, UFunction* Function, void* Parameters, FOutParmRec* OutParms, FFrame* Stack, UObject* SubObject = nullptr) override;
+
+	virtual void TickFlush(float DeltaSeconds) override;
+};
@@ -0,0 +1,82 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FHInputCommand.generated.h"
+
+//Input Button Bit, One Bit per Action
+namespace FHInputButton
+{
+	constexpr uint8 None = 0;
+	constexpr uint8 Sprint = 1 << 0;
+	constexpr uint8 Roll = 1 << 1;
+	constexpr uint8 LeftClick = 1 << 2;
+	constexpr uint8 RightClick = 1 << 3;
+	constexpr uint8 DropItem = 1 << 4;
+
+	constexpr int32 NumBits = 5;
+}
+
+/**
+ * One Frame of Client Input, Send to Server Only When Something Changed
+ * Held is Current State, Pressed and Released are Edge of this Frame
+ */
+USTRUCT()
+struct WEAPON_API FFHInputCommand
+{
+	GENERATED_BODY()
+
+	//Increase every Sent Command, Server Drop Old Command
+	UPROPERTY()
+	uint16 Sequence = 0;
+
+	UPROPERTY()
+	uint8 HeldButtons = FHInputButton::None;
+
+	UPROPERTY()
+	uint8 PressedButtons = FHInputButton::None;
+
+	UPROPERTY()
+	uint8 ReleasedButtons = FHInputButton::None;
+
+	//Hotbar Slot to Select, INDEX_NONE if not Changed
+	UPROPERTY()
+	int8 SelectSlotIndex = INDEX_NONE;
+
+	//Seconds from Attack Click to Send, Client Clock, Negative if No Click
+	//Serialized Only When Set, Used for Latency Trace
+	UPROPERTY()
+	float ClickAge = -1.0f;
+
+public:
+	bool IsPressed(uint8 Button) const { return (PressedButtons & Button) != 0; };
+
+	bool IsReleased(uint8 Button) const { return (ReleasedButtons & Button) != 0; };
+
+	bool IsHeld(uint8 Button) const { return (HeldButtons & Button) != 0; };
+
+	//Return true When Command has Edge or Slot Change, Held only Command is not Sent
+	bool HasChanges() const { return PressedButtons != FHInputButton::None || ReleasedButtons != FHInputButton::None || SelectSlotIndex != INDEX_NONE; };
+
+	//Clear Edge, Keep Held State
+	void ResetEdges();
+
+	//Add Newer Command's Edges, Held State and Sequence Follow Newer
+	void MergeEdges(const FFHInputCommand& Newer);
+
+	//Return true When this Sequence is Newer than Other, Wrap Around Safe
+	bool IsNewerThan(uint16 OtherSequence) const { return static_cast<int16>(Sequence - OtherSequence) > 0; };
+
+	//Pack Button Bits and Slot, about 4 Bytes per Command, 12 Bytes with Click Time
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FFHInputCommand> : public TStructOpsTypeTraitsBase2<FFHInputCommand>
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
+};
@@ -4,6 +4,10 @@
 
 #include "CoreMinimal.h"
 #include "WeaponInterface.h"
+#include "WeaponInventory.h"
+#include "FHInputCommand.h"
+#include "ImpactEventSubsystem.h"
+#include "DamageNumberSubsystem.h"
 #include "GameFramework/Character.h"
 #include "InputActionValue.h"
 #include "FHProjectCharacter.generated.h"
@@ -163,9 +167,11 @@ protected:
 	// To add mapping context
 	virtual void BeginPlay();
 
-	// ----------[ Add Event ]----------
-	// Tick override
-	virtual void Tick(float DeltaTime) override;
+	// Unregister from Subsystem
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	// Restore Snapshot Loadout of Reconnected Player
+	virtual void PossessedBy(AController* NewController) override;
 
 
 
@@ -182,27 +188,22 @@ public:
 	// ----------[ Test function End ]----------
 
 
-	// Do Roll Move function
+	//Packed Input Command, Client Send at most One per Frame
+	//Replace Per Action Server RPC (Roll, Sprint, Drop, Attack, Select Slot)
 	UFUNCTION(Server, Reliable)
-	void Req_DoRollMove();
+	void Req_InputCommand(const FFHInputCommand& Command);
+
 
+	// Do Roll Move function
 	UFUNCTION(NetMulticast, Reliable)
 	void Res_DoRollMove();
 
 
 	// Set MaxWalkSpeed For Sprint Action
-	UFUNCTION(Server, Reliable)
-	void Req_SetMaxWalkSpeed(float NewSpeed);
-
 	UFUNCTION(NetMulticast, Reliable)
 	void Res_SetMaxWalkSpeed(float NewSpeed);
 
 
-	//Get Weapon Static Mesh And Attach to Target Socket
-	UFUNCTION(NetMulticast, Reliable)
-	void Res_AttachToWeaponSocket(AActor* Item);
-
-
 	//Get Item Attach on Target Socket
 	UFUNCTION(Server, Reliable)
 	void Req_GetItem();
@@ -210,30 +211,72 @@ public:
 	UFUNCTION(NetMulticast, Reliable)
 	void Res_GetItem(AActor* Item);
 
-	//Drop Item Attached on Target Socket
-	UFUNCTION(Server, Reliable)
-	void Req_DropItem();
-
+	//Drop Item Attached on Target Socket, Dropped Weapon is Sent, Receiver's EquipWeapon may be Other Slot
 	UFUNCTION(NetMulticast, Reliable)
-	void Res_DropItem();
+	void Res_DropItem(ABaseWeapon* DroppedWeapon);
 
 
 	//Left Click Attack Action
-	UFUNCTION(Server, Reliable)
-	void Req_LeftClickAttack(bool IsPressed);
-
 	UFUNCTION(NetMulticast, Reliable)
 	void Res_LeftClickAttack(bool IsPressed);
 
 
 	//Right Click Attack Action
-	UFUNCTION(Server, Reliable)
-	void Req_RightClickAttack(bool IsPressed);
-
 	UFUNCTION(NetMulticast, Reliable)
 	void Res_RightClickAttack(bool IsPressed);
 
 
+	//Impact Events near this Player, One Batch per Frame
+	//Cosmetic Only, Lost Batch is Fine
+	UFUNCTION(Client, Unreliable)
+	void Res_ImpactEvents(const TArray<FImpactEvent>& Impacts);
+
+	//Damage this Player Dealt, One Batch per Frame
+	//Cosmetic Only, Lost Batch is Fine
+	UFUNCTION(Client, Unreliable)
+	void Res_DamageNumbers(const TArray<FDamageNumber>& Numbers);
+
+
+protected:
+	//----------[ Input Command ]----------
+	//Server, Run Actions in Command
+	void ProcessInputCommand(const FFHInputCommand& Command);
+
+	//Server, Check Cooldown and Play Roll
+	void DoRollMove();
+
+	//Roll is Allowed Now, Not in Montage, Not Falling, Not Crouched, Montages are Set
+	bool CanRollMove();
+
+	//Server, Drop Active Slot Weapon
+	void DropItem();
+
+	//Server, Select Hotbar Slot, Active Slot Weapon is EquipWeapon
+	void SelectSlot(int32 NewSlotIndex);
+
+	//Server, Run Merged Command and Clear its Edges
+	void RunThrottledInputCommand();
+
+	//Client, Add Edge to Pending Command
+	void PressInputButton(uint8 Button);
+
+	void ReleaseInputButton(uint8 Button);
+
+public:
+	//Client, Send Pending Command if Changed
+	//CombatWorldSubsystem Call this every Tick for Local Character
+	void FlushInputCommand();
+
+	//Server, Run Rate Limited Edges When Token Refill
+	//CombatWorldSubsystem Call this every Tick for Server Character
+	void FlushThrottledInputCommand();
+
+#if WITH_DEV_AUTOMATION_TESTS
+	//Client, Scripted Input same as Key Input (Network Automation Test Scenario)
+	void SimulateInputButton(uint8 Button, bool bIsPressed);
+#endif
+
+
 public:
 	//WeaponInterface Event
 	UFUNCTION(BlueprintNativeEvent, BlueprintCallable)
@@ -252,12 +295,47 @@ public:
 // ----------[ Add PROPERTY ]----------
 
 protected:
-	//EquipWeapon
+	//EquipWeapon, Weapon in Active Slot
 	AActor* EquipWeapon;
 
+	//Hotbar Inventory, Weapon Actor in Inventory is Hidden
+	UPROPERTY(Replicated)
+	FWeaponInventoryArray Inventory;
+
+	//Active Hotbar Slot Index
+	UPROPERTY(ReplicatedUsing = OnRep_ActiveSlotIndex)
+	int32 ActiveSlotIndex;
+
+	UFUNCTION()
+	void OnRep_ActiveSlotIndex();
+
 	//Character Mesh's Weapon Socket Name
 	FName WeaponSocketName;
 
+	//Draw Active Slot Weapon at Weapon Socket, No Collision, No Physics
+	//Weapon Actor is Hidden While Held, Not Attached
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Weapon")
+	class UStaticMeshComponent* EquipWeaponMesh;
+
+	//Index in CombatWorldSubsystem, INDEX_NONE if not Registered
+	int32 CombatantIndex;
+
+	//Client, Input of this Frame, Flushed by CombatWorldSubsystem
+	FFHInputCommand PendingInputCommand;
+
+	//Client, Platform Time of Attack Click in Pending Command, 0 if No Click
+	double PendingClickTime;
+
+	//Per Region Hitbox, Activated by CombatWorldSubsystem Near Open Attack Window
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Hitbox")
+	class UHitboxComponent* Hitbox;
+
+	//Server, Last Processed Command Sequence
+	uint16 LastInputSequence;
+
+	//Server, Edges of Rate Limited Commands, Run with Next Token
+	FFHInputCommand ThrottledInputCommand;
+
 
 public:
 	// Check Any MontagePlaying
@@ -267,6 +345,26 @@ public:
 	//Return Character's EquipWeapon
 	AActor* GetEquipWeapon() { return EquipWeapon; };
 
+	//Return Hotbar Inventory
+	const FWeaponInventoryArray& GetInventory() const { return Inventory; };
+
+	int32 GetActiveSlotIndex() const { return ActiveSlotIndex; };
+
+	//Server, Weapon Snapshot Restore, Put Weapon in Empty Slot without Pick Up Overlap
+	bool RestoreInventorySlot(int32 SlotIndex, ABaseWeapon* Weapon);
+
+	//Server, Weapon Snapshot Restore, Select Slot without Montage Check
+	void RestoreActiveSlot(int32 NewSlotIndex);
+
+	//Set EquipWeapon by Active Slot, Equip Weapon Mesh Show Active Weapon
+	//Removed Weapon is Treated as Empty, Slot Removal not Replicated yet
+	void RefreshEquipWeapon(const ABaseWeapon* RemovedWeapon = nullptr);
+
+	//Attach Inventory Weapon to Self and Refresh, Server When Added, Client When Slot Replicated
+	void AttachInventoryWeapon(ABaseWeapon* Weapon);
+
+	class UStaticMeshComponent* GetEquipWeaponMesh() const { return EquipWeaponMesh; };
+
 	//Return Cameara Target Arm Length
 	float GetCameraTargetArmLength();
 
@@ -280,15 +378,66 @@ public:
 
 	AActor* FindWeapon();
 
+	//CombatWorldSubsystem Use this
+	int32 GetCombatantIndex() const { return CombatantIndex; };
+
+	void SetCombatantIndex(int32 NewIndex) { CombatantIndex = NewIndex; };
+
+	class UHitboxComponent* GetHitboxComponent() const { return Hitbox; };
+
+protected:
+	//One Received Aim, Simulated Proxy Interpolate between Snapshots
+	struct FAimSnapshot
+	{
+		//Local World Time When Received
+		double Time = 0.0;
+
+		float Pitch = 0.0f;
+
+		float Yaw = 0.0f;
+	};
+
+	//Aim Pitch and Yaw, 16 Bits per Axis, Owner use its Control Rotation
+	UPROPERTY(ReplicatedUsing = OnRep_PackedAimRotation)
+	uint32 PackedAimRotation;
+
+	UFUNCTION()
+	void OnRep_PackedAimRotation();
+
+	static uint32 PackAimRotation(const FRotator& Rotation);
+
+	static FRotator UnpackAimRotation(uint32 Packed);
+
+	//Simulated Proxy, Oldest First
+	TArray<FAimSnapshot> AimSnapshots;
+
+	static constexpr int32 MaxAimSnapshots = 8;
+
+	//Seconds between Recent Aim Arrivals, Oldest First
+	TArray<float> AimArrivalIntervals;
+
+	static constexpr int32 MaxAimArrivalIntervals = 8;
+
+	//Typical Server Update Interval Seen by Client, 0 if Not Observed yet
+	float GetAimArrivalInterval() const;
+
 public:
-	// Use When Replicate Move Server and Client
-	UPROPERTY(Replicated)
-	FRotator PlayerRotation;
+	//Server Send Aim Only When Pitch or Yaw Moved over this, Degree
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Aim")
+	float AimUpdateThreshold;
 
-	//Return Player index 0's Rotation or just PlayerRotation
+	//Simulated Proxy Render Aim this much in the Past, Always Two Snapshots to Interpolate
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Aim")
+	float AimInterpolationDelay;
+
+	//Local and Server Return Control Rotation, Simulated Proxy Return Interpolated Aim
 	UFUNCTION(BlueprintPure)
 	FRotator GetPlayerRotation();
 
+	//Pack Control Rotation When Moved over Threshold, Server Only
+	//CombatWorldSubsystem Call this every Tick
+	void UpdatePlayerRotation();
+
 public:
 	// Use When Roll
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Montage")
@@ -298,6 +447,10 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Montage")
 	UAnimMontage* RunToRollMontage;
 
+	// Can't Roll again until Cooldown End
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Montage")
+	float RollCooldown;
+
 };
 
 
@@ -0,0 +1,137 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Engine/EngineTypes.h"
+#include "HitboxComponent.generated.h"
+
+class USkeletalMeshComponent;
+
+UENUM(BlueprintType)
+enum class EHitboxRegion : uint8
+{
+	None UMETA(DisplayName = "None"),
+	Head UMETA(DisplayName = "Head"),
+	Torso UMETA(DisplayName = "Torso"),
+	Arm UMETA(DisplayName = "Arm"),
+	Leg UMETA(DisplayName = "Leg"),
+};
+
+//One Bone Attached Capsule, Segment is in Bone Space
+USTRUCT(BlueprintType)
+struct FHitboxCapsule
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FName BoneName;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	EHitboxRegion Region = EHitboxRegion::Torso;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FVector LocalStart = FVector::ZeroVector;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FVector LocalEnd = FVector::ZeroVector;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float Radius = 10.0f;
+};
+
+/**
+ * Per Region Hitbox of Character, Small Set of Bone Attached Capsules
+ * Not Physics Body, Capsules are Packed World Space Segments Tested by Segment Distance
+ * CombatWorldSubsystem Activate this Only While Enemy Attack Window is Open Nearby
+ * Inactive Hitbox don't Read Bones, Hit on it use Default Multiplier
+ */
+UCLASS(config = Game, ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
+class WEAPON_API UHitboxComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UHitboxComponent();
+
+	virtual void BeginPlay() override;
+
+public:
+	//CombatWorldSubsystem Call this every Frame, Server Only
+	//Active Mesh Refresh Bones even Dedicated Server
+	void SetHitboxActive(bool bNewActive);
+
+	bool IsHitboxActive() const { return bHitboxActive; };
+
+	//Read Bone Transforms and Pack World Space Segments
+	void UpdateHitboxes();
+
+	//Probe through Hit Location along Hit Direction, Nearest Region to Probe Start
+	//Return 1 When Inactive or No Capsule Hit
+	float ResolveDamageMultiplier(const FVector& HitLocation, const FVector& HitDirection, EHitboxRegion& OutRegion) const;
+
+	float GetRegionDamageMultiplier(EHitboxRegion Region) const;
+
+	int32 GetHitboxCount() const { return Radii.Num(); };
+
+protected:
+	//First Bone Refresh after Activation, Pose Before it is Stale on Culled Mesh
+	UFUNCTION()
+	void OnBoneTransformsFinalized();
+
+protected:
+	//Default Capsules fit UE Mannequin, Override in Blueprint
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hitbox")
+	TArray<FHitboxCapsule> Capsules;
+
+	//Probe Half Length, Enough to Pass through Character
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hitbox")
+	float ProbeHalfLength;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hitbox")
+	float ProbeRadius;
+
+	//Region Damage Multiplier, Override in DefaultGame.ini
+	UPROPERTY(Config)
+	float HeadDamageMultiplier;
+
+	UPROPERTY(Config)
+	float TorsoDamageMultiplier;
+
+	UPROPERTY(Config)
+	float ArmDamageMultiplier;
+
+	UPROPERTY(Config)
+	float LegDamageMultiplier;
+
+	UPROPERTY()
+	USkeletalMeshComponent* Mesh;
+
+	bool bHitboxActive;
+
+	//Mesh Refreshed Bones Since Activation
+	bool bBonesRefreshed;
+
+	//Packed Data Valid after First Update Following Bone Refresh
+	bool bHitboxValid;
+
+	//Restore When Deactivate, if Nobody Changed it
+	EVisibilityBasedAnimTickOption SavedAnimTickOption;
+
+	//----------[ Packed, Valid Bone Capsules Only ]----------
+	TArray<int32> BoneIndices;
+
+	TArray<EHitboxRegion> Regions;
+
+	TArray<FVector3f> LocalStarts;
+
+	TArray<FVector3f> LocalEnds;
+
+	TArray<float> Radii;
+
+	//World Space, Written by UpdateHitboxes
+	TArray<FVector3f> WorldStarts;
+
+	TArray<FVector3f> WorldEnds;
+};
@@ -0,0 +1,81 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ImpactEventSubsystem.generated.h"
+
+class ABaseWeapon;
+
+/**
+ * One Cosmetic Impact, Location and Rotation are Quantized
+ */
+USTRUCT()
+struct WEAPON_API FImpactEvent
+{
+	GENERATED_BODY()
+
+	//Weapon has Effect Asset and Scale
+	UPROPERTY()
+	ABaseWeapon* Weapon = nullptr;
+
+	UPROPERTY()
+	FVector Location = FVector::ZeroVector;
+
+	UPROPERTY()
+	FRotator Rotation = FRotator::ZeroRotator;
+
+public:
+	//Location 1cm, Rotation 16 Bits per Axis
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FImpactEvent> : public TStructOpsTypeTraitsBase2<FImpactEvent>
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
+};
+
+/**
+ * Server Collect Impact Events of this Frame
+ * Send One Unreliable Batch per Connection, Only Events near the Connection's View
+ */
+UCLASS(config = Game)
+class WEAPON_API UImpactEventSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UImpactEventSubsystem();
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+public:
+	//Server Only, Sent at End of Frame
+	void QueueImpact(ABaseWeapon* Weapon, const FVector& Location, const FRotator& Rotation);
+
+protected:
+	//Send Pending Events to every Player Controller
+	void FlushImpacts();
+
+protected:
+	//Connection don't Receive Impact Farther than this
+	UPROPERTY(Config)
+	float ImpactCullDistance;
+
+	//Max Events in One Batch, Nearest Events First
+	UPROPERTY(Config)
+	int32 MaxEventsPerBatch;
+
+	TArray<FImpactEvent> PendingImpacts;
+};
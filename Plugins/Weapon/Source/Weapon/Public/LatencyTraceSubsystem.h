@@ -0,0 +1,148 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "LatencyTraceSubsystem.generated.h"
+
+//Attack Pipeline Stage, Each Stage is Time from Previous Stamp
+enum class ELatencyStage : uint8
+{
+	//Client, Click to Input Command RPC
+	InputToSend,
+	//Click to Server Receive, Client Click Age + Half Connection Round Trip
+	InputToServer,
+	//Server Receive to Attack Start, Include Combo Buffer Wait
+	ServerToAttack,
+	//Attack Start to Hit Resolve, Include Montage, Anim Notify and Damage RPC
+	AttackToHit,
+	//Hit Resolve to ApplyDamage, Trace and Target Resolve
+	HitToDamage,
+	//Click to ApplyDamage
+	InputToDamage,
+	Count,
+};
+
+/**
+ * Log Linear Histogram like HDR Histogram, Microsecond Value
+ * 16 Linear Sub Buckets per Power of Two, Value Error is under 1 / 16
+ * Fixed Size, Record is One Increment
+ */
+struct WEAPON_API FLatencyHistogram
+{
+public:
+	static constexpr int32 SubBucketBits = 4;
+	static constexpr int32 SubBucketCount = 1 << SubBucketBits;
+	//First Octave is Linear 0 ~ 15us, Last Octave Start at about 67s
+	static constexpr int32 OctaveCount = 24;
+	static constexpr int32 BucketCount = OctaveCount * SubBucketCount;
+
+	FLatencyHistogram();
+
+	void Record(double Seconds);
+
+	void Reset();
+
+	//Percentile 0 ~ 100, Return Seconds, Highest Value of Bucket
+	double GetPercentile(double Percentile) const;
+
+	int64 GetCount() const { return TotalCount; };
+
+	double GetMean() const { return TotalCount > 0 ? TotalSeconds / TotalCount : 0.0; };
+
+	double GetMax() const { return MaxMicros * 1.0e-6; };
+
+private:
+	static int32 GetBucketIndex(uint64 Micros);
+
+	static uint64 GetBucketHighestValue(int32 Index);
+
+	TArray<uint32> Buckets;
+
+	int64 TotalCount;
+
+	double TotalSeconds;
+
+	uint64 MaxMicros;
+};
+
+/**
+ * Stamp Attack Pipeline Stages and Record Latency per Stage
+ * Client Stamp Click in Server Clock, Carried by Input Command
+ * Server Stamp Receive, Attack Start, Hit Resolve and Damage, One Trace per Character
+ * Server and Client Write CSV When World End (Match End)
+ *
+ * Console : Weapon.Latency.Report, Weapon.Latency.Reset, Weapon.Latency.WriteCsv
+ */
+UCLASS(config = Game)
+class WEAPON_API ULatencyTraceSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	ULatencyTraceSubsystem();
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	virtual void Deinitialize() override;
+
+public:
+	bool IsEnabled() const { return bEnableLatencyTrace; };
+
+	//Record Stage Measured Outside, Client InputToSend
+	void RecordStage(ELatencyStage Stage, double Seconds);
+
+	//Server, Input Command with Click Received
+	//ClickAge is Click to Send on Client Clock, One Way Trip is Half of Connection Round Trip
+	void BeginTrace(const AActor* Character, float ClickAge);
+
+	//Server, Stamp Next Stage of Character's Trace
+	void StampAttackStart(const AActor* Character);
+
+	void StampHitResolve(const AActor* Character);
+
+	//First Damage End Trace, Other Targets of Same Attack are not Recorded
+	void StampDamage(const AActor* Character);
+
+	//Log p50, p95, p99 of every Stage
+	void Report() const;
+
+	//Return Written Path, Empty if Nothing Recorded
+	FString WriteCsv() const;
+
+	void ResetHistograms();
+
+	static const TCHAR* GetStageName(ELatencyStage Stage);
+
+protected:
+	struct FLatencyTrace
+	{
+		//Platform Time, Click is Converted from Server Clock
+		double ClickTime = 0.0;
+
+		double LastStampTime = 0.0;
+
+		ELatencyStage LastStage = ELatencyStage::InputToServer;
+	};
+
+	//Stamp only When Trace is at Previous Stage, Drop Out of Order Stamp
+	void StampStage(const AActor* Character, ELatencyStage PreviousStage, ELatencyStage Stage);
+
+protected:
+	UPROPERTY(Config)
+	bool bEnableLatencyTrace;
+
+	//Write CSV When World End (Match End), Weapon.Latency.WriteCsv Write on Demand
+	UPROPERTY(Config)
+	bool bWriteCsvOnEnd;
+
+	//Trace Older than this is Abandoned (Missed Attack)
+	UPROPERTY(Config)
+	float MaxTraceTime;
+
+	FLatencyHistogram Histograms[static_cast<int32>(ELatencyStage::Count)];
+
+	TMap<FObjectKey, FLatencyTrace> Traces;
+};
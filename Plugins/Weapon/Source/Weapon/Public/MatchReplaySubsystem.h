@@ -0,0 +1,154 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "LatencyTraceSubsystem.h"
+#include "MatchReplaySubsystem.generated.h"
+
+class UDemoNetDriver;
+class UPackageMap;
+struct FImpactEvent;
+
+/**
+ * Server Record Match to Replay for Review and Dispute, Off by Default
+ * Enable with bRecordMatches in Session Config or -RecordMatch Command Line
+ * Character and Weapon Record at Demo Record Hz, not their Net Update Frequency
+ * Cosmetic Multicast is not Recorded as RPC, Written as Compact Replay Event by FHDemoNetDriver
+ * Playback Read Events Back and Call same Multicast and Impact Handler at Recorded Time
+ * Checkpoint Save is Split over Frames, Stream is Written by Streamer's Async Task
+ * Measure Recording Cost per Frame, Demo Flush + Event Write
+ *
+ * Console : Weapon.Replay.Report, Weapon.Replay.Reset
+ */
+UCLASS(config = Game)
+class WEAPON_API UMatchReplaySubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UMatchReplaySubsystem();
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+public:
+	bool IsRecording() const;
+
+	//Cosmetic Multicast, Replaced by Replay Event
+	bool IsReplayEventFunction(const UFunction* Function) const { return Function != nullptr && ReplayEventFunctionSet.Contains(Function->GetFName()); };
+
+	//Demo Net Driver, Write Multicast Parameters as Replay Event
+	void RecordFunctionEvent(UDemoNetDriver* DemoNetDriver, AActor* Actor, UFunction* Function, void* Parameters);
+
+	//Impacts are Client RPC, Never in Replay without this
+	void RecordImpacts(const TArray<FImpactEvent>& Impacts);
+
+	//Demo Net Driver Flush Time of this Frame
+	void AddRecordTime(double Seconds) { FrameRecordSeconds += Seconds; };
+
+	//Log p50, p95, p99 of Recording Cost per Frame
+	void Report() const;
+
+	void ResetCost();
+
+protected:
+	//Apply Config to Demo Console Variable
+	void ApplyDemoSettings() const;
+
+	//Playback, Enumerate Combat Events and Request their Data from Streamer
+	void RequestPlaybackEvents(UDemoNetDriver* DemoNetDriver);
+
+	//Playback, Dispatch Events up to Demo Current Time
+	void TickPlayback(UDemoNetDriver* DemoNetDriver);
+
+	//Decode One Event, Call Multicast Implementation or Spawn Impacts
+	void DispatchPlaybackEvent(UDemoNetDriver* DemoNetDriver, const FString& EventName, const TArray<uint8>& Data) const;
+
+	//Parameters Serialized like RPC, Same Function Read them Back
+	static void SerializeParameters(FArchive& Ar, UPackageMap* PackageMap, const UStruct* Struct, void* Data);
+
+	//Array is Count then Elements, Struct without Net Serializer is its Members
+	static void SerializeProperty(FArchive& Ar, UPackageMap* PackageMap, FProperty* Property, void* Data);
+
+	//Recording Driver's Client Connection, Playback Driver's Server Connection
+	static UPackageMap* GetPackageMap(const UDemoNetDriver* DemoNetDriver);
+
+	//Return Written Path, Empty if Nothing Recorded
+	FString WriteCsv() const;
+
+protected:
+	//Recording Cost Every Frame and Disk, Turn on only for Sessions that need Review
+	UPROPERTY(Config)
+	bool bRecordMatches;
+
+	//Max Record Rate of every Actor, Character is Capped by this
+	UPROPERTY(Config)
+	float RecordHz;
+
+	//Min Record Rate, Low Net Update Frequency Actor (Weapon) Record at its Own Rate over this
+	UPROPERTY(Config)
+	float MinRecordHz;
+
+	UPROPERTY(Config)
+	float CheckpointInterval;
+
+	//Checkpoint Save Budget per Frame, Checkpoint is Split over Frames
+	UPROPERTY(Config)
+	float CheckpointSaveMaxMSPerFrame;
+
+	//Cosmetic Multicast Recorded as Replay Event
+	UPROPERTY(Config)
+	TArray<FName> ReplayEventFunctions;
+
+	//Write Cost CSV When World End
+	UPROPERTY(Config)
+	bool bWriteCsvOnEnd;
+
+	TSet<FName> ReplayEventFunctionSet;
+
+	FString ReplayName;
+
+	double FrameRecordSeconds;
+
+	int64 EventCount;
+
+	int64 EventBytes;
+
+	//Recording Cost per Frame
+	FLatencyHistogram FrameCostHistogram;
+
+	//----------[ Playback ]----------
+	struct FPlaybackEvent
+	{
+		//Function Name or Impacts
+		FString EventName;
+
+		//Demo Time, Millisecond
+		uint32 Time = 0;
+
+		TArray<uint8> Data;
+
+		//Data Arrive from Streamer Asynchronously
+		bool bIsLoaded = false;
+	};
+
+	//Sorted by Time
+	TArray<FPlaybackEvent> PlaybackEvents;
+
+	int32 PlaybackEventIndex;
+
+	float LastPlaybackTime;
+
+	bool bPlaybackEventsRequested;
+};
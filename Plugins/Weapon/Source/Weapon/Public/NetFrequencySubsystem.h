@@ -0,0 +1,146 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "NetFrequencySubsystem.generated.h"
+
+UENUM(BlueprintType)
+enum class ENetActivity : uint8
+{
+	//Attack Phase or Montage, and Hold Time after
+	Combat UMETA(DisplayName = "Combat"),
+	//Other Combatant within Engage Radius
+	Engaged UMETA(DisplayName = "Engaged"),
+	Idle UMETA(DisplayName = "Idle"),
+	//Dropped Weapon at Rest or Proxied
+	Resting UMETA(DisplayName = "Resting"),
+	Count UMETA(Hidden),
+};
+
+//Net Update Frequency per Activity for One Class
+USTRUCT()
+struct FNetFrequencyRule
+{
+	GENERATED_BODY()
+
+	//Apply to this Class and Child Class, Most Derived Rule Win
+	UPROPERTY(Config)
+	TSoftClassPtr<AActor> ActorClass;
+
+	UPROPERTY(Config)
+	float CombatFrequency = 60.0f;
+
+	UPROPERTY(Config)
+	float EngagedFrequency = 30.0f;
+
+	UPROPERTY(Config)
+	float IdleFrequency = 10.0f;
+
+	UPROPERTY(Config)
+	float RestingFrequency = 2.0f;
+
+	//Engine Adaptive Frequency Lower Bound, Clamped to Current Frequency
+	UPROPERTY(Config)
+	float MinNetUpdateFrequency = 2.0f;
+
+public:
+	float GetFrequency(ENetActivity Activity) const;
+};
+
+/**
+ * Server Set Net Update Frequency by Combat Activity, not One Default for every Actor
+ * Character : Combat When Attacking or Montage, Engaged When Other Combatant is Near, Otherwise Idle
+ * Held Weapon Follow Owner, Dropped Weapon is Idle While Moving and Resting When Asleep
+ * Raised to Combat Send Now (ForceNetUpdate), First Swing doesn't Wait Idle Interval
+ *
+ * Console : Weapon.NetFrequency.Report
+ */
+UCLASS(config = Game)
+class WEAPON_API UNetFrequencySubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UNetFrequencySubsystem();
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+public:
+	//Server, Character and Weapon Register When BeginPlay, Unregister When EndPlay
+	void RegisterActor(AActor* Actor);
+
+	void UnregisterActor(AActor* Actor);
+
+	//Return Actor's Activity, Idle if not Registered
+	ENetActivity GetActivity(const AActor* Actor) const;
+
+	//Log Actor Count per Activity and Sum of Net Update Frequency
+	void Report() const;
+
+protected:
+	struct FNetFrequencyActor
+	{
+		TWeakObjectPtr<AActor> Actor;
+
+		//Index in ClassRules
+		int32 RuleIndex = INDEX_NONE;
+
+		ENetActivity Activity = ENetActivity::Idle;
+
+		//World Time of Last Combat, Combat Hold after this
+		double LastCombatTime = -UE_BIG_NUMBER;
+	};
+
+	//Evaluate Activity of every Actor and Apply Frequency
+	void UpdateActivities();
+
+	ENetActivity EvaluateCharacter(FNetFrequencyActor& Entry, double CurrentTime) const;
+
+	ENetActivity EvaluateWeapon(const FNetFrequencyActor& Entry, const TMap<const AActor*, ENetActivity>& CharacterActivities) const;
+
+	void ApplyFrequency(FNetFrequencyActor& Entry, ENetActivity NewActivity);
+
+	//Most Derived Rule of Class, INDEX_NONE if No Rule
+	int32 FindRuleIndex(const UClass* ActorClass) const;
+
+	int32 FindIndex(const AActor* Actor) const;
+
+protected:
+	TArray<FNetFrequencyActor> Actors;
+
+	//Resolved ActorClass of ClassRules, Same Index
+	UPROPERTY()
+	TArray<UClass*> RuleClasses;
+
+	//Time after Last Update
+	float UpdateElapsedTime;
+
+	//Frequency Change Count, Reported
+	int64 FrequencyChangeCount;
+
+	//----------[ Config ]----------
+	//Activity Update Interval, Second
+	UPROPERTY(Config)
+	float UpdateInterval;
+
+	//Stay Combat this Long after Last Attack, No Frequency Flapping between Combo Hits
+	UPROPERTY(Config)
+	float CombatHoldTime;
+
+	//Other Combatant within this Distance is Engaged
+	UPROPERTY(Config)
+	float EngageRadius;
+
+	UPROPERTY(Config)
+	TArray<FNetFrequencyRule> ClassRules;
+};
@@ -0,0 +1,175 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/NetSerialization.h"
+#include "WorldCollision.h"
+#include "ProjectileSubsystem.generated.h"
+
+class ABaseWeapon;
+class UStaticMesh;
+class UInstancedStaticMeshComponent;
+
+/**
+ * Server Send only Launch Params, Client Simulate Same Path
+ */
+USTRUCT()
+struct WEAPON_API FProjectileLaunchParams
+{
+	GENERATED_BODY()
+
+	//Server Assigned, Same Id on every Machine
+	UPROPERTY()
+	uint32 ProjectileId = 0;
+
+	UPROPERTY()
+	FVector_NetQuantize Origin;
+
+	UPROPERTY()
+	FVector_NetQuantize10 Velocity;
+
+public:
+	//Round like NetSerialize, Server Simulate Same Value as Client Receive
+	void Quantize();
+};
+
+//One Instanced Static Mesh per Projectile Mesh, Instance is Reused
+USTRUCT()
+struct FProjectileVisualPool
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	UStaticMesh* Mesh = nullptr;
+
+	UPROPERTY()
+	UInstancedStaticMeshComponent* Component = nullptr;
+
+	//Hidden Instance Index, Ready to Reuse
+	TArray<int32> FreeInstances;
+};
+
+/**
+ * Every Active Projectile, Structure of Arrays
+ * Ballistic Step with Gravity and Drag in CombatWorldSubsystem Fixed Step, Same Path on Server and Client
+ * Moved Segment is Swept Async Once per Frame, Result is Resolved Next Frame
+ * Server Apply Damage, Client Projectile is Cosmetic Only
+ */
+UCLASS(config = Game)
+class WEAPON_API UProjectileSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UProjectileSubsystem();
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Deinitialize() override;
+
+public:
+	//Server Only
+	uint32 GenerateProjectileId() { return ++NextProjectileId; };
+
+	//Add Projectile, Damage is used by Server Only
+	//CatchUpTime Simulate Projectile Forward, Client use Half Ping
+	void LaunchProjectile(ABaseWeapon* Weapon, const FProjectileLaunchParams& Params, float Damage, float CatchUpTime = 0.0f);
+
+	//CombatWorldSubsystem Call this every Fixed Step
+	void FixedStep(float StepDeltaTime);
+
+	//CombatWorldSubsystem Call this after Fixed Steps, Sweep Moved Segment and Update Visual
+	void EndFrame(float InterpolationAlpha);
+
+	int32 GetProjectileCount() const { return ProjectileIds.Num(); };
+
+	//Semi Implicit Euler, Same Function for Step and Catch Up
+	static void IntegrateProjectile(FVector& Position, FVector& Velocity, float GravityZ, float Drag, float DeltaTime);
+
+protected:
+	void RemoveProjectile(int32 Index);
+
+	void OnSweepCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
+
+	//Server, Damage and Impact
+	void ResolveHit(int32 Index, const FHitResult& HitResult);
+
+	//Return false When No Visual (Dedicated Server)
+	bool AcquireVisual(UStaticMesh* Mesh, int32& OutPoolIndex, int32& OutInstanceIndex);
+
+	void ReleaseVisual(int32 PoolIndex, int32 InstanceIndex);
+
+	void UpdateVisuals(float InterpolationAlpha);
+
+protected:
+	//Oldest Projectile Removed as Miss When Full
+	UPROPERTY(Config)
+	int32 MaxProjectiles;
+
+	//Projectile Removed as Miss after this
+	UPROPERTY(Config)
+	float MaxLifetime;
+
+	//Step in Worker Threads When Projectile Count is over this
+	UPROPERTY(Config)
+	int32 ParallelThreshold;
+
+	//Client don't Catch Up more than this
+	UPROPERTY(Config)
+	float MaxCatchUpTime;
+
+	uint32 NextProjectileId;
+
+	FTraceDelegate SweepDelegate;
+
+
+	//----------[ Structure of Arrays ]----------
+	TArray<uint32> ProjectileIds;
+
+	UPROPERTY()
+	TArray<ABaseWeapon*> Weapons;
+
+	//Weapon's Owner Character at Launch, Ignored by Sweep
+	UPROPERTY()
+	TArray<AActor*> Instigators;
+
+	TArray<FVector> Positions;
+
+	//Position at Last Step, Visual Interpolate from this
+	TArray<FVector> PreviousPositions;
+
+	//Position at Last Sweep
+	TArray<FVector> SweepStartPositions;
+
+	TArray<FVector> Velocities;
+
+	TArray<float> GravityZs;
+
+	TArray<float> Drags;
+
+	TArray<float> Radii;
+
+	TArray<float> RemainingLifetimes;
+
+	TArray<float> Damages;
+
+	TArray<int32> VisualPoolIndices;
+
+	TArray<int32> VisualInstanceIndices;
+
+	//Projectile Id to Array Index, Async Sweep Result use Id
+	TMap<uint32, int32> IdToIndex;
+
+
+	//----------[ Visual ]----------
+	//Transient Actor has every Instanced Static Mesh Component
+	UPROPERTY()
+	AActor* VisualHostActor;
+
+	UPROPERTY()
+	TArray<FProjectileVisualPool> VisualPools;
+};
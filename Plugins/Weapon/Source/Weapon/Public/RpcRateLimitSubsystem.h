@@ -0,0 +1,110 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RpcRateLimitSubsystem.generated.h"
+
+class UNetConnection;
+
+//Token Bucket Setting for One Server RPC
+USTRUCT()
+struct FRpcRateLimitRule
+{
+	GENERATED_BODY()
+
+	UPROPERTY(Config)
+	FName RpcName;
+
+	//Refill Speed
+	UPROPERTY(Config)
+	float TokensPerSecond = 30.0f;
+
+	//Max Tokens, Calls Allowed at Once
+	UPROPERTY(Config)
+	float BurstSize = 30.0f;
+};
+
+/**
+ * Server Side Token Bucket for every Connection and Server RPC
+ * RPC Implementation Consume Token First, Drop Call When Bucket is Empty
+ * Count Rejected Call by Rate Limit and Validation
+ */
+UCLASS(config = Game)
+class WEAPON_API URpcRateLimitSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	URpcRateLimitSubsystem();
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	virtual void Deinitialize() override;
+
+public:
+	//Return false When Caller's Connection used all Tokens of this RPC
+	//Local Call (Listen Server Host) is always true
+	//Retry of Held Back Work don't Count as Rejection, Pass bRecordRejection false
+	bool ConsumeToken(const AActor* Caller, FName RpcName, bool bRecordRejection = true);
+
+	//Count Call Rejected by Validate Function
+	void RecordInvalidCall(const AActor* Caller, FName RpcName);
+
+	//Print Rejected Count per RPC and Connection
+	void DumpRejections() const;
+
+protected:
+	struct FRpcTokenBucket
+	{
+		float Tokens = 0.0f;
+
+		double LastRefillTime = 0.0;
+	};
+
+	struct FRpcRejectionCount
+	{
+		int32 RateLimited = 0;
+
+		int32 Invalid = 0;
+	};
+
+	struct FConnectionRpcState
+	{
+		TWeakObjectPtr<UNetConnection> Connection;
+
+		TMap<FName, FRpcTokenBucket> Buckets;
+
+		FRpcRejectionCount Rejections;
+	};
+
+	//Return Rule for RPC, DefaultRule if not in Config
+	const FRpcRateLimitRule& FindRule(FName RpcName) const;
+
+	//Return State of Caller's Connection, nullptr if Local Call
+	FConnectionRpcState* FindOrAddConnectionState(const AActor* Caller);
+
+	//Remove Closed Connection
+	void PruneConnections();
+
+protected:
+	//Rule per RPC
+	UPROPERTY(Config)
+	TArray<FRpcRateLimitRule> RateLimitRules;
+
+	//Rule for RPC not in RateLimitRules
+	UPROPERTY(Config)
+	FRpcRateLimitRule DefaultRule;
+
+	//Closed Connection Remove Interval
+	UPROPERTY(Config)
+	float PruneInterval;
+
+	double LastPruneTime;
+
+	TArray<FConnectionRpcState> Connections;
+
+	//Rejected Count per RPC, All Connection
+	TMap<FName, FRpcRejectionCount> RpcRejections;
+};
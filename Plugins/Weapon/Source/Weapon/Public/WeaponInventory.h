@@ -0,0 +1,83 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Net/Serialization/FastArraySerializer.h"
+#include "WeaponInventory.generated.h"
+
+class ABaseWeapon;
+class AFHProjectCharacter;
+struct FWeaponInventoryArray;
+
+/**
+ * One Occupied Hotbar Slot
+ */
+USTRUCT()
+struct WEAPON_API FWeaponInventorySlot : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	//Hotbar Slot Index, 0 ~ MaxSlotCount - 1
+	UPROPERTY()
+	int32 SlotIndex = INDEX_NONE;
+
+	UPROPERTY()
+	ABaseWeapon* Weapon = nullptr;
+
+public:
+	//Client, Called When Slot Replicated
+	void PreReplicatedRemove(const FWeaponInventoryArray& InArraySerializer);
+
+	void PostReplicatedAdd(const FWeaponInventoryArray& InArraySerializer);
+
+	void PostReplicatedChange(const FWeaponInventoryArray& InArraySerializer);
+};
+
+/**
+ * Six Slot Hotbar, Delta Serialized
+ * Only Occupied Slots are in Array
+ */
+USTRUCT()
+struct WEAPON_API FWeaponInventoryArray : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	static constexpr int32 MaxSlotCount = 6;
+
+	UPROPERTY()
+	TArray<FWeaponInventorySlot> Slots;
+
+	//Character has this Inventory, Refresh Equip Weapon When Replicated
+	UPROPERTY(NotReplicated)
+	AFHProjectCharacter* OwnerCharacter = nullptr;
+
+public:
+	//Return Weapon in Slot, nullptr if Empty
+	ABaseWeapon* GetWeapon(int32 SlotIndex) const;
+
+	//Return Slot Index of Weapon, INDEX_NONE if not in Inventory
+	int32 FindSlotIndex(const ABaseWeapon* Weapon) const;
+
+	//Return First Empty Slot Index, INDEX_NONE if Full
+	int32 FindFreeSlot() const;
+
+	//Server Only
+	void AddWeapon(int32 SlotIndex, ABaseWeapon* Weapon);
+
+	void RemoveWeapon(int32 SlotIndex);
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FWeaponInventorySlot, FWeaponInventoryArray>(Slots, DeltaParms, *this);
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FWeaponInventoryArray> : public TStructOpsTypeTraitsBase2<FWeaponInventoryArray>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
@@ -0,0 +1,94 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WeaponProxySubsystem.generated.h"
+
+class ABaseWeapon;
+class UStaticMesh;
+class UInstancedStaticMeshComponent;
+
+//One Instanced Static Mesh per Weapon Mesh
+USTRUCT()
+struct FWeaponProxyBatch
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	UStaticMesh* Mesh = nullptr;
+
+	UPROPERTY()
+	UInstancedStaticMeshComponent* Component = nullptr;
+
+	//Same Index as Component Instance
+	UPROPERTY()
+	TArray<ABaseWeapon*> Weapons;
+};
+
+/**
+ * Resting Dropped Weapon and Level Placed Weapon (Rack) is Drawn as Instance
+ * Weapon Actor is Kept for Replicated Identity, Hidden, Dormant, No Physics and No Collision
+ * Weapon become Actor again When Picked up or Hit
+ * Server and Client Build Own Proxy, Weapon's bIsProxied is Replicated
+ */
+UCLASS(config = Game)
+class WEAPON_API UWeaponProxySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UWeaponProxySubsystem();
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	virtual void Deinitialize() override;
+
+public:
+	//Add Instance at Weapon Transform
+	void AddProxy(ABaseWeapon* Weapon);
+
+	//Remove Weapon's Instance
+	void RemoveProxy(ABaseWeapon* Weapon);
+
+	//Server, Return Nearest Proxied Weapon in Radius, nullptr if None
+	ABaseWeapon* FindNearestProxy(const FVector& Location, float Radius) const;
+
+	//Return Weapon of Hit Instance, nullptr if not Proxy
+	ABaseWeapon* FindHitProxy(const UPrimitiveComponent* HitComponent, int32 InstanceIndex) const;
+
+	//Server, Return Weapon of Hit Instance and Make it Actor, nullptr if not Proxy
+	ABaseWeapon* PromoteHitInstance(const UPrimitiveComponent* HitComponent, int32 InstanceIndex);
+
+	float GetPickupRadius() const { return PickupRadius; };
+
+	float GetHitImpulse() const { return HitImpulse; };
+
+	int32 GetProxyCount() const;
+
+protected:
+	FWeaponProxyBatch& FindOrAddBatch(ABaseWeapon* Weapon);
+
+	const FWeaponProxyBatch* FindBatch(const UPrimitiveComponent* Component) const;
+
+	//Server, Character Overlap Proxy, Promote Nearest Weapon for Pick Up
+	UFUNCTION()
+	void ProxyBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
+
+protected:
+	//Character Pick Up Radius for Proxy
+	UPROPERTY(Config)
+	float PickupRadius;
+
+	//Velocity Change When Proxy Weapon is Hit
+	UPROPERTY(Config)
+	float HitImpulse;
+
+	//Transient Actor has every Instanced Static Mesh Component
+	UPROPERTY()
+	AActor* ProxyHostActor;
+
+	UPROPERTY()
+	TArray<FWeaponProxyBatch> Batches;
+};
@@ -0,0 +1,130 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Async/Future.h"
+#include "Engine/TimerHandle.h"
+#include "WeaponSnapshotSubsystem.generated.h"
+
+class ABaseWeapon;
+class AFHProjectCharacter;
+
+//Weapon Record of Snapshot
+struct FWeaponSnapshotRecord
+{
+	//Index in Class Table
+	uint16 ClassIndex = 0;
+
+	uint8 bIsProxied = 0;
+
+	//Hotbar Slot, Only Valid When Loadout Index is Valid
+	uint8 SlotIndex = 0;
+
+	//Index in Loadout Table, INDEX_NONE if Dropped in World
+	int16 LoadoutIndex = INDEX_NONE;
+
+	int32 LeftClickCount = 0;
+
+	FVector3f Location = FVector3f::ZeroVector;
+
+	FQuat4f Rotation = FQuat4f::Identity;
+
+	friend FArchive& operator<<(FArchive& Ar, FWeaponSnapshotRecord& Record);
+};
+
+//Character Loadout of Snapshot, Weapons Point to Loadout by Index
+struct FWeaponSnapshotLoadout
+{
+	//Player Unique Id, or Actor Name of Placed Character
+	FString Key;
+
+	int8 ActiveSlotIndex = 0;
+
+	friend FArchive& operator<<(FArchive& Ar, FWeaponSnapshotLoadout& Loadout);
+};
+
+//Restored Loadout Waiting for Character, Player Reconnect after Restart
+struct FPendingWeaponLoadout
+{
+	int32 ActiveSlotIndex = 0;
+
+	TArray<TPair<int32, TWeakObjectPtr<ABaseWeapon>>> SlotWeapons;
+
+	TArray<TPair<TWeakObjectPtr<ABaseWeapon>, int32>> LeftClickCounts;
+};
+
+/**
+ * Server Save every Weapon and Character Loadout to Versioned Binary Snapshot
+ * Survive Server Restart and Match Migration, Dropped Weapon, Held Weapon and LeftClickCount
+ * Gather on Game Thread (Small Fixed Records), File Write on Background Task
+ * Restore Map the File, Resolve Class Table Once, Reuse Unowned World Weapon as Pool, Spawn Rest Deferred
+ * Loadout of Player not Joined yet is Applied When Character is Possessed
+ * Restore is Opt In, bRestoreOnBeginPlay or -WeaponSnapshotRestore, File is per Session (-WeaponSnapshotId or Listen Port)
+ *
+ * Console : Weapon.Snapshot.Save, Weapon.Snapshot.Load
+ */
+UCLASS(config = Game)
+class WEAPON_API UWeaponSnapshotSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UWeaponSnapshotSubsystem();
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	virtual void Deinitialize() override;
+
+public:
+	//Server, Gather Now and Write on Background Task, false if Previous Write is Running
+	bool SaveSnapshot();
+
+	//Server, Read Snapshot File and Restore Weapons, false if No File or Invalid
+	bool LoadSnapshot();
+
+	//Server, Character Possessed, Apply Restored Loadout if Waiting
+	void ApplyPendingLoadout(AFHProjectCharacter* Character);
+
+	FString GetSnapshotPath() const;
+
+protected:
+	//Restore from Snapshot Bytes, Mapped File or Loaded Array
+	bool RestoreSnapshot(FArchive& Ar);
+
+	//Give Weapons to Character, Select Active Slot and Restore Combo
+	void ApplyLoadout(AFHProjectCharacter* Character, const FPendingWeaponLoadout& Loadout);
+
+	//Loadout Key of Character, Empty if Not Keyable
+	static FString GetLoadoutKey(const AFHProjectCharacter* Character);
+
+	void AutoSave();
+
+protected:
+	//Save Periodically in Match, Seconds, 0 is Off
+	UPROPERTY(Config)
+	float AutoSaveInterval;
+
+	//Load Snapshot When Server World Begin Play, -WeaponSnapshotRestore do Same for One Run
+	UPROPERTY(Config)
+	bool bRestoreOnBeginPlay;
+
+	//Unowned Weapon not in Snapshot is Destroyed on Restore
+	UPROPERTY(Config)
+	bool bDestroyUnlistedWeapons;
+
+	//File Name in Saved/Snapshots, Session Id is Appended to Base Name
+	UPROPERTY(Config)
+	FString SnapshotFileName;
+
+	//Loadout Waiting for Character, Key is Loadout Key
+	TMap<FString, FPendingWeaponLoadout> PendingLoadouts;
+
+	//Background File Write, Waited on Deinitialize
+	TFuture<bool> SaveTask;
+
+	FTimerHandle AutoSaveTimerHandle;
+};
@@ -28,6 +28,7 @@ public class Weapon : ModuleRules
 				"Core",
                 "InputCore",
                 "EnhancedInput",
+                "AIModule",
 				// ... add other public dependencies that you statically link with here ...
 			}
             );
@@ -38,6 +39,7 @@ public class Weapon : ModuleRules
 			{
 				"CoreUObject",
 				"Engine",
+				"NetCore",
 				"Slate",
 				"SlateCore",
                 "UMG",
@@ -45,6 +47,11 @@ public class Weapon : ModuleRules
 			}
 			);
 		
+		//Network Automation Tests Start PIE Session with Server and Clients
+		if (Target.bBuildEditor == true)
+		{
+			PrivateDependencyModuleNames.Add("UnrealEd");
+		}
 		
 		DynamicallyLoadedModuleNames.AddRange(
 			new string[]